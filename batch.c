@@ -0,0 +1,170 @@
+/** Projekt IFJ2023
+ * @file batch.c
+ * @brief Dávkový preklad viacerých programov vo vláknach jedného procesu
+ * @author agent (agent@local)
+ * @date 19.10.2026
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "batch.h"
+#include "compiler.h"
+#include "parser.h"
+
+/**
+ * @brief Preklad jedného programu zo zoznamu
+*/
+typedef struct batch_job {
+    char *input;        ///< cesta k zdrojovému programu
+    char *output;       ///< cesta k výstupnému súboru
+    int result;         ///< návratový kód prekladu
+    FILE *diagnostics;  ///< zachytené hlásenia chýb prekladu
+} batch_job_T;
+
+/**
+ * @brief Zoznam prekladov spoločný pre všetky vlákna
+*/
+typedef struct batch {
+    batch_job_T *jobs;      ///< preklady v poradí zoznamu
+    int count;              ///< počet prekladov
+    int next;               ///< index prvého ešte nezačatého prekladu
+    pthread_mutex_t lock;   ///< chráni next
+    options_T options;      ///< nastavenia prekladu
+} batch_T;
+
+/**
+ * @brief Načíta zoznam dvojíc vstup/výstup
+ * @return true v prípade úspechu, inak false
+*/
+static bool batchLoad(char *list, batch_T *batch) {
+    FILE *f = strcmp(list, "-") == 0 ? stdin : fopen(list, "r");
+    if (f == NULL) return false;
+
+    int capacity = 0;
+    char line[2 * 4096];
+    while (fgets(line, sizeof(line), f) != NULL) {
+        char *input = strtok(line, " \t\r\n");
+        char *output = strtok(NULL, " \t\r\n");
+        if (input == NULL) continue; // prázdny riadok
+        if (output == NULL) {
+            fprintf(stderr, "batch: missing output file for %s\n", input);
+            if (f != stdin) fclose(f);
+            return false;
+        }
+        if (batch->count == capacity) {
+            capacity = capacity == 0 ? 64 : 2 * capacity;
+            batch->jobs = realloc(batch->jobs, capacity * sizeof(batch_job_T));
+            if (batch->jobs == NULL) exit(COMPILER_ERROR);
+        }
+        batch_job_T *job = &(batch->jobs[batch->count++]);
+        job->input = strdup(input);
+        job->output = strdup(output);
+        if (job->input == NULL || job->output == NULL) exit(COMPILER_ERROR);
+        job->result = COMPILER_ERROR;
+        job->diagnostics = NULL;
+    }
+
+    if (f != stdin) fclose(f);
+    return true;
+}
+
+/**
+ * @brief Preloží jeden program, výsledok a hlásenia chýb uloží do job
+*/
+static void batchRun(ctx_T *ctx, batch_job_T *job, options_T *options) {
+    job->diagnostics = tmpfile();
+    FILE *input = fopen(job->input, "r");
+    if (input == NULL) {
+        if (job->diagnostics != NULL) fprintf(job->diagnostics, "cannot open input file\n");
+        return;
+    }
+    int output = open(job->output, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (output < 0) {
+        if (job->diagnostics != NULL) fprintf(job->diagnostics, "cannot open output file %s\n", job->output);
+        fclose(input);
+        return;
+    }
+
+    compiler_T c = { input, output, job->diagnostics, *options, false };
+    job->result = compileWith(ctx, &c);
+
+    close(output);
+    fclose(input);
+}
+
+/**
+ * @brief Vlákno, ktoré postupne preberá preklady zo zoznamu
+*/
+static void *batchWorker(void *arg) {
+    batch_T *batch = arg;
+    ctx_T *ctx = calloc(1, sizeof(ctx_T)); // kontext prekladu vlákna, použije sa pre všetky jeho preklady
+    if (ctx == NULL) exit(COMPILER_ERROR);
+    while (true) {
+        pthread_mutex_lock(&(batch->lock));
+        int i = batch->next < batch->count ? batch->next++ : -1;
+        pthread_mutex_unlock(&(batch->lock));
+        if (i == -1) break;
+        batchRun(ctx, &(batch->jobs[i]), &(batch->options));
+    }
+    free(ctx);
+    return NULL;
+}
+
+/**
+ * @brief Vypíše zachytené hlásenia chýb prekladu s predponou vstupného súboru
+*/
+static void batchReport(batch_job_T *job) {
+    printf("%s %d\n", job->input, job->result);
+    if (job->diagnostics == NULL) return;
+
+    char line[4096];
+    bool line_start = true;
+    rewind(job->diagnostics);
+    while (fgets(line, sizeof(line), job->diagnostics) != NULL) {
+        if (line_start) fprintf(stderr, "%s: ", job->input);
+        fputs(line, stderr);
+        line_start = strchr(line, '\n') != NULL;
+    }
+    if (!line_start) fputc('\n', stderr);
+    fclose(job->diagnostics);
+}
+
+int batchCompile(char *list, int jobs, const options_T *options) {
+    batch_T batch = { NULL, 0, 0, PTHREAD_MUTEX_INITIALIZER, *options };
+    if (!batchLoad(list, &batch)) {
+        fprintf(stderr, "batch: cannot read list %s\n", list);
+        return COMPILER_ERROR;
+    }
+
+    if (jobs <= 0) jobs = (int)sysconf(_SC_NPROCESSORS_ONLN);
+    if (jobs <= 0) jobs = 1;
+    if (jobs > BATCH_MAX_JOBS) jobs = BATCH_MAX_JOBS;
+    if (jobs > batch.count) jobs = batch.count;
+
+    pthread_t threads[BATCH_MAX_JOBS];
+    int started = 0;
+    for (; started < jobs; started++) {
+        if (pthread_create(&threads[started], NULL, batchWorker, &batch) != 0) break;
+    }
+    if (started == 0) batchWorker(&batch); // vlákna sa nepodarilo vytvoriť
+    for (int i = 0; i < started; i++) pthread_join(threads[i], NULL);
+
+    int result = 0;
+    for (int i = 0; i < batch.count; i++) {
+        batchReport(&(batch.jobs[i]));
+        if (result == 0 && batch.jobs[i].result != COMPILATION_OK) result = batch.jobs[i].result;
+        free(batch.jobs[i].input);
+        free(batch.jobs[i].output);
+    }
+    free(batch.jobs);
+    pthread_mutex_destroy(&(batch.lock));
+    return result;
+}
+
+/* Koniec súboru batch.c */
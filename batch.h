@@ -0,0 +1,32 @@
+/** Projekt IFJ2023
+ * @file batch.h
+ * @brief Dávkový preklad viacerých programov vo vláknach jedného procesu
+ * @author agent (agent@local)
+ * @date 19.10.2026
+ */
+
+#ifndef _BATCH_H_
+#define _BATCH_H_
+
+#include "options.h"
+
+/** Maximálny počet vlákien dávkového prekladu */
+#define BATCH_MAX_JOBS 256
+
+/**
+ * Zoznam obsahuje na každom riadku dvojicu "<vstup> <výstup>" oddelenú bielymi znakmi,
+ * prázdne riadky sa preskakujú. Programy sa prekladajú v jobs vláknach s nastaveniami
+ * z options. Po dokončení všetkých prekladov sa v poradí zoznamu vypíše na stdout
+ * "<vstup> <návratový kód>" a na stderr hlásenia chýb prekladu, každý riadok s predponou
+ * "<vstup>: ".
+ *
+ * @brief Preloží programy zo zoznamu
+ * @param list súbor so zoznamom, "-" značí stdin
+ * @param jobs počet vlákien, 0 znamená počet procesorov
+ * @param options nastavenia všetkých prekladov
+ * @return 0 ak všetky preklady uspeli, inak návratový kód prvého neúspešného prekladu
+*/
+int batchCompile(char *list, int jobs, const options_T *options);
+
+#endif // ifndef _BATCH_H_
+/* Koniec súboru batch.h */
@@ -0,0 +1,403 @@
+/** Projekt IFJ2023
+ * @file cache.c
+ * @brief Prekladová cache adresovaná obsahom zdrojového programu
+ * @author agent (agent@local)
+ * @date 19.10.2026
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/file.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "cache.h"
+#include "memory.h"
+#include "parser.h"
+#include "report.h"
+#include "writer.h"
+
+/** Verzia prekladača, súčasť kľúča, po každom zostavení prekladača sú staré záznamy neplatné */
+#define CACHE_VERSION "IFJ23 " __DATE__ " " __TIME__
+
+/** Začiatok hlavičky záznamu */
+#define CACHE_MAGIC "IFJ23CACHE"
+
+/** Súbor s celkovým počtom zásahov a minutí v adresári cache */
+#define CACHE_STATS_FILE "stats"
+
+/** Veľkosť bufferu pri kopírovaní */
+#define CACHE_BUFFER_SIZE 4096
+
+/** Počet zásahov a minutí v tomto procese, spoločný pre všetky vlákna */
+static atomic_long cache_hits = 0, cache_misses = 0;
+
+/** Počet funkcií prevzatých z cache a preložených pri inkrementálnom preklade v tomto procese */
+static atomic_long cache_fn_hits = 0, cache_fn_misses = 0;
+
+/** Chráni úpravu súboru so štatistikou pred súčasnou úpravou z iného vlákna tohto procesu */
+static pthread_mutex_t cache_stats_lock = PTHREAD_MUTEX_INITIALIZER;
+
+void cacheHashAdd(cache_hash_T *h, const char *data, size_t size) {
+    for (size_t i = 0; i < size; i++) {
+        unsigned char c = data[i];
+        h->a = (h->a ^ c) * 0x100000001b3ULL;
+        h->b = (h->b ^ c) * 0x9e3779b97f4a7c15ULL;
+        h->b ^= h->b >> 29;
+    }
+}
+
+void cacheHashInit(cache_hash_T *h, options_T *opt) {
+    char settings[256];
+    int len = snprintf(settings, sizeof(settings), "%d %d %d %d %d %d %d %d %d %d %d %d",
+        opt->inline_fns, opt->inline_limit, opt->tail_calls, opt->substr_consts, opt->substr_doubling_min,
+        opt->licm, opt->dead_fns, opt->share_vars, opt->call_cleanup, opt->merge_writes, opt->short_names, opt->dump_cfg);
+
+    h->a = 0xcbf29ce484222325ULL;
+    h->b = 0x84222325cbf29ce4ULL;
+    cacheHashAdd(h, CACHE_VERSION, sizeof(CACHE_VERSION)); // vrátane '\0' ako oddeľovača
+    cacheHashAdd(h, settings, len + 1);
+}
+
+void cacheHashKey(cache_hash_T *h, char *key) {
+    sprintf(key, "%016llx%016llx", (unsigned long long)h->a, (unsigned long long)h->b);
+}
+
+/**
+ * @brief Vypočíta kľúč záznamu celého programu
+ * @param key výsledok, CACHE_KEY_LEN + 1 znakov
+*/
+static void cacheKey(options_T *opt, const char *source, size_t size, char *key) {
+    cache_hash_T h;
+    cacheHashInit(&h, opt);
+    cacheHashAdd(&h, source, size);
+    cacheHashKey(&h, key);
+}
+
+/**
+ * @brief Načíta celý zdrojový program do pamäte
+ * @return načítaný program (treba uvoľniť) alebo NULL pri chybe
+*/
+static char *cacheReadAll(FILE *in, size_t *size) {
+    size_t capacity = CACHE_BUFFER_SIZE;
+    char *data = memAlloc(MEM_CACHE, capacity);
+    if (data == NULL) return NULL;
+    *size = 0;
+    size_t n;
+    while ((n = fread(data + *size, 1, capacity - *size, in)) > 0) {
+        *size += n;
+        if (*size == capacity) {
+            capacity *= 2;
+            char *bigger = memRealloc(MEM_CACHE, data, capacity);
+            if (bigger == NULL) {
+                memFree(MEM_CACHE, data);
+                return NULL;
+            }
+            data = bigger;
+        }
+    }
+    return data;
+}
+
+/**
+ * @brief Prekopíruje size bajtov zo súboru from do deskriptora fd, ak je fd záporný, tak do súboru to
+ * @return true v prípade úspechu, inak false
+*/
+static bool cacheCopy(FILE *from, long size, int fd, FILE *to) {
+    char buffer[CACHE_BUFFER_SIZE];
+    while (size > 0) {
+        size_t n = fread(buffer, 1, size < (long)sizeof(buffer) ? (size_t)size : sizeof(buffer), from);
+        if (n == 0) return false;
+        if (fd >= 0 ? !writerWriteAll(fd, buffer, n) : fwrite(buffer, 1, n, to) != n) return false;
+        size -= n;
+    }
+    return true;
+}
+
+/**
+ * Záznam tvorí hlavička "IFJ23CACHE <návratový kód> <dĺžka programu> <dĺžka kódu> <dĺžka hlásení>\n",
+ * vygenerovaný kód a hlásenia chýb.
+ * @brief Zopakuje výsledok prekladu uložený v zázname
+ * @return true pri zásahu, false ak záznam neexistuje alebo je poškodený
+*/
+static bool cacheReplay(char *path, size_t source_size, compiler_T *c, int *result) {
+    FILE *entry = fopen(path, "r");
+    if (entry == NULL) return false;
+
+    char header[128];
+    unsigned long long size;
+    long code_size, diagnostics_size;
+    long entry_size = writerFileSize(entry);
+    bool valid = fgets(header, sizeof(header), entry) != NULL &&
+        sscanf(header, CACHE_MAGIC " %d %llu %ld %ld", result, &size, &code_size, &diagnostics_size) == 4 &&
+        size == source_size && code_size >= 0 && diagnostics_size >= 0 &&
+        entry_size == (long)strlen(header) + code_size + diagnostics_size;
+    if (!valid) {
+        fclose(entry);
+        return false;
+    }
+
+    futimens(fileno(entry), NULL); // čas poslednej zmeny slúži ako čas posledného použitia
+    cacheCopy(entry, code_size, c->output_fd, NULL);
+    cacheCopy(entry, diagnostics_size, -1, c->diagnostics != NULL ? c->diagnostics : stderr);
+    fclose(entry);
+    return true;
+}
+
+/**
+ * @brief Vytvorí dočasný súbor pre nový záznam v adresári cache
+ * @param tmp_path cesta k dočasnému súboru (treba uvoľniť)
+ * @return deskriptor otvoreného súboru, záporný pri chybe
+*/
+static int cacheTempFile(char *dir, char **tmp_path) {
+    size_t path_len = strlen(dir) + 16;
+    *tmp_path = memAlloc(MEM_CACHE, path_len);
+    if (*tmp_path == NULL) exit(COMPILER_ERROR);
+    snprintf(*tmp_path, path_len, "%s/.tmpXXXXXX", dir);
+    return mkstemp(*tmp_path);
+}
+
+/**
+ * Záznam sa zapisuje do dočasného súboru a až potom premenuje, súbežné preklady preto nevidia neúplný záznam.
+ * @brief Zatvorí dočasný súbor a úplný záznam presunie pod jeho kľúč, inak dočasný súbor odstráni
+*/
+static void cacheCommit(char *dir, char *key, int fd, char *tmp_path, bool ok) {
+    ok = close(fd) == 0 && ok;
+    size_t path_len = strlen(dir) + CACHE_KEY_LEN + 2;
+    char *path = memAlloc(MEM_CACHE, path_len);
+    if (path == NULL) exit(COMPILER_ERROR);
+    snprintf(path, path_len, "%s/%s", dir, key);
+    if (!ok || rename(tmp_path, path) != 0) unlink(tmp_path);
+    memFree(MEM_CACHE, path);
+}
+
+/**
+ * @brief Uloží výsledok prekladu do cache
+*/
+static void cacheStore(char *dir, char *key, size_t source_size, int result, FILE *code, FILE *diagnostics) {
+    long code_size = writerFileSize(code), diagnostics_size = writerFileSize(diagnostics);
+    if (code_size < 0 || diagnostics_size < 0) return;
+
+    char *tmp_path;
+    int fd = cacheTempFile(dir, &tmp_path);
+    if (fd >= 0) {
+        char header[128];
+        int len = snprintf(header, sizeof(header), CACHE_MAGIC " %d %llu %ld %ld\n", result,
+            (unsigned long long)source_size, code_size, diagnostics_size);
+        bool ok = writerWriteAll(fd, header, len) && cacheCopy(code, code_size, fd, NULL) &&
+            cacheCopy(diagnostics, diagnostics_size, fd, NULL);
+        cacheCommit(dir, key, fd, tmp_path, ok);
+    }
+    rewind(code);
+    rewind(diagnostics);
+    memFree(MEM_CACHE, tmp_path);
+}
+
+/**
+ * @brief Záznam v adresári cache
+*/
+typedef struct cache_entry {
+    char name[CACHE_KEY_LEN + 1];   ///< názov súboru (kľúč)
+    struct timespec used;           ///< čas posledného použitia
+    long size;                      ///< veľkosť záznamu
+} cache_entry_T;
+
+/**
+ * @brief Porovnanie záznamov podľa času posledného použitia pre qsort
+*/
+static int cacheEntryCmp(const void *a, const void *b) {
+    const struct timespec *x = &((cache_entry_T *)a)->used, *y = &((cache_entry_T *)b)->used;
+    if (x->tv_sec != y->tv_sec) return x->tv_sec < y->tv_sec ? -1 : 1;
+    if (x->tv_nsec != y->tv_nsec) return x->tv_nsec < y->tv_nsec ? -1 : 1;
+    return 0;
+}
+
+/**
+ * @brief Odstráni najdlhšie nepoužité záznamy, kým celková veľkosť cache presahuje limit
+ * @param limit maximálna veľkosť v bajtoch
+*/
+static void cacheEvict(char *dir, long long limit) {
+    DIR *d = opendir(dir);
+    if (d == NULL) return;
+
+    cache_entry_T *entries = NULL;
+    int count = 0, capacity = 0;
+    long long total = 0;
+    size_t path_len = strlen(dir) + CACHE_KEY_LEN + 2;
+    char *path = memAlloc(MEM_CACHE, path_len);
+    if (path == NULL) exit(COMPILER_ERROR);
+
+    struct dirent *de;
+    while ((de = readdir(d)) != NULL) {
+        if (strlen(de->d_name) != CACHE_KEY_LEN || strspn(de->d_name, "0123456789abcdef") != CACHE_KEY_LEN) continue;
+        snprintf(path, path_len, "%s/%s", dir, de->d_name);
+        struct stat st;
+        if (stat(path, &st) != 0) continue;
+        if (count == capacity) {
+            capacity = capacity == 0 ? 64 : 2 * capacity;
+            entries = memRealloc(MEM_CACHE, entries, capacity * sizeof(cache_entry_T));
+            if (entries == NULL) exit(COMPILER_ERROR);
+        }
+        strcpy(entries[count].name, de->d_name);
+        entries[count].used = st.st_mtim;
+        entries[count].size = st.st_size;
+        total += st.st_size;
+        count++;
+    }
+    closedir(d);
+
+    if (total > limit) {
+        qsort(entries, count, sizeof(cache_entry_T), cacheEntryCmp);
+        for (int i = 0; i < count && total > limit; i++) {
+            snprintf(path, path_len, "%s/%s", dir, entries[i].name);
+            if (unlink(path) == 0) total -= entries[i].size;
+        }
+    }
+
+    memFree(MEM_CACHE, entries);
+    memFree(MEM_CACHE, path);
+}
+
+/**
+ * Súbor so štatistikou je počas úpravy uzamknutý, vlákna tohto procesu mutexom a procesy
+ * zámkom flock na práve otvorenom súbore (zámok fcntl patrí procesu, vlákna by ho zdieľali),
+ * počty sa preto nestratia.
+ * @brief Započíta zásah alebo minutie do štatistiky procesu a adresára cache
+*/
+static void cacheCount(char *dir, bool hit) {
+    if (hit) cache_hits++;
+    else cache_misses++;
+
+    size_t path_len = strlen(dir) + sizeof(CACHE_STATS_FILE) + 1;
+    char *path = memAlloc(MEM_CACHE, path_len);
+    if (path == NULL) exit(COMPILER_ERROR);
+    snprintf(path, path_len, "%s/" CACHE_STATS_FILE, dir);
+
+    pthread_mutex_lock(&cache_stats_lock);
+    int fd = open(path, O_RDWR | O_CREAT, 0644);
+    memFree(MEM_CACHE, path);
+    if (fd >= 0 && flock(fd, LOCK_EX) == 0) {
+        char line[64] = "";
+        long long hits = 0, misses = 0;
+        ssize_t n = pread(fd, line, sizeof(line) - 1, 0);
+        if (n > 0) {
+            line[n] = '\0';
+            sscanf(line, "%lld %lld", &hits, &misses);
+        }
+        if (hit) hits++;
+        else misses++;
+        int len = snprintf(line, sizeof(line), "%lld %lld\n", hits, misses);
+        if (pwrite(fd, line, len, 0) == len) ftruncate(fd, len);
+    }
+    if (fd >= 0) close(fd); // uvoľní aj zámok
+    pthread_mutex_unlock(&cache_stats_lock);
+}
+
+char *cacheLoad(char *dir, char *key, size_t *size) {
+    size_t path_len = strlen(dir) + CACHE_KEY_LEN + 2;
+    char *path = memAlloc(MEM_CACHE, path_len);
+    if (path == NULL) exit(COMPILER_ERROR);
+    snprintf(path, path_len, "%s/%s", dir, key);
+    FILE *entry = fopen(path, "r");
+    memFree(MEM_CACHE, path);
+    if (entry == NULL) return NULL;
+
+    futimens(fileno(entry), NULL); // čas poslednej zmeny slúži ako čas posledného použitia
+    char *data = cacheReadAll(entry, size);
+    fclose(entry);
+    if (data != NULL) data[*size] = '\0'; // cacheReadAll necháva v bufferi vždy voľné miesto
+    return data;
+}
+
+void cacheSave(char *dir, char *key, const char *data, size_t size) {
+    char *tmp_path;
+    int fd = cacheTempFile(dir, &tmp_path);
+    if (fd >= 0) {
+        cacheCommit(dir, key, fd, tmp_path, writerWriteAll(fd, data, size));
+    }
+    memFree(MEM_CACHE, tmp_path);
+}
+
+void cacheCountFunction(bool hit) {
+    if (hit) cache_fn_hits++;
+    else cache_fn_misses++;
+}
+
+int cacheCompile(ctx_T *ctx, compiler_T *c) {
+    char *dir = c->options.cache;
+    size_t size;
+    char *source = cacheReadAll(c->input, &size);
+    if (source == NULL) return COMPILER_ERROR;
+
+    REPORT_ENTER(REPORT_CACHE);
+    char key[CACHE_KEY_LEN + 1];
+    cacheKey(&(c->options), source, size, key);
+    size_t path_len = strlen(dir) + CACHE_KEY_LEN + 2;
+    char *path = memAlloc(MEM_CACHE, path_len);
+    if (path == NULL) exit(COMPILER_ERROR);
+    snprintf(path, path_len, "%s/%s", dir, key);
+
+    int result;
+    bool hit = cacheReplay(path, size, c, &result);
+    memFree(MEM_CACHE, path);
+    cacheCount(dir, hit);
+    REPORT_LEAVE();
+    if (hit) {
+        memFree(MEM_CACHE, source);
+        return result;
+    }
+
+    // preklad s výstupmi do dočasných súborov, program sa číta z pamäte (umožňuje fseek)
+    FILE *input = size > 0 ? fmemopen(source, size, "r") : tmpfile();
+    FILE *code = tmpfile(), *diagnostics = tmpfile();
+    if (input == NULL || code == NULL || diagnostics == NULL) exit(COMPILER_ERROR);
+    // ide o ten istý preklad, pri c->fast_exit sa ani pri minutí neuvoľňujú dátové štruktúry prekladača
+    compiler_T direct = { input, fileno(code), diagnostics, c->options, c->fast_exit };
+    result = compileUncached(ctx, &direct);
+
+    REPORT_ENTER(REPORT_CACHE);
+    if (result != COMPILER_ERROR) { // chyba prekladača nemusí byť pri ďalšom preklade rovnaká
+        cacheStore(dir, key, size, result, code, diagnostics);
+    }
+    cacheEvict(dir, (long long)c->options.cache_limit * 1024); // aj záznamy funkcií z inkrementálneho prekladu
+    REPORT_LEAVE();
+    REPORT_ENTER(REPORT_OUTPUT);
+    cacheCopy(code, writerFileSize(code), c->output_fd, NULL);
+    cacheCopy(diagnostics, writerFileSize(diagnostics), -1, c->diagnostics != NULL ? c->diagnostics : stderr);
+    REPORT_LEAVE();
+
+    fclose(input);
+    fclose(code);
+    fclose(diagnostics);
+    memFree(MEM_CACHE, source);
+    return result;
+}
+
+void cachePrintStats(char *dir, FILE *out) {
+    long long hits = 0, misses = 0;
+    size_t path_len = strlen(dir) + sizeof(CACHE_STATS_FILE) + 1;
+    char *path = memAlloc(MEM_CACHE, path_len);
+    if (path == NULL) exit(COMPILER_ERROR);
+    snprintf(path, path_len, "%s/" CACHE_STATS_FILE, dir);
+    FILE *stats = fopen(path, "r");
+    memFree(MEM_CACHE, path);
+    if (stats != NULL) {
+        if (fscanf(stats, "%lld %lld", &hits, &misses) != 2) hits = misses = 0;
+        fclose(stats);
+    }
+
+    long run_hits = cache_hits, run_misses = cache_misses;
+    fprintf(out, "cache: %ld hits, %ld misses (%.1f%% hit rate); total %lld hits, %lld misses (%.1f%% hit rate)\n",
+        run_hits, run_misses, run_hits + run_misses > 0 ? 100.0 * run_hits / (run_hits + run_misses) : 0.0,
+        hits, misses, hits + misses > 0 ? 100.0 * hits / (hits + misses) : 0.0);
+    long fn_hits = cache_fn_hits, fn_misses = cache_fn_misses;
+    if (fn_hits + fn_misses > 0) fprintf(out, "cache: %ld functions reused, %ld compiled\n", fn_hits, fn_misses);
+}
+
+/* Koniec súboru cache.c */
@@ -0,0 +1,80 @@
+/** Projekt IFJ2023
+ * @file cache.h
+ * @brief Prekladová cache adresovaná obsahom zdrojového programu
+ * @author agent (agent@local)
+ * @date 19.10.2026
+ */
+
+#ifndef _CACHE_H_
+#define _CACHE_H_
+
+#include <stdint.h>
+#include <stdio.h>
+#include "compiler.h"
+
+/** Dĺžka kľúča (názvu súboru) záznamu v cache, 128-bitový hash v šestnástkovej sústave */
+#define CACHE_KEY_LEN 32
+
+/**
+ * Kľúčom záznamu je hash verzie prekladača (vrátane času jeho zostavenia), prepínačov ovplyvňujúcich
+ * preklad a zdrojového programu. Pri zásahu sa uložený kód, hlásenia chýb a návratový kód
+ * zopakujú bez spustenia skenera a parsera a záznam sa označí ako práve použitý. Inak sa program
+ * preloží v kontexte ctx, výsledok sa uloží (okrem COMPILER_ERROR) a pri prekročení c->options.cache_limit sa
+ * odstránia najdlhšie nepoužité záznamy. Adresár c->options.cache musí existovať.
+ *
+ * @brief Preloží program s využitím cache
+ * @return návratový kód prekladu
+*/
+int cacheCompile(ctx_T *ctx, compiler_T *c);
+
+/**
+ * Pri inkrementálnom preklade vypíše aj počet funkcií prevzatých z cache a preložených v tomto procese.
+ * @brief Vypíše počet zásahov a minutí cache v tomto procese a celkovo pre adresár dir
+*/
+void cachePrintStats(char *dir, FILE *out);
+
+/**
+ * @brief Dvojica 64-bitových hashov (FNV-1a a multiplikatívny s premiešaním), z ktorej vzniká kľúč záznamu
+*/
+typedef struct cache_hash {
+    uint64_t a;
+    uint64_t b;
+} cache_hash_T;
+
+/**
+ * Prepínače, ktoré výsledok neovplyvňujú (cache, dávka, server), sa do hashu nezahŕňajú.
+ * @brief Začne hash kľúča verziou prekladača a prepínačmi ovplyvňujúcimi preklad
+*/
+void cacheHashInit(cache_hash_T *h, options_T *opt);
+
+/**
+ * @brief Pridá do hashu blok dát
+*/
+void cacheHashAdd(cache_hash_T *h, const char *data, size_t size);
+
+/**
+ * @brief Zapíše hash ako kľúč záznamu
+ * @param key výsledok, CACHE_KEY_LEN + 1 znakov
+*/
+void cacheHashKey(cache_hash_T *h, char *key);
+
+/**
+ * @brief Načíta celý záznam s kľúčom key a označí ho ako práve použitý
+ * @param size veľkosť načítaného záznamu
+ * @return obsah záznamu zakončený '\0' (treba uvoľniť) alebo NULL, ak záznam neexistuje
+*/
+char *cacheLoad(char *dir, char *key, size_t *size);
+
+/**
+ * Limit veľkosti cache sa kontroluje až na konci prekladu v cacheCompile.
+ * @brief Uloží záznam s kľúčom key
+*/
+void cacheSave(char *dir, char *key, const char *data, size_t size);
+
+/**
+ * @brief Započíta funkciu prevzatú z cache (hit) alebo preloženú pri inkrementálnom preklade
+*/
+void cacheCountFunction(bool hit);
+
+#endif // ifndef _CACHE_H_
+/* Koniec súboru cache.h */
@@ -0,0 +1,224 @@
+/** Projekt IFJ2023
+ * @file cfg.c
+ * @brief Graf toku riadenia (CFG) nad vygenerovaným cieľovým kódom
+ * @author agent (agent@local)
+ * @date 19.10.2026
+ */
+
+#include <string.h>
+#include "cfg.h"
+#include "memory.h"
+#include "parser.h"
+
+/**
+ * @brief Náveštie a blok, ktorý ním začína
+*/
+typedef struct cfg_label {
+    char *name;     ///< názov náveštia, ukazuje do reťazca inštrukcie, končí medzerou alebo '\0'
+    int block;      ///< index bloku
+} cfg_label_T;
+
+/**
+ * @brief Zistí, či má inštrukcia daný operačný kód
+*/
+static bool cfgInsIs(char *ins, char *opcode) {
+    size_t len = strlen(opcode);
+    return strncmp(ins, opcode, len) == 0 && (ins[len] == ' ' || ins[len] == '\0');
+}
+
+/**
+ * @brief Zistí, či je inštrukcia skok v rámci kódu (nepodmienený alebo podmienený)
+*/
+static bool cfgIsJump(char *ins) {
+    return cfgInsIs(ins, INS_JUMP) || cfgInsIs(ins, INS_JUMPIFEQ) || cfgInsIs(ins, INS_JUMPIFNEQ) ||
+        cfgInsIs(ins, INS_JUMPIFEQS) || cfgInsIs(ins, INS_JUMPIFNEQS);
+}
+
+/**
+ * @brief Zistí, či za inštrukciou končí základný blok
+*/
+static bool cfgEndsBlock(char *ins) {
+    return cfgIsJump(ins) || cfgInsIs(ins, INS_RETURN) || cfgInsIs(ins, INS_EXIT);
+}
+
+/**
+ * @brief Zistí, či po vykonaní inštrukcie môže pokračovať vykonávanie nasledujúcou inštrukciou
+*/
+static bool cfgFallsThrough(char *ins) {
+    return !cfgInsIs(ins, INS_JUMP) && !cfgInsIs(ins, INS_RETURN) && !cfgInsIs(ins, INS_EXIT);
+}
+
+/**
+ * @brief Vráti prvý operand inštrukcie (náveštie skoku alebo LABEL)
+*/
+static char *cfgFirstOperand(char *ins) {
+    char *space = strchr(ins, ' ');
+    return space == NULL ? NULL : space + 1;
+}
+
+/**
+ * @brief Porovnanie náveští ukončených medzerou alebo '\0' pre qsort a bsearch
+*/
+static int cfgLabelCmp(const void *a, const void *b) {
+    const char *x = ((cfg_label_T *)a)->name, *y = ((cfg_label_T *)b)->name;
+    while (*x != '\0' && *x != ' ' && *x == *y) {
+        x++;
+        y++;
+    }
+    int cx = *x == ' ' ? '\0' : *x, cy = *y == ' ' ? '\0' : *y;
+    return (unsigned char)cx - (unsigned char)cy;
+}
+
+/**
+ * @brief Pridá hranu from -> to, pri zostavovaní sa predchodcovia len počítajú
+*/
+static void cfgAddEdge(cfg_T *cfg, int from, int to) {
+    cfg_block_T *block = &(cfg->blocks[from]);
+    for (int i = 0; i < block->succ_count; i++) {
+        if (block->succ[i] == to) return; // podmienený skok na nasledujúci blok
+    }
+    block->succ[block->succ_count++] = to;
+    cfg->blocks[to].pred_count++;
+}
+
+void cfgBuild(DLLstr_T *code, cfg_T *cfg) {
+    cfg->blocks = NULL;
+    cfg->count = 0;
+
+    // hranice blokov
+    int capacity = 0, label_count = 0;
+    for (DLLstr_el_ptr el = code->first; el != NULL; el = el->next) capacity++;
+    if (capacity == 0) return;
+    cfg->blocks = memCalloc(MEM_OPTIMIZER, capacity, sizeof(cfg_block_T));
+    cfg_label_T *labels = memAlloc(MEM_OPTIMIZER, capacity * sizeof(cfg_label_T));
+    if (cfg->blocks == NULL || labels == NULL) exit(COMPILER_ERROR);
+
+    cfg_block_T *block = NULL;
+    for (DLLstr_el_ptr el = code->first; el != NULL; el = el->next) {
+        bool is_label = cfgInsIs(el->string, INS_LABEL);
+        if (block == NULL || (is_label && block->size > 0)) {
+            block = &(cfg->blocks[cfg->count++]);
+            block->first = el;
+        }
+        if (is_label && cfgFirstOperand(el->string) != NULL) {
+            labels[label_count].name = cfgFirstOperand(el->string);
+            labels[label_count++].block = cfg->count - 1;
+        }
+        block->last = el;
+        block->size++;
+        if (cfgEndsBlock(el->string)) block = NULL;
+    }
+    qsort(labels, label_count, sizeof(cfg_label_T), cfgLabelCmp);
+
+    // hrany
+    for (int i = 0; i < cfg->count; i++) {
+        char *last = cfg->blocks[i].last->string;
+        if (cfgIsJump(last) && cfgFirstOperand(last) != NULL) {
+            cfg_label_T key = { cfgFirstOperand(last), 0 };
+            cfg_label_T *found = bsearch(&key, labels, label_count, sizeof(cfg_label_T), cfgLabelCmp);
+            if (found != NULL) cfgAddEdge(cfg, i, found->block);
+        }
+        if (cfgFallsThrough(last) && i + 1 < cfg->count) cfgAddEdge(cfg, i, i + 1);
+    }
+    memFree(MEM_OPTIMIZER, labels);
+
+    // predchodcovia
+    for (int i = 0; i < cfg->count; i++) {
+        if (cfg->blocks[i].pred_count == 0) continue;
+        cfg->blocks[i].pred = memAlloc(MEM_OPTIMIZER, cfg->blocks[i].pred_count * sizeof(int));
+        if (cfg->blocks[i].pred == NULL) exit(COMPILER_ERROR);
+        cfg->blocks[i].pred_count = 0;
+    }
+    for (int i = 0; i < cfg->count; i++) {
+        for (int j = 0; j < cfg->blocks[i].succ_count; j++) {
+            cfg_block_T *succ = &(cfg->blocks[cfg->blocks[i].succ[j]]);
+            succ->pred[succ->pred_count++] = i;
+        }
+    }
+}
+
+void cfgDestroy(cfg_T *cfg) {
+    for (int i = 0; i < cfg->count; i++) memFree(MEM_OPTIMIZER, cfg->blocks[i].pred);
+    memFree(MEM_OPTIMIZER, cfg->blocks);
+    cfg->blocks = NULL;
+    cfg->count = 0;
+}
+
+void cfgReachable(cfg_T *cfg, bool *reachable) {
+    if (cfg->count == 0) return;
+    memset(reachable, 0, cfg->count * sizeof(bool));
+    int *worklist = memAlloc(MEM_OPTIMIZER, cfg->count * sizeof(int));
+    if (worklist == NULL) exit(COMPILER_ERROR);
+
+    int top = 0;
+    worklist[top++] = 0;
+    reachable[0] = true;
+    while (top > 0) {
+        cfg_block_T *block = &(cfg->blocks[worklist[--top]]);
+        for (int i = 0; i < block->succ_count; i++) {
+            if (reachable[block->succ[i]]) continue;
+            reachable[block->succ[i]] = true;
+            worklist[top++] = block->succ[i];
+        }
+    }
+
+    memFree(MEM_OPTIMIZER, worklist);
+}
+
+/* ----------- VÝPIS VO FORMÁTE GRAPHVIZ ----------- */
+
+/**
+ * Znaky '"' a '\\' sa escapujú, riadky sú zarovnané vľavo ("\l").
+ * @brief Vypíše inštrukcie bloku ako text uzla
+*/
+static void cfgPrintBlockLabel(FILE *out, cfg_block_T *block) {
+    DLLstr_el_ptr el = block->first;
+    for (int i = 0; i < block->size; i++, el = el->next) {
+        for (char *c = el->string; *c != '\0'; c++) {
+            if (*c == '"' || *c == '\\') fputc('\\', out);
+            fputc(*c, out);
+        }
+        fputs("\\l", out);
+    }
+}
+
+/**
+ * @brief Vypíše graf toku riadenia jedného kódu ako podgraf
+ * @param id identifikátor podgrafu, predpona uzlov
+ * @param title nadpis podgrafu
+*/
+static void cfgPrintCluster(FILE *out, DLLstr_T *code, char *id, char *title) {
+    cfg_T cfg;
+    cfgBuild(code, &cfg);
+
+    fprintf(out, "  subgraph cluster_%s {\n", id);
+    fprintf(out, "    label=\"%s\";\n", title);
+    for (int i = 0; i < cfg.count; i++) {
+        fprintf(out, "    %s_%d [label=\"", id, i);
+        cfgPrintBlockLabel(out, &(cfg.blocks[i]));
+        fprintf(out, "\"];\n");
+    }
+    for (int i = 0; i < cfg.count; i++) {
+        for (int j = 0; j < cfg.blocks[i].succ_count; j++) {
+            fprintf(out, "    %s_%d -> %s_%d;\n", id, i, id, cfg.blocks[i].succ[j]);
+        }
+    }
+    fprintf(out, "  }\n");
+
+    cfgDestroy(&cfg);
+}
+
+void cfgPrintProgram(gen_T *gen, FILE *out) {
+    char id[32];
+    fprintf(out, "digraph cfg {\n");
+    fprintf(out, "  node [shape=box, fontname=monospace];\n");
+    for (int i = 0; i < gen->code_fns.count; i++) {
+        if (gen->code_fns.array[i].code.first == NULL) continue; // odstránená funkcia
+        sprintf(id, "fn%d", i);
+        cfgPrintCluster(out, &(gen->code_fns.array[i].code), id, gen->code_fns.array[i].name);
+    }
+    cfgPrintCluster(out, &gen->code_main, "main", "!main");
+    fprintf(out, "}\n");
+}
+
+/* Koniec súboru cfg.c */
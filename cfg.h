@@ -0,0 +1,72 @@
+/** Projekt IFJ2023
+ * @file cfg.h
+ * @brief Graf toku riadenia (CFG) nad vygenerovaným cieľovým kódom
+ * @author agent (agent@local)
+ * @date 19.10.2026
+ */
+
+#ifndef _CFG_H_
+#define _CFG_H_
+
+#include <stdio.h>
+#include "generator.h"
+
+/** Maximálny počet nasledovníkov bloku, cieľ skoku a nasledujúci blok */
+#define CFG_MAX_SUCC 2
+
+/**
+ * Blok začína náveštím, prvou inštrukciou kódu alebo inštrukciou za skokom, RETURN či EXIT.
+ * Končí skokom, RETURN, EXIT alebo inštrukciou pred ďalším náveštím.
+ *
+ * @brief Základný blok, postupnosť inštrukcií vykonávaná vždy celá od začiatku po koniec
+*/
+typedef struct cfg_block {
+    DLLstr_el_ptr first;        ///< prvá inštrukcia bloku
+    DLLstr_el_ptr last;         ///< posledná inštrukcia bloku
+    int size;                   ///< počet inštrukcií bloku
+    int succ[CFG_MAX_SUCC];     ///< indexy nasledovníkov, pri podmienenom skoku je prvý cieľ skoku
+    int succ_count;             ///< počet nasledovníkov
+    int *pred;                  ///< indexy predchodcov
+    int pred_count;             ///< počet predchodcov
+} cfg_block_T;
+
+/**
+ * @brief Graf toku riadenia kódu jednej funkcie alebo hlavného tela programu
+*/
+typedef struct cfg {
+    cfg_block_T *blocks;        ///< bloky v poradí kódu, blok 0 je vstupný
+    int count;                  ///< počet blokov
+} cfg_T;
+
+/**
+ * Skoky na náveštia, ktoré sa v kóde nenachádzajú, hranu nevytvoria. Graf ukazuje na prvky
+ * zoznamu code, po zmene kódu je preto potrebné graf zrušiť a prípadne zostaviť znova.
+ *
+ * @brief Rozdelí kód na základné bloky a určí hrany medzi nimi
+ * @param code kód funkcie alebo hlavného tela programu
+ * @param cfg výsledný graf, treba uvoľniť pomocou cfgDestroy
+*/
+void cfgBuild(DLLstr_T *code, cfg_T *cfg);
+
+/**
+ * @brief Uvoľní zdroje grafu toku riadenia
+*/
+void cfgDestroy(cfg_T *cfg);
+
+/**
+ * @brief Označí bloky dosiahnuteľné zo vstupného bloku
+ * @param reachable pole o veľkosti cfg->count, výsledok
+*/
+void cfgReachable(cfg_T *cfg, bool *reachable);
+
+/**
+ * Každá funkcia z gen->code_fns aj hlavné telo programu tvorí samostatný podgraf (cluster),
+ * uzly obsahujú inštrukcie bloku. Výstup je možné zobraziť napr. pomocou "dot -Tpng".
+ *
+ * @brief Vypíše grafy toku riadenia celého programu vo formáte Graphviz
+ * @param out výstupný súbor
+*/
+void cfgPrintProgram(gen_T *gen, FILE *out);
+
+#endif // ifndef _CFG_H_
+/* Koniec súboru cfg.h */
@@ -0,0 +1,127 @@
+/** Projekt IFJ2023
+ * @file client.c
+ * @brief Klient prekladového servera, správa sa ako prekladač čítajúci stdin
+ * @author agent (agent@local)
+ * @date 19.10.2026
+ *
+ * Použitie: client.out SOCKET [prepínače] <program >kód
+ * Cieľový kód vypíše na stdout, hlásenia chýb na stderr a skončí návratovým kódom prekladu.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include "options.h"
+#include "parser.h"
+#include "server.h"
+#include "writer.h"
+
+/**
+ * @brief Prekopíruje size bajtov (alebo všetko do konca pri size < 0) z deskriptora from do to
+ * @return true v prípade úspechu, inak false
+*/
+static bool clientCopy(int from, int to, long size) {
+    char buffer[SERVER_MAX_LINE];
+    while (size != 0) {
+        size_t want = size < 0 || size > (long)sizeof(buffer) ? sizeof(buffer) : (size_t)size;
+        ssize_t n = read(from, buffer, want);
+        if (n < 0 && errno == EINTR) continue;
+        if (n < 0) return false;
+        if (n == 0) return size < 0;
+        if (!writerWriteAll(to, buffer, n)) return false;
+        if (size > 0) size -= n;
+    }
+    return true;
+}
+
+/**
+ * @brief Prečíta riadok hlavičky odpovede
+ * @return true v prípade úspechu, inak false
+*/
+static bool clientReadLine(int fd, char *line, size_t size) {
+    for (size_t i = 0; i + 1 < size; i++) {
+        if (read(fd, &line[i], 1) != 1) return false;
+        if (line[i] == '\n') {
+            line[i + 1] = '\0';
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Odošle hlavičku požiadavky s prepínačmi
+ * @return true v prípade úspechu, inak false
+*/
+static bool clientSendOptions(int fd, int argc, char **argv) {
+    char line[SERVER_MAX_LINE];
+    snprintf(line, sizeof(line), "%d\n", argc);
+    if (!writerWriteAll(fd, line, strlen(line))) return false;
+    for (int i = 0; i < argc; i++) {
+        if (!writerWriteAll(fd, argv[i], strlen(argv[i])) || !writerWriteAll(fd, "\n", 1)) return false;
+    }
+    return true;
+}
+
+int main(int argc, char **argv) {
+    if (argc < 2) {
+        fprintf(stderr, "usage: %s SOCKET [options] <program\n", argv[0]);
+        return COMPILER_ERROR;
+    }
+    // prepínače sa overia rovnako ako v prekladači, argv[1] je namiesto názvu programu
+    options_T options = options_default;
+    if (!parseOptions(argc - 1, argv + 1, &options)) return COMPILER_ERROR;
+    if (options.batch != NULL || options.server != NULL || options.name_map != NULL || options.cache != NULL) {
+        fprintf(stderr, "options --batch, --server, --name-map and --cache are not supported by the client\n");
+        return COMPILER_ERROR;
+    }
+    if (argc - 2 > SERVER_MAX_ARGS) {
+        fprintf(stderr, "too many options\n");
+        return COMPILER_ERROR;
+    }
+
+    struct sockaddr_un addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    if (strlen(argv[1]) >= sizeof(addr.sun_path)) {
+        fprintf(stderr, "socket path too long: %s\n", argv[1]);
+        return COMPILER_ERROR;
+    }
+    strcpy(addr.sun_path, argv[1]);
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0 || connect(fd, (struct sockaddr *)&addr, sizeof(addr)) != 0) {
+        fprintf(stderr, "cannot connect to %s: %s\n", argv[1], strerror(errno));
+        return COMPILER_ERROR;
+    }
+
+    // požiadavka: prepínače a zdrojový program
+    if (!clientSendOptions(fd, argc - 2, argv + 2) || !clientCopy(STDIN_FILENO, fd, -1) ||
+        shutdown(fd, SHUT_WR) != 0) {
+        fprintf(stderr, "cannot send request: %s\n", strerror(errno));
+        close(fd);
+        return COMPILER_ERROR;
+    }
+
+    // odpoveď: návratový kód, kód a hlásenia chýb
+    char line[SERVER_MAX_LINE];
+    int result;
+    long code_size, diagnostics_size;
+    if (!clientReadLine(fd, line, sizeof(line)) ||
+        sscanf(line, "%d %ld %ld", &result, &code_size, &diagnostics_size) != 3 ||
+        !clientCopy(fd, STDOUT_FILENO, code_size) || !clientCopy(fd, STDERR_FILENO, diagnostics_size)) {
+        fprintf(stderr, "invalid response from server\n");
+        close(fd);
+        return COMPILER_ERROR;
+    }
+
+    close(fd);
+    return result;
+}
+
+/* Koniec súboru client.c */
@@ -0,0 +1,98 @@
+/** Projekt IFJ2023
+ * @file compiler.c
+ * @brief Preklad jedného programu, opakovateľný v rámci jedného procesu
+ * @author agent (agent@local)
+ * @date 19.10.2026
+ */
+
+#include "compiler.h"
+#include "parser.h"
+#include "generator.h"
+#include "logErr.h"
+#include "cache.h"
+#include "report.h"
+#include "memory.h"
+
+/**
+ * @brief Spracuje celý zdrojový program a vypíše vygenerovaný kód
+ * @return 0 v prípade úspechu, inak číslo chyby
+*/
+static int compileProgram(ctx_T *ctx) {
+    TRY_OR_EXIT(nextToken(ctx)); // načítať prvý token
+    while (ctx->tkn->type != EOF_TKN)
+    {
+        TRY_OR_EXIT(parse(ctx));   // spracovanie základneho príkazu, pravidlo <STAT>
+        TRY_OR_EXIT(nextToken(ctx));
+    }
+
+    TRY_OR_EXIT(checkIfAllFnDef(ctx)); // zistí, či boli definované všetky volané funkcie
+
+    TRY_OR_EXIT(printOutCompiledCode(ctx)); // výpis vygenerovaného cieľového kódu
+    return COMPILATION_OK;
+}
+
+///< aréna pre alokácie prekladu v tomto vlákne, pri c->fast_exit ostane alokovaná do konca procesu
+static _Thread_local mem_arena_T compile_arena;
+
+int compile(compiler_T *c) {
+    ctx_T *ctx = calloc(1, sizeof(ctx_T)); // obsahuje vyrovnávaciu pamäť výstupu, na zásobník sa nehodí
+    if (ctx == NULL) return COMPILER_ERROR;
+    int result = compileWith(ctx, c);
+    if (!c->fast_exit) free(ctx); // inak na kontext ukazujú neuvoľnené dátové štruktúry prekladača
+    return result;
+}
+
+int compileWith(ctx_T *ctx, compiler_T *c) {
+    reportBegin(c->options.time_report);
+    memStatsReset(c->options.time_report || c->options.alloc_stats);
+
+    const allocator_T *previous = NULL;
+    if (!c->options.no_arena) {
+        memArenaInit(&compile_arena);
+        previous = memSetAllocator(&(compile_arena.allocator));
+    }
+
+    int result;
+    // pri postupnom výpise by sa kód vypísal až na konci, mapa názvov by sa nezapísala
+    if (c->options.cache != NULL && !c->options.stream && c->options.name_map == NULL) result = cacheCompile(ctx, c);
+    else result = compileUncached(ctx, c);
+
+    if (!c->options.no_arena) {
+        memSetAllocator(previous);
+        REPORT_ENTER(REPORT_TEARDOWN);
+        if (!c->fast_exit) memArenaDestroy(&compile_arena);
+        REPORT_LEAVE();
+    }
+
+    FILE *diagnostics = c->diagnostics != NULL ? c->diagnostics : stderr;
+    if (c->options.time_report) reportPrint(diagnostics, c->options.time_report == OPT_TIME_REPORT_JSON);
+    if (c->options.alloc_stats) memStatsPrint(diagnostics);
+    return result;
+}
+
+int compileUncached(ctx_T *ctx, compiler_T *c) {
+    // počiatočný stav prekladača v tomto kontexte
+    ctx->options = c->options;
+    scannerReset(&ctx->scanner, c->input);
+    logErrReset(&ctx->log, c->diagnostics);
+    setCompiledCodeOutput(ctx, c->output_fd);
+    if (!initializeParser(ctx)) return COMPILER_ERROR; // inicializácia dátových štruktúr parsera
+
+    REPORT_ENTER(REPORT_PARSER);
+    int result = compileProgram(ctx);
+    REPORT_LEAVE();
+
+    if (ctx->options.time_report) {
+        report_counters.tokens += scannerTokenCount(&ctx->scanner);
+        reportSampleHeap();
+    }
+    if (c->fast_exit) return result; // pamäť vráti koniec procesu
+
+    REPORT_ENTER(REPORT_TEARDOWN);
+    destroyParser(ctx); // dealokácia použitých zdrojov
+    scannerReset(&ctx->scanner, NULL);
+    REPORT_LEAVE();
+    return result;
+}
+
+/* Koniec súboru compiler.c */
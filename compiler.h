@@ -0,0 +1,57 @@
+/** Projekt IFJ2023
+ * @file compiler.h
+ * @brief Preklad jedného programu, opakovateľný v rámci jedného procesu
+ * @author agent (agent@local)
+ * @date 19.10.2026
+ */
+
+#ifndef _COMPILER_H_
+#define _COMPILER_H_
+
+#include <stdbool.h>
+#include <stdio.h>
+#include "options.h"
+#include "parser.h"
+
+/**
+ * @brief Zadanie jedného prekladu
+*/
+typedef struct compiler {
+    FILE *input;        ///< zdrojový program, musí umožňovať fseek
+    int output_fd;      ///< súborový deskriptor pre vygenerovaný kód
+    FILE *diagnostics;  ///< výstup pre hlásenia chýb prekladu, NULL značí stderr
+    options_T options;  ///< nastavenia prekladu
+    bool fast_exit;     ///< proces po preklade skončí, dátové štruktúry prekladača sa neuvoľňujú
+} compiler_T;
+
+/**
+ * Stav prekladača (skener, parser, tabuľka symbolov, vygenerovaný kód, počítadlá identifikátorov)
+ * je v kontexte, ktorý si funkcia alokuje pre tento preklad a po preklade uvoľní. Viac programov
+ * je preto možné preložiť postupne alebo súčasne vo viacerých vláknach, jedno vlákno prekladá
+ * naraz najviac jeden program (alokátor a meranie času patria vláknu).
+ *
+ * Alokácie počas prekladu idú do arény vlákna (okrem --no-arena), ktorá sa po uvoľnení
+ * dátových štruktúr uvoľní naraz. Pri c->fast_exit sa neuvoľňuje nič, pamäť vráti koniec procesu.
+ *
+ * @brief Preloží jeden program
+ * @return návratový kód prekladu (COMPILATION_OK alebo kód chyby)
+*/
+int compile(compiler_T *c);
+
+/**
+ * Kontext sa pred prekladom nastaví do počiatočného stavu a po preklade sa jeho dátové štruktúry
+ * uvoľnia, aj keď preklad skončil chybou, takže ho možno použiť pre ďalší preklad.
+ * @brief Preloží jeden program v kontexte ctx
+ * @return návratový kód prekladu
+*/
+int compileWith(ctx_T *ctx, compiler_T *c);
+
+/**
+ * Volá ju cache pri minutí, prepínač --cache zostáva nastavený pre inkrementálny preklad funkcií.
+ * @brief Preloží jeden program bez použitia cache celých programov
+ * @return návratový kód prekladu
+*/
+int compileUncached(ctx_T *ctx, compiler_T *c);
+
+#endif // ifndef _COMPILER_H_
+/* Koniec súboru compiler.h */
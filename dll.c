@@ -8,6 +8,7 @@
 #include <stdlib.h>
 #include <stdio.h>
 #include "dll.h"
+#include "memory.h"
 
 #define PROGRAM_FAILURE 99
 
@@ -20,7 +21,7 @@
  */
 #define TRY_DEEPCOPY_STRING(dest, src) 						\
 	do { 													\
-		(dest) = malloc(sizeof(char) * (strlen(src) + 1)); 	\
+		(dest) = memAlloc(MEM_LIST, sizeof(char) * (strlen(src) + 1)); 	\
 		if ((dest) == NULL) { 								\
 			SHOW_DLL_ERROR();								\
 			exit(PROGRAM_FAILURE); 							\
@@ -30,8 +31,8 @@
 
 
 void DLLstr_ElementDestroy(DLLstr_el_ptr elem) {
-	free(elem->string);
-	free(elem);
+	memFree(MEM_LIST, elem->string);
+	memFree(MEM_LIST, elem);
 }
 
 void DLLstr_Init(DLLstr_T* list) {
@@ -89,7 +90,7 @@ bool DLLstr_GetValue(DLLstr_T* list, str_T* string) {
 }
 
 void DLLstr_InsertFirst(DLLstr_T* list, char* s) {
-	DLLstr_el_ptr element = malloc(sizeof(struct DLLstr_element));
+	DLLstr_el_ptr element = memAlloc(MEM_LIST, sizeof(struct DLLstr_element));
 	if (element == NULL) { // chyba alokácie pamäte
 		SHOW_DLL_ERROR();
 		exit(PROGRAM_FAILURE);
@@ -109,7 +110,7 @@ void DLLstr_InsertFirst(DLLstr_T* list, char* s) {
 }
 
 void DLLstr_InsertLast(DLLstr_T* list, char* s) {
-	DLLstr_el_ptr element = malloc(sizeof(struct DLLstr_element));
+	DLLstr_el_ptr element = memAlloc(MEM_LIST, sizeof(struct DLLstr_element));
 	if (element == NULL) { // chyba alokácie pamäte
 		SHOW_DLL_ERROR();
 		exit(PROGRAM_FAILURE);
@@ -133,7 +134,7 @@ void DLLstr_InsertAfter(DLLstr_T* list, char* s) {
 	if (list->active == NULL) { // neaktívny zoznam
 		return;
 	}
-	DLLstr_el_ptr element = malloc(sizeof(struct DLLstr_element)); // nový vkladaný prvok
+	DLLstr_el_ptr element = memAlloc(MEM_LIST, sizeof(struct DLLstr_element)); // nový vkladaný prvok
 	if (element == NULL) {
 		SHOW_DLL_ERROR();
 		exit(PROGRAM_FAILURE);
@@ -158,7 +159,7 @@ void DLLstr_InsertBefore(DLLstr_T* list, char* s) {
 	if (list->active == NULL) { // neaktívny zoznam
 		return;
 	}
-	DLLstr_el_ptr element = malloc(sizeof(struct DLLstr_element)); // nový vkladaný prvok
+	DLLstr_el_ptr element = memAlloc(MEM_LIST, sizeof(struct DLLstr_element)); // nový vkladaný prvok
 	if (element == NULL) {
 		SHOW_DLL_ERROR();
 		exit(PROGRAM_FAILURE);
@@ -6,11 +6,15 @@
  */
 
 #include "stdio.h"
+#include <limits.h>
+#include <math.h>
 #include "exp.h"
+#include "memory.h"
 #include "strR.h"
 #include "symtable.h"
 #include "generator.h"
 #include "logErr.h"
+#include "report.h"
 
 
 /** Počas syntaktickej analýzy označuje, že ešte nebol spracovaný žiadny token*/
@@ -30,6 +34,7 @@ typedef struct parsed_token
     str_T codename; // identifikátor v cieľovom kóde
     int ln;         // riadok tokenu
     int col;        // pozícia prvého charakteru tokenu v riadku
+    struct exp_node *node; // podstrom výrazu, ktorý počíta hodnotu operandu
 } ptoken_T;
 
 /**
@@ -52,7 +57,7 @@ typedef struct stack
 */
 bool stack_init( stack_t *stack ) {
 
-    stack->array = calloc(16, sizeof(ptoken_T*)); // Alokácia pamäte pre pole
+    stack->array = memCalloc(MEM_EXPRESSION, 16, sizeof(ptoken_T*)); // Alokácia pamäte pre pole
 	if(stack->array == NULL){ // Alokácia pamäte zlyhala
         return false;
 	}
@@ -80,7 +85,7 @@ ptoken_T *stack_top(stack_t *stack){
 int stack_push_ptoken(stack_t *stack, ptoken_T *token){
     if(stack->capacity == stack->size){         // Ak je zásobník plný
         stack->capacity = stack->capacity*2;    // Zdvojnásobenie kapacity
-        stack->array = realloc(stack->array, stack->capacity*sizeof(token_T));
+        stack->array = memRealloc(MEM_EXPRESSION, stack->array, stack->capacity*sizeof(token_T));
 
         if(stack->array == NULL){ // Realokácia pamäte zlyhala
             fprintf(stderr, "memory reallocation error\n");
@@ -97,25 +102,25 @@ int stack_push_ptoken(stack_t *stack, ptoken_T *token){
  * @brief Konvertuje token na parsed_token a zavolá stack_push_ptoken
  * @returns 0 ak prebehlo vloženie tokenu úspešne, inak chybový kód
 */
-int stack_push_token(stack_t *stack, token_T *token){
+int stack_push_token(ctx_T *ctx, stack_t *stack, token_T *token){
     
     TSData_T *symtabData; // Premenná pre uloženie dát z tabuľky symbolov
 
     if(token->type == ID) // Ak je token identifikátor, musíme ho vyhľadať v tabuľke symbolov
     {
-        symtabData = SymTabLookup(&symt, StrRead(&(token->atr))); // Získanie dát o premennej z tabuľky symbolov
+        symtabData = SymTabLookup(&ctx->symt, StrRead(&(token->atr))); // Získanie dát o premennej z tabuľky symbolov
 
         if(symtabData == NULL){ // Premenná nebola deklarovaná
-            logErrCodeAnalysis(SEM_ERR_UNDEF, token->ln, token->col,"variable was not declared");
+            logErrCodeAnalysis(&ctx->log, SEM_ERR_UNDEF, token->ln, token->col,"variable was not declared");
             return SEM_ERR_UNDEF;
         }
         if(symtabData->init == false){ // Premenná nebola inicializovaná
-            logErrCodeAnalysis(SEM_ERR_UNDEF, token->ln, token->col,"variable was not initialised");
+            logErrCodeAnalysis(&ctx->log, SEM_ERR_UNDEF, token->ln, token->col,"variable was not initialised");
             return SEM_ERR_UNDEF;
         }
     }
 
-    ptoken_T *parsed_token = malloc(sizeof(ptoken_T)); // Nový parsed token
+    ptoken_T *parsed_token = memAlloc(MEM_EXPRESSION, sizeof(ptoken_T)); // Nový parsed token
     if(parsed_token == NULL){
         fprintf(stderr, "memory allocation error\n");
         return COMPILER_ERROR;
@@ -130,6 +135,7 @@ int stack_push_token(stack_t *stack, token_T *token){
     parsed_token->type = token->type;   // Typ tokenu
     parsed_token->ln = token->ln;       // Riadok tokenu
     parsed_token->col = token->col;     // Pozícia v riadku tokenu
+    parsed_token->node = NULL;          // Uzol stromu výrazu vzniká až počas sémantickej analýzy
 
     if(token->type == ID) // Operand je premenná
     {
@@ -140,7 +146,7 @@ int stack_push_token(stack_t *stack, token_T *token){
 
     if(token->type == INT_CONST || token->type == DOUBLE_CONST || token->type == STRING_CONST || token->type == NIL)// Operand je konštanta
     {
-        genConstVal(token->type, StrRead(&(tkn->atr)), &codename); // Získanie identifikátoru v cieľovom kóde pre konštantu
+        genConstVal(token->type, StrRead(&(ctx->tkn->atr)), &codename); // Získanie identifikátoru v cieľovom kóde pre konštantu
 
         parsed_token->codename = codename; // Identifikátor v cieľovom kóde
         switch (parsed_token->type){
@@ -193,7 +199,7 @@ void stack_pop_destroy(stack_t *stack){
     {
         StrDestroy(&(element->id));         // Odstránenie strR id
         StrDestroy(&(element->codename));   // Odstránenie strR codename
-        free(element);                      // Uvoľenie pamäte alokovanej pre prvok
+        memFree(MEM_EXPRESSION, element);                      // Uvoľenie pamäte alokovanej pre prvok
     }
     stack_pop(stack); // Odstránenie prvku zo zásobníka
 }
@@ -206,11 +212,11 @@ void stack_clear(stack_t *stack){
         
         while(stack->size > 0)      // Kým sa nevymažú všetky položky
         {
-            free(stack_top(stack)); // Odstránenie alokovanej pamäti prvku
+            memFree(MEM_EXPRESSION, stack_top(stack)); // Odstránenie alokovanej pamäti prvku
             stack_pop(stack);       // Odstránenie prvku zo zásobníka
         }
     }
-    free(stack->array);             // Uvoľnenie alokovanej pamäti zoznamu
+    memFree(MEM_EXPRESSION, stack->array);             // Uvoľnenie alokovanej pamäti zoznamu
     stack->size = 0;
 }
 
@@ -224,7 +230,7 @@ void stack_dispose(stack_t *stack){
         {
             stack_pop_destroy(stack);   // Odstránenie prvku zo zásobníka a vymazanie
         }
-        free(stack->array);             // Uvoľnenie alokovanej pamäti zoznamu
+        memFree(MEM_EXPRESSION, stack->array);             // Uvoľnenie alokovanej pamäti zoznamu
     }
 
     stack->capacity = stack->size = 0;  // Veľkosť a kapacita = 0
@@ -235,23 +241,88 @@ void stack_dispose(stack_t *stack){
 **************************************************************************************************/
 
 /**
- * @brief Vygeneruje kód pre konverziu int konštanty na double 
+ * @brief Vlastnosti tokenu z pohľadu výrazu, príznaky TC_XXX
+ * @details Tokeny, ktoré nemajú príznak TC_EXPR, nemôžu byť súčasťou výrazu. Ak sa vyskytnú
+ * na rovnakom riadku ako výraz, výraz nie je valídny, inak indikujú koniec výrazu.
 **/
-void int2double(ptoken_T *var_a, ptoken_T *var_b){
+#define TC_EXPR     0x01 ///< token môže byť súčasťou výrazu
+#define TC_OPERAND  0x02 ///< operand (premenná alebo konštanta)
+#define TC_BINARY   0x04 ///< binárny operátor
+#define TC_ARITH    0x08 ///< aritmetický operátor
+#define TC_REL      0x10 ///< relačný operátor
 
-    if(var_a->type == INT_CONST){   // Int konštanta je na zásobníku druhá z vrchu
-        genCode("POPS","GF@!tmp2", NULL, NULL);             // Popnutie double premennej
-        genCode("POPS","GF@!tmp1", NULL, NULL);             // Popnutie int premennej
-        genCode("INT2FLOAT", "GF@!tmp3", "GF@!tmp1", NULL); // Konverzia int na double
-        genCode("PUSHS", "GF@!tmp3", NULL, NULL);           // Pushnutie konvertovanej premennej späť na zásobník
-        genCode("PUSHS", "GF@!tmp2", NULL, NULL);           // Pushnutie double premennej späť na zásobník
-    }
-    if(var_b->type == INT_CONST){ // Int konštanta je na vrchole zásobníku
-        genCode("POPS","GF@!tmp1", NULL, NULL);             // Popnutie int premennej
-        genCode("INT2FLOAT", "GF@!tmp3", "GF@!tmp1", NULL); // Konverzia int na double
-        genCode("PUSHS", "GF@!tmp3", NULL, NULL);           // Pushnutie konvertovanej premennej späť na zásobník
-    }
-}
+/**
+ * @brief Terminály precedenčnej tabuľky, viď doc/precedence_table.png
+**/
+typedef enum prec_term {
+    PT_EXCL,    ///< !
+    PT_MUL,     ///< * /
+    PT_ADD,     ///< + -
+    PT_ID,      ///< operand
+    PT_REL,     ///< == != < > <= >=
+    PT_NILTEST, ///< ??
+    PT_BRT_L,   ///< (
+    PT_BRT_R,   ///< )
+    PT_COUNT    ///< počet terminálov
+} prec_term_T;
+
+/**
+ * @brief Informácie o tokene potrebné pre precedenčnú analýzu
+**/
+typedef struct token_info {
+    unsigned char flags;    ///< príznaky TC_XXX
+    unsigned char term;     ///< terminál precedenčnej tabuľky, prec_term_T
+} token_info_T;
+
+/**
+ * @brief Tabuľka vlastností tokenov indexovaná hodnotami token_ids
+ * @note Operátor "minus" je v tejto implementácii len binárny
+**/
+static const token_info_T token_info[EOF_TKN + 1] = {
+    [ID]            = { TC_EXPR | TC_OPERAND, PT_ID },
+    [INT_CONST]     = { TC_EXPR | TC_OPERAND, PT_ID },
+    [DOUBLE_CONST]  = { TC_EXPR | TC_OPERAND, PT_ID },
+    [STRING_CONST]  = { TC_EXPR | TC_OPERAND, PT_ID },
+    [NIL]           = { TC_EXPR | TC_OPERAND, PT_ID },
+    [BRT_RND_L]     = { TC_EXPR, PT_BRT_L },
+    [BRT_RND_R]     = { TC_EXPR, PT_BRT_R },
+    [OP_PLUS]       = { TC_EXPR | TC_BINARY | TC_ARITH, PT_ADD },
+    [OP_MINUS]      = { TC_EXPR | TC_BINARY | TC_ARITH, PT_ADD },
+    [OP_MUL]        = { TC_EXPR | TC_BINARY | TC_ARITH, PT_MUL },
+    [OP_DIV]        = { TC_EXPR | TC_BINARY | TC_ARITH, PT_MUL },
+    [EQ]            = { TC_EXPR | TC_BINARY | TC_REL, PT_REL },
+    [NEQ]           = { TC_EXPR | TC_BINARY | TC_REL, PT_REL },
+    [GT]            = { TC_EXPR | TC_BINARY | TC_REL, PT_REL },
+    [GTEQ]          = { TC_EXPR | TC_BINARY | TC_REL, PT_REL },
+    [LT]            = { TC_EXPR | TC_BINARY | TC_REL, PT_REL },
+    [LTEQ]          = { TC_EXPR | TC_BINARY | TC_REL, PT_REL },
+    [TEST_NIL]      = { TC_EXPR | TC_BINARY, PT_NILTEST },
+    [EXCL]          = { TC_EXPR, PT_EXCL },
+};
+
+/**
+ * Riadok značí terminál na vrchole zásobníka, stĺpec vstupný terminál:
+ *      '<' ... vstupný operátor sa vloží na zásobník
+ *      '>' ... operátor z vrcholu zásobníka sa presunie do postfixového výrazu
+ *      '=' ... pravá zátvorka uzatvára ľavú zátvorku na vrchole zásobníka
+ *      ' ' ... syntaktická chyba
+ *
+ * Asociativita je súčasťou tabuľky: * / + - sú ľavo asociatívne, ?? je pravo asociatívny
+ * a relačné operátory nie je možné reťaziť.
+ *
+ * @brief Precedenčná tabuľka, zhodná s doc/precedence_table.png
+**/
+static const char prec_table[PT_COUNT][PT_COUNT] = {
+    //            !    * /  + -  id   rel  ??   (    )
+    [PT_EXCL]    = {' ', '>', '>', ' ', '>', '>', ' ', '>'},
+    [PT_MUL]     = {'<', '>', '>', '<', '>', '>', '<', '>'},
+    [PT_ADD]     = {'<', '<', '>', '<', '>', '>', '<', '>'},
+    [PT_ID]      = {'>', '>', '>', ' ', '>', '>', ' ', '>'},
+    [PT_REL]     = {'<', '<', '<', '<', ' ', '>', '<', '>'},
+    [PT_NILTEST] = {'<', '<', '<', '<', '<', '<', '<', '>'},
+    [PT_BRT_L]   = {'<', '<', '<', '<', '<', '<', '<', '='},
+    [PT_BRT_R]   = {'>', '>', '>', ' ', '>', '>', ' ', '>'},
+};
 
 /**
  * @brief Overuje, či sa typ tokenu môže vyskytovať vo výraze.
@@ -259,74 +330,633 @@ void int2double(ptoken_T *var_a, ptoken_T *var_b){
  * Inak indikuje koniec výrazu.
  * @returns true ak token môže byť súčasťou výrazu, inak false
 **/
-bool valid_token_type(int type){
-    if (type == INVALID || type == INT_TYPE || type == DOUBLE_TYPE || type == ELSE ||
-        type == STRING_TYPE || type == INT_NIL_YPE || type == DOUBLE_NIL_TYPE ||
-        type == STRING_NIL_TYPE || type == VAR || type == LET || type == IF ||
-        type == WHILE || type == FUNC || type == RETURN || type == BRT_CUR_R ||
-        type == UNDERSCORE || type == ARROW || type == ASSIGN || type == BRT_CUR_L ||
-        type == QUEST_MARK || type == COMMA || type == COLON || type == EOF_TKN) {
-        return false;
-    }
-    else{
-        return true; // Token môže byť časťou výrazu
-    }
+static inline bool valid_token_type(int type){
+    return type >= 0 && type <= EOF_TKN && (token_info[type].flags & TC_EXPR);
 }
 
 /**
  * @brief Overuje, či je token operand.
  * @returns true ak je operand, inak false
 **/
-bool is_operand(int type){
-    if(type == ID || type == INT_CONST || type == DOUBLE_CONST ||
-    type == STRING_CONST || type == NIL){
-        return true;
-    }
-    else{
-        return false;
-    }
+static inline bool is_operand(int type){
+    return type >= 0 && type <= EOF_TKN && (token_info[type].flags & TC_OPERAND);
 }
 
 /**
  * @brief Overuje, či je token binárny operátor.
  * @returns true ak je operátor, inak false
- * @note Operátor "minus" je v tejto implementácii len binárny
 **/
-bool is_binary_operator(int type){
-    if (type == OP_PLUS || type == OP_MUL || type == OP_DIV || type == OP_MINUS ||
-        type == ASSIGN || type == EQ || type == NEQ || type == GTEQ ||
-        type == LT || type == LTEQ || type == TEST_NIL || type == GT) {
-        return true;
-    }
-    else{
-        return false;
-    }
+static inline bool is_binary_operator(int type){
+    return type >= 0 && type <= EOF_TKN && (token_info[type].flags & TC_BINARY);
 }
 
 /**
  * @brief Overuje, či je token aritmetický operátor.
  * @returns true ak je aritmetický operátor, inak false
 **/
-bool is_arithmetic_operator(int operator){
-    if(operator == OP_PLUS || operator == OP_MUL || 
-    operator == OP_DIV || operator == OP_MINUS){
+static inline bool is_arithmetic_operator(int type){
+    return type >= 0 && type <= EOF_TKN && (token_info[type].flags & TC_ARITH);
+}
+
+/**
+ * @brief Overuje, či je token relačný (logický) operátor.
+ * @returns true ak je relačný operátor, inak false
+**/
+static inline bool is_logical_operator(int type){
+    return type >= 0 && type <= EOF_TKN && (token_info[type].flags & TC_REL);
+}
+
+/**
+ * @brief Vráti vzťah medzi terminálom na vrchole zásobníka a vstupným terminálom
+ * @returns jeden zo znakov '<', '>', '=', ' ' (viď prec_table)
+**/
+static inline char prec_relation(int top, int input){
+    return prec_table[token_info[top].term][token_info[input].term];
+}
+
+/**************************************************************************************************
+* Strom výrazu
+**************************************************************************************************/
+
+/** Typ uzlu stromu výrazu pre implicitnú konverziu int na double. Musí byť rôzny od hodnôt token_ids. */
+#define EXP_INT2FLOAT -60
+
+/**
+ * Listy stromu sú operandy (op je ID, INT_CONST, DOUBLE_CONST, STRING_CONST, NIL alebo BOOL_CONST),
+ * vnútorné uzly sú binárne operátory (op je typ tokenu operátora) alebo konverzia EXP_INT2FLOAT,
+ * ktorá má iba ľavý operand.
+ * @brief Uzol stromu výrazu, medzikód výrazu pred vygenerovaním cieľového kódu
+*/
+typedef struct exp_node
+{
+    int op;                 // typ uzlu
+    char st_type;           // dátový typ hodnoty uzlu, používa hodnoty SYM_TYPE_XXX
+    str_T codename;         // identifikátor/konštanta v cieľovom kóde, len pre listy
+    struct exp_node *left;  // ľavý operand
+    struct exp_node *right; // pravý operand
+} exp_node_T;
+
+/**
+ * @brief Zoznam všetkých uzlov stromu výrazu, uvoľňujú sa naraz po vygenerovaní kódu výrazu
+*/
+typedef struct node_pool
+{
+    int size;               // Počet uzlov
+    int capacity;           // Kapacita poľa
+    exp_node_T **array;     // Dynamické pole ukazateľov na uzly
+} node_pool_T;
+
+/**
+ * @brief Inicializuje prázdny zoznam uzlov
+*/
+static void pool_init(node_pool_T *pool){
+    pool->size = pool->capacity = 0;
+    pool->array = NULL;
+}
+
+/**
+ * @brief Uvoľní všetky uzly v zozname a zoznam samotný
+*/
+static void pool_dispose(node_pool_T *pool){
+    for(int i = 0; i < pool->size; i++){
+        StrDestroy(&(pool->array[i]->codename));
+        memFree(MEM_EXPRESSION, pool->array[i]);
+    }
+    memFree(MEM_EXPRESSION, pool->array);
+    pool_init(pool);
+}
+
+/**
+ * @brief Vytvorí nový uzol stromu výrazu a zaradí ho do zoznamu uzlov
+ * @param codename identifikátor v cieľovom kóde pre list, inak NULL
+ * @note Pri zlyhaní alokácie ukončí program, rovnako ako generátor kódu
+*/
+static exp_node_T *node_new(node_pool_T *pool, int op, char st_type, char *codename, exp_node_T *left, exp_node_T *right){
+    if(pool->size == pool->capacity){ // Zoznam je plný
+        pool->capacity = (pool->capacity == 0) ? 16 : pool->capacity*2;
+        pool->array = memRealloc(MEM_EXPRESSION, pool->array, pool->capacity*sizeof(exp_node_T*));
+        if(pool->array == NULL){
+            fprintf(stderr, "memory reallocation error\n");
+            exit(COMPILER_ERROR);
+        }
+    }
+    exp_node_T *node = memAlloc(MEM_EXPRESSION, sizeof(exp_node_T));
+    if(node == NULL){
+        fprintf(stderr, "memory allocation error\n");
+        exit(COMPILER_ERROR);
+    }
+    node->op = op;
+    node->st_type = st_type;
+    StrInit(&(node->codename));
+    if(codename != NULL){
+        StrFillWith(&(node->codename), codename);
+    }
+    node->left = left;
+    node->right = right;
+    pool->array[pool->size++] = node;
+    return node;
+}
+
+/**
+ * @brief Overuje, či je uzol list (operand)
+*/
+static inline bool node_is_leaf(exp_node_T *node){
+    return node->left == NULL && node->right == NULL;
+}
+
+/**
+ * @brief Vráti hodnotu int konštanty z listu typu INT_CONST
+*/
+static long long node_int(exp_node_T *node){
+    return strtoll(StrRead(&(node->codename)) + strlen("int@"), NULL, 10);
+}
+
+/**
+ * @brief Vráti hodnotu double konštanty z listu typu DOUBLE_CONST
+*/
+static double node_double(exp_node_T *node){
+    return strtod(StrRead(&(node->codename)) + strlen("float@"), NULL);
+}
+
+/**
+ * @brief Vytvorí list s int konštantou
+*/
+static exp_node_T *node_int_const(node_pool_T *pool, long long value){
+    char codename[32];
+    sprintf(codename, "int@%lld", value);
+    return node_new(pool, INT_CONST, 'i', codename, NULL, NULL);
+}
+
+/**
+ * @brief Vytvorí list s double konštantou
+*/
+static exp_node_T *node_double_const(node_pool_T *pool, double value){
+    char codename[64];
+    sprintf(codename, "float@%a", value);
+    return node_new(pool, DOUBLE_CONST, 'd', codename, NULL, NULL);
+}
+
+/**
+ * @brief Vytvorí list s bool konštantou
+*/
+static exp_node_T *node_bool_const(node_pool_T *pool, bool value){
+    return node_new(pool, BOOL_CONST, 'b', value ? "bool@true" : "bool@false", NULL, NULL);
+}
+
+/**
+ * @brief Overuje, či sú oba uzly tá istá premenná
+*/
+static bool node_same_var(exp_node_T *a, exp_node_T *b){
+    return a->op == ID && b->op == ID && strcmp(StrRead(&(a->codename)), StrRead(&(b->codename))) == 0;
+}
+
+/**
+ * Premenná let inicializovaná konštantou má v cieľovom kóde priamo hodnotu konštanty
+ * (parser.c, propagateLetConstant), v strome výrazu sa s ňou preto pracuje ako s konštantou.
+ * @brief Určí druh listu stromu výrazu pre operand
+*/
+static int leaf_op(ptoken_T *token){
+    if(token->type == ID){
+        char *codename = StrRead(&(token->codename));
+        if(strncmp(codename, "int@", strlen("int@")) == 0) return INT_CONST;
+        if(strncmp(codename, "float@", strlen("float@")) == 0) return DOUBLE_CONST;
+        if(strncmp(codename, "string@", strlen("string@")) == 0) return STRING_CONST;
+    }
+    return token->type;
+}
+
+/**
+ * @brief Vyhodnotí aritmetickú operáciu nad int konštantami tak, ako by ju vykonal interpret
+ * @returns false ak by operácia pretiekla alebo delila nulou, výraz sa potom nevyhodnotí
+*/
+static bool fold_int(int op, long long a, long long b, long long *result){
+    switch(op){
+    case OP_PLUS:
+        return !__builtin_add_overflow(a, b, result);
+    case OP_MINUS:
+        return !__builtin_sub_overflow(a, b, result);
+    case OP_MUL:
+        return !__builtin_mul_overflow(a, b, result);
+    case OP_DIV:
+        if(b == 0 || (a == LLONG_MIN && b == -1)){
+            return false;
+        }
+        *result = a / b;
         return true;
     }
-    else{
+    return false;
+}
+
+/**
+ * @brief Vyhodnotí aritmetickú operáciu nad double konštantami
+ * @returns false ak výsledok nie je konečné číslo alebo sa delí nulou
+*/
+static bool fold_double(int op, double a, double b, double *result){
+    switch(op){
+    case OP_PLUS:
+        *result = a + b;
+        break;
+    case OP_MINUS:
+        *result = a - b;
+        break;
+    case OP_MUL:
+        *result = a * b;
+        break;
+    case OP_DIV:
+        if(b == 0.0){
+            return false;
+        }
+        *result = a / b;
+        break;
+    default:
         return false;
     }
+    return isfinite(*result);
 }
+
 /**
- * @brief Overuje, či je token logický operátor.
- * @returns true ak je aritmetický operátor, inak false
-**/
-bool is_logical_operator(int operator){
-    if(operator == EQ || operator == NEQ || operator == GTEQ ||
-        operator == LT || operator == LTEQ || operator == GT){
-            return true;
+ * @brief Vyhodnotí relačný operátor podľa výsledku porovnania
+ * @param cmp záporné číslo ak a < b, 0 ak a == b, kladné číslo ak a > b
+*/
+static bool rel_holds(int op, int cmp){
+    switch(op){
+    case EQ:   return cmp == 0;
+    case NEQ:  return cmp != 0;
+    case LT:   return cmp < 0;
+    case GT:   return cmp > 0;
+    case LTEQ: return cmp <= 0;
+    case GTEQ: return cmp >= 0;
+    }
+    return false;
+}
+
+/**
+ * Pravidlá (x je ľubovoľný podvýraz, c konštanta):
+ *      c1 op c2 => c,  c + x => x + c,  c * x => x * c,  x - c => x + (-c)
+ *      (x + c1) + c2 => x + (c1 + c2),  (x * c1) * c2 => x * (c1 * c2)
+ *      x + 0 => x,  x * 1 => x,  x / 1 => x,  x * 0 => 0 (list),  x - x => 0 (premenná)
+ *      x * 2 => x + x (premenná)
+ * @brief Zjednoduší aritmetický uzol nad typom Int
+*/
+static exp_node_T *simplify_int(node_pool_T *pool, exp_node_T *node){
+    exp_node_T *left = node->left, *right = node->right;
+    long long result;
+
+    if(left->op == INT_CONST && right->op == INT_CONST){ // Oba operandy sú konštanty
+        if(fold_int(node->op, node_int(left), node_int(right), &result)){
+            return node_int_const(pool, result);
+        }
+        return node;
+    }
+    if(node_same_var(left, right) && node->op == OP_MINUS){
+        return node_int_const(pool, 0);
+    }
+    if((node->op == OP_PLUS || node->op == OP_MUL) && left->op == INT_CONST){ // Konštanta sa presunie doprava
+        node->left = right;
+        node->right = left;
+        left = node->left;
+        right = node->right;
+    }
+    if(right->op != INT_CONST){
+        return node;
+    }
+    long long c = node_int(right);
+    if(node->op == OP_MINUS && c != LLONG_MIN){ // Odčítanie konštanty je pričítanie opačnej konštanty
+        node->op = OP_PLUS;
+        node->right = right = node_int_const(pool, -c);
+        c = -c;
+    }
+    if((node->op == OP_PLUS || node->op == OP_MUL) && left->op == node->op && left->right->op == INT_CONST){
+        if(fold_int(node->op, node_int(left->right), c, &result)){ // Spojenie konštánt pri asociatívnej operácii
+            node->left = left = left->left;
+            node->right = right = node_int_const(pool, result);
+            c = result;
+        }
+    }
+    switch(node->op){
+    case OP_PLUS:
+        return (c == 0) ? left : node;
+    case OP_MUL:
+        if(c == 0 && node_is_leaf(left)) return node_int_const(pool, 0); // Podvýraz môže skončiť chybou (delenie nulou)
+        if(c == 1) return left;
+        if(c == 2 && left->op == ID){ // Sčítanie je lacnejšie ako násobenie
+            return node_new(pool, OP_PLUS, 'i', NULL, left, left);
+        }
+        return node;
+    case OP_DIV:
+        return (c == 1) ? left : node;
+    }
+    return node;
+}
+
+/**
+ * Pravidlá sú len tie, ktoré zachovávajú výsledok pre všetky hodnoty vrátane -0.0 a nekonečna:
+ *      c1 op c2 => c,  c + x => x + c,  c * x => x * c
+ *      x - 0.0 => x,  x * 1.0 => x,  x / 1.0 => x,  x * 2.0 => x + x (premenná)
+ * @brief Zjednoduší aritmetický uzol nad typom Double
+*/
+static exp_node_T *simplify_double(node_pool_T *pool, exp_node_T *node){
+    exp_node_T *left = node->left, *right = node->right;
+    double result;
+
+    if(left->op == DOUBLE_CONST && right->op == DOUBLE_CONST){ // Oba operandy sú konštanty
+        if(fold_double(node->op, node_double(left), node_double(right), &result)){
+            return node_double_const(pool, result);
+        }
+        return node;
+    }
+    if((node->op == OP_PLUS || node->op == OP_MUL) && left->op == DOUBLE_CONST){ // Konštanta sa presunie doprava
+        node->left = right;
+        node->right = left;
+        left = node->left;
+        right = node->right;
+    }
+    if(right->op != DOUBLE_CONST){
+        return node;
+    }
+    double c = node_double(right);
+    switch(node->op){
+    case OP_MINUS:
+        return (c == 0.0 && !signbit(c)) ? left : node;
+    case OP_MUL:
+        if(c == 1.0) return left;
+        if(c == 2.0 && left->op == ID){ // Sčítanie je lacnejšie ako násobenie
+            return node_new(pool, OP_PLUS, 'd', NULL, left, left);
+        }
+        return node;
+    case OP_DIV:
+        return (c == 1.0) ? left : node;
+    }
+    return node;
+}
+
+/**
+ * @brief Zjednoduší konkatenáciu reťazcov: spojí konštanty a vynechá prázdny reťazec
+*/
+static exp_node_T *simplify_concat(node_pool_T *pool, exp_node_T *node){
+    exp_node_T *left = node->left, *right = node->right;
+
+    if(left->op == STRING_CONST && right->op == STRING_CONST){ // Zakódované reťazce je možné spojiť priamo
+        exp_node_T *folded = node_new(pool, STRING_CONST, 's', StrRead(&(left->codename)), NULL, NULL);
+        StrCatString(&(folded->codename), StrRead(&(right->codename)) + strlen("string@"));
+        return folded;
+    }
+    if(right->op == STRING_CONST && strcmp(StrRead(&(right->codename)), "string@") == 0){
+        return left;
+    }
+    if(left->op == STRING_CONST && strcmp(StrRead(&(left->codename)), "string@") == 0){
+        return right;
+    }
+    return node;
+}
+
+/**
+ * @brief Vyhodnotí relačný operátor nad konštantami
+*/
+static exp_node_T *simplify_rel(node_pool_T *pool, exp_node_T *node){
+    exp_node_T *left = node->left, *right = node->right;
+
+    if(left->op == INT_CONST && right->op == INT_CONST){
+        long long a = node_int(left), b = node_int(right);
+        return node_bool_const(pool, rel_holds(node->op, (a > b) - (a < b)));
+    }
+    if(left->op == DOUBLE_CONST && right->op == DOUBLE_CONST){
+        double a = node_double(left), b = node_double(right);
+        return node_bool_const(pool, rel_holds(node->op, (a > b) - (a < b)));
+    }
+    if((node->op == EQ || node->op == NEQ) && left->op == right->op &&
+    (left->op == STRING_CONST || left->op == NIL || left->op == BOOL_CONST))
+    { // Kódovanie konštánt je jednoznačné, rovnosť je možné určiť porovnaním kódu
+        int cmp = strcmp(StrRead(&(left->codename)), StrRead(&(right->codename)));
+        return node_bool_const(pool, rel_holds(node->op, cmp));
+    }
+    return node;
+}
+
+/**
+ * @brief Zjednoduší strom výrazu zdola nahor podľa pravidiel so zachovaním sémantiky IFJ23
+ * @returns koreň zjednodušeného stromu
+*/
+static exp_node_T *simplify(node_pool_T *pool, exp_node_T *node){
+    if(node->left != NULL){
+        node->left = simplify(pool, node->left);
+    }
+    if(node->right != NULL){
+        node->right = simplify(pool, node->right);
+    }
+
+    switch(node->op){
+    case EXP_INT2FLOAT:
+        if(node->left->op == INT_CONST){ // Konverzia konštanty počas prekladu
+            return node_double_const(pool, (double)node_int(node->left));
+        }
+        return node;
+    case OP_PLUS:
+    case OP_MINUS:
+    case OP_MUL:
+    case OP_DIV:
+        switch(node->st_type){
+        case 'i': return simplify_int(pool, node);
+        case 'd': return simplify_double(pool, node);
+        case 's': return simplify_concat(pool, node);
         }
+        return node;
+    case EQ:
+    case NEQ:
+    case LT:
+    case GT:
+    case LTEQ:
+    case GTEQ:
+        return simplify_rel(pool, node);
+    }
+    return node;
+}
+
+/**
+ * @brief Vráti trojadresnú inštrukciu pre binárny uzol, zásobníková verzia má navyše príponu "S"
+*/
+static char *node_instruction(exp_node_T *node){
+    switch(node->op){
+    case OP_PLUS:   return (node->st_type == 's') ? "CONCAT" : "ADD";
+    case OP_MINUS:  return "SUB";
+    case OP_MUL:    return "MUL";
+    case OP_DIV:    return (node->st_type == 'i') ? "IDIV" : "DIV";
+    case EQ:
+    case NEQ:       return "EQ";
+    case LT:
+    case GTEQ:      return "LT";
+    case GT:
+    case LTEQ:      return "GT";
+    }
+    return NULL;
+}
+
+/**
+ * @brief Overuje, či je výsledok inštrukcie z node_instruction potrebné znegovať (!=, <=, >=)
+*/
+static inline bool node_negated(exp_node_T *node){
+    return node->op == NEQ || node->op == LTEQ || node->op == GTEQ;
+}
+
+static void emit_node(ctx_T *ctx, exp_node_T *node);
+
+/**
+ * @brief Vygeneruje kód pre "a ?? b", operand b sa vyhodnotí len ak je a nil
+*/
+static void emit_test_nil(ctx_T *ctx, exp_node_T *node){
+    str_T label1, label2;
+    StrInit(&label1);
+    StrInit(&label2);
+    // počítadlo náveští je vlastné pre každú funkciu, náveštie preto obsahuje aj jej názov
+    char *fn = ctx->gen.code_fns.current != -1 ? ctx->gen.code_fns.array[ctx->gen.code_fns.current].name : "";
+    genUniqLabel(&ctx->gen, fn,"testnil_l1",&label1); // Vygenerovanie labelu pre podmienený skok
+    genUniqLabel(&ctx->gen, fn,"testnil_l2",&label2); // Vygenerovanie labelu pre podmienený skok
+
+    char *value = "GF@!tmp1";
+    if(node_is_leaf(node->left)){
+        value = StrRead(&(node->left->codename));
+    }
     else{
-        return false;
+        emit_node(ctx, node->left);
+        genCode(&ctx->gen, "POPS", value, NULL, NULL); // Popnutie possible-nil hodnoty do pomocnej premennej
+    }
+    genCode(&ctx->gen, "JUMPIFEQ", StrRead(&label1), value, "nil@nil"); // Ak je prvá hodnota nil, skok na náveštie 1
+    genCode(&ctx->gen, "PUSHS", value, NULL, NULL);    // Prvá hodnota nie je nil, je výsledkom
+    genCode(&ctx->gen, "JUMP", StrRead(&label2), NULL, NULL);
+    genCode(&ctx->gen, "LABEL", StrRead(&label1), NULL, NULL);
+    emit_node(ctx, node->right);                 // Prvá hodnota je nil, výsledkom je druhý operand
+    genCode(&ctx->gen, "LABEL", StrRead(&label2), NULL, NULL);
+
+    StrDestroy(&label1);
+    StrDestroy(&label2);
+}
+
+/**
+ * @brief Vygeneruje kód pre konkatenáciu, CONCAT nemá zásobníkovú verziu
+*/
+static void emit_concat(ctx_T *ctx, exp_node_T *node){
+    char *a = "GF@!tmp1", *b = "GF@!tmp2";
+
+    if(node_is_leaf(node->left)) a = StrRead(&(node->left->codename));
+    else emit_node(ctx, node->left);
+    if(node_is_leaf(node->right)) b = StrRead(&(node->right->codename));
+    else emit_node(ctx, node->right);
+
+    if(!node_is_leaf(node->right)) genCode(&ctx->gen, "POPS", b, NULL, NULL);
+    if(!node_is_leaf(node->left)) genCode(&ctx->gen, "POPS", a, NULL, NULL);
+    genCode(&ctx->gen, "CONCAT", "GF@!tmp1", a, b);
+    genCode(&ctx->gen, "PUSHS", "GF@!tmp1", NULL, NULL);
+}
+
+/**
+ * Ak sú oba operandy listy, použije sa trojadresná inštrukcia s pomocnou premennou,
+ * čo ušetrí jednu inštrukciu oproti dvom PUSHS a zásobníkovej inštrukcii.
+ * @brief Vygeneruje kód, ktorý vloží hodnotu uzlu na vrchol zásobníka
+*/
+static void emit_node(ctx_T *ctx, exp_node_T *node){
+    if(node_is_leaf(node)){
+        genCode(&ctx->gen, "PUSHS", StrRead(&(node->codename)), NULL, NULL);
+        return;
+    }
+    if(node->op == EXP_INT2FLOAT){
+        emit_node(ctx, node->left);
+        genCode(&ctx->gen, "INT2FLOATS", NULL, NULL, NULL);
+        return;
+    }
+    if(node->op == TEST_NIL){
+        emit_test_nil(ctx, node);
+        return;
+    }
+    if(node->op == OP_PLUS && node->st_type == 's'){
+        emit_concat(ctx, node);
+        return;
+    }
+
+    if(node_is_leaf(node->left) && node_is_leaf(node->right)){ // Trojadresný kód
+        genCode(&ctx->gen, node_instruction(node), "GF@!tmp1", StrRead(&(node->left->codename)), StrRead(&(node->right->codename)));
+        if(node_negated(node)){
+            genCode(&ctx->gen, "NOT", "GF@!tmp1", "GF@!tmp1", NULL);
+        }
+        genCode(&ctx->gen, "PUSHS", "GF@!tmp1", NULL, NULL);
+        return;
+    }
+
+    char instruction[16];
+    sprintf(instruction, "%sS", node_instruction(node));
+    emit_node(ctx, node->left);
+    emit_node(ctx, node->right);
+    genCode(&ctx->gen, instruction, NULL, NULL, NULL);
+    if(node_negated(node)){
+        genCode(&ctx->gen, "NOTS", NULL, NULL, NULL);
+    }
+}
+
+/**
+ * @brief Vygeneruje podmienený skok na false_label, ktorý sa vykoná ak je hodnota uzlu false
+ * @details Výsledok porovnania sa neukladá na zásobník, ale rovno sa podľa neho skáče
+*/
+static void emit_cond_jump(ctx_T *ctx, exp_node_T *node, char *false_label){
+    if(node->op == BOOL_CONST){ // Podmienka je známa počas prekladu
+        if(strcmp(StrRead(&(node->codename)), "bool@false") == 0){
+            genCode(&ctx->gen, "JUMP", false_label, NULL, NULL);
+        }
+        return;
+    }
+
+    bool leaves = !node_is_leaf(node) && node->right != NULL &&
+        node_is_leaf(node->left) && node_is_leaf(node->right);
+    char *a = leaves ? StrRead(&(node->left->codename)) : NULL;
+    char *b = leaves ? StrRead(&(node->right->codename)) : NULL;
+
+    switch(node->op){
+    case EQ:
+    case NEQ:;
+        char *jump = (node->op == EQ) ? "JUMPIFNEQ" : "JUMPIFEQ"; // Skok pri opačnom výsledku
+        if(leaves){
+            genCode(&ctx->gen, jump, false_label, a, b);
+        }
+        else{
+            char instruction[16];
+            sprintf(instruction, "%sS", jump);
+            emit_node(ctx, node->left);
+            emit_node(ctx, node->right);
+            genCode(&ctx->gen, instruction, false_label, NULL, NULL);
+        }
+        return;
+    case LT:
+    case GT:
+    case LTEQ:
+    case GTEQ:; // Negácia sa premietne do porovnávanej hodnoty namiesto inštrukcie NOT
+        char *if_false = node_negated(node) ? "bool@true" : "bool@false";
+        if(leaves){
+            genCode(&ctx->gen, node_instruction(node), "GF@!tmp1", a, b);
+            genCode(&ctx->gen, "JUMPIFEQ", false_label, "GF@!tmp1", if_false);
+        }
+        else{
+            char instruction[16];
+            sprintf(instruction, "%sS", node_instruction(node));
+            emit_node(ctx, node->left);
+            emit_node(ctx, node->right);
+            genCode(&ctx->gen, instruction, NULL, NULL, NULL);
+            genCode(&ctx->gen, "PUSHS", if_false, NULL, NULL);
+            genCode(&ctx->gen, "JUMPIFEQS", false_label, NULL, NULL);
+        }
+        return;
+    }
+
+    emit_node(ctx, node);
+    genCode(&ctx->gen, "PUSHS", "bool@false", NULL, NULL);
+    genCode(&ctx->gen, "JUMPIFEQS", false_label, NULL, NULL);
+}
+
+/**
+ * Konvertuje sa len int literál (alebo výraz zložený z int literálov) typu Int,
+ * výsledok zmiešanej operácie je už typu Double.
+ * @brief Obalí podstrom operandu implicitnou konverziou int na double
+**/
+static void int2double(node_pool_T *pool, ptoken_T *var){
+    if(var->type == INT_CONST && var->st_type == 'i'){
+        var->node = node_new(pool, EXP_INT2FLOAT, 'd', NULL, var->node, NULL);
     }
 }
 
@@ -334,7 +964,7 @@ bool is_logical_operator(int operator){
  * @brief Overuje, či sú dátové typy operandov kompatibilné pre logické operácie
  * @returns true ak sú kompatibilné, inak false
 **/
-bool are_compatible_l(ptoken_T *op1, ptoken_T *op2){
+bool are_compatible_l(ptoken_T *op1, ptoken_T *op2, node_pool_T *pool){
 
     if(op1->st_type == 'b'){ // Bool
         return (op2->st_type == 'b');
@@ -345,14 +975,14 @@ bool are_compatible_l(ptoken_T *op1, ptoken_T *op2){
     if(op1->type == INT_CONST) // Integer konštanta - môže byť pretypovaná na double
     {
         if(op2->st_type == 'd' || op2->type == DOUBLE_CONST){ // Ak je druhý operand double
-            int2double(op1, op2); // Vygenerovanie kódu pre konverziu na double
+            int2double(pool, op1); // Konverzia na double
         }
         return (op2->type == INT_CONST || op2->st_type == 'i' || op2->st_type == 'd' || op2->type == DOUBLE_CONST);
     }
     if(op1->type == DOUBLE_CONST || op1->st_type == 'd') // Double
     {
         if(op2->type == INT_CONST){ // Druhý operand je int konštanta
-            int2double(op1, op2);   // Vygenerovanie kódu pre konverziu na double
+            int2double(pool, op2);  // Konverzia na double
         }
         return (op2->type == DOUBLE_CONST || op2->st_type == 'd' || op2->type == INT_CONST); // Druhý op môže byť pretypovaný na double
     }
@@ -400,48 +1030,6 @@ bool is_nil_type(ptoken_T *op){
     op->st_type == 'S' || op->st_type == 'N');
 }
 
-/**
- * @brief Porovná prioritu operátorov
- * @returns true ak má type väčšiu prioritu ako top, inak false
-**/
-bool priority_cmp(int type, int top){
-    if(type == EXCL){ // !
-        type = 0;
-    }
-    if(top == EXCL){ // !
-        top = 0;
-    }
-    if(type == OP_MUL || type == OP_DIV){ // * /
-        type = 1;
-    }
-    if(top == OP_MUL || top == OP_DIV){ // * /
-        top = 1;
-    }
-    if(type == OP_PLUS || type == OP_MINUS){ // + -
-        type = 2;
-    }
-    if(top == OP_PLUS || top == OP_MINUS){ // + -
-        top = 2;
-    }
-    if(type > 29 && type < 36){ // == != < > <= >= 
-        type = 3;
-    }
-    if(top > 29 && top < 36){ // == != < > <= >= 
-        top = 3;
-    }
-    if(type == TEST_NIL){ // ??
-        type = 4;
-    }
-    if(top == TEST_NIL){ // ??
-        top = 4;
-    }
-
-    if(top > type){ // Operátor na vrchole zásobníka má menšiu prioritu ako operátor type
-        return true;
-    }
-    return false; // Operátor na vrchole zásobníka má väčšiu prioritu ako operátor type
-}
-
 /**************************************************************************************************
  *Ostatné funkcie
 **************************************************************************************************/
@@ -469,7 +1057,7 @@ void endParse_sem(stack_t *stack, stack_t *postfixExpr){
  * @details Volaná počas syntaktickej analýzy výrazu pri každom tokene
  * @returns 0 ak prebehlo vloženie tokenu úspešne, inak chybový kód
 **/
-int infix2postfix(stack_t *stack, stack_t *postfixExpr, token_T *infix_token){
+int infix2postfix(ctx_T *ctx, stack_t *stack, stack_t *postfixExpr, token_T *infix_token){
     
     int status = 0; // Pomocná premenná pre uloženie návratového kódu funkcií
 
@@ -486,66 +1074,39 @@ int infix2postfix(stack_t *stack, stack_t *postfixExpr, token_T *infix_token){
 
 		return 0;
 	}
-    if(infix_token->type == BRT_RND_L || infix_token->type == EXCL) // Ľavá zátvorka alebo "!"
-	{
-		return stack_push_token(stack, infix_token); // Vkladáme na zásobník
-	}
-	if(infix_token->type == BRT_RND_R) // Pravá zátvorka
-	{
-		while(true) // Pokým nenájdeme ľavú zátvorku
-	    {
-		    if(stack->size == 0){ // Ukončenie funkcie pri prázdnom zásobníku
-		    	return 0;
-		    }
-
-		    if(stack_top(stack)->type == BRT_RND_L) // Ľavá zátvorka bola nájdená
-		    {
-		    	stack_pop_destroy(stack); // Odstránenie zátvorky zo zásobníku a z pamäte
-		    	return 0;
-		    }
-		    else
-		    {
-		    	status = stack_push_ptoken(postfixExpr, stack_top(stack)); // Pridanie znaku zo zásobníku do výrazu
-                if(status != 0){ 
-                    return status; 
-                }
-		    	stack_pop(stack); // Odstránenie znaku zo zásobníku
-		    }
-	    }
-		return 0;
-	}
-	
-	if(is_binary_operator(infix_token->type))
-	{
-		while (true) // Opakovanie odstraňovania operátorov zo zásobníka až dokým nebude možné vložiť znak c na zásobník
-		{
-			if(stack->size == 0){// Zásobník je prázdny
-				return stack_push_token(stack, infix_token); // Vloženie znaku na zásobník, koniec funkcie
-			}
-			else // Zásobník nie je prázdny
-			{
-                // Na vrchole zásobníka je ľavá zátvorka alebo operátor s nižšou prioritou ako infix_token
-				if(stack_top(stack)->type == BRT_RND_L || priority_cmp(infix_token->type, stack_top(stack)->type))
-                { 
-					return stack_push_token(stack, infix_token); // Vloženie znaku na zásobník, koniec funkcie
-				}
-				else
-                {
-					status = stack_push_ptoken(postfixExpr, stack_top(stack)); // Vloženie operátoru s rovnakou/vyššou prioritou na koniec postfix výrazu
-                    if(status != 0){ 
-                        return status;
-                    }
-					stack_pop(stack); 
-				}
-			}
-	    }
-	}
+    if(is_operand(infix_token->type)) // Operand
+    {
+        return stack_push_token(ctx, postfixExpr, infix_token); // Vloženie operandu do postfixového výrazu, koniec funkcie
+    }
 
-	else // Žiadna predošlá podmienka nebola splnená => znak musí byť operand
-	{
-		return stack_push_token(postfixExpr, infix_token); // Vloženie operandu do postfixového výrazu, koniec funkcie
-	}
-    return 0;
+    // Operátor alebo zátvorka, ďalší postup určuje precedenčná tabuľka
+    while(stack->size > 0)
+    {
+        switch(prec_relation(stack_top(stack)->type, infix_token->type))
+        {
+        case '<': // Operátor na vrchole zásobníka má nižšiu prioritu
+            return stack_push_token(ctx, stack, infix_token); // Vloženie znaku na zásobník, koniec funkcie
+        case '=': // Pravá zátvorka uzatvára ľavú zátvorku na vrchole zásobníka
+            stack_pop_destroy(stack); // Odstránenie zátvorky zo zásobníku a z pamäte
+            return 0;
+        case '>': // Operátor na vrchole zásobníka má vyššiu alebo rovnakú prioritu
+            status = stack_push_ptoken(postfixExpr, stack_top(stack)); // Presun operátoru do postfix výrazu
+            if(status != 0){
+                return status;
+            }
+            stack_pop(stack);
+            break;
+        default: // Operátory nemôžu nasledovať po sebe, napr. reťazenie relačných operátorov
+            logErrCodeAnalysis(&ctx->log, SYN_ERR, infix_token->ln, infix_token->col, "operator '%s' cannot follow '%s'",
+                StrRead(&(infix_token->atr)), StrRead(&(stack_top(stack)->id)));
+            return SYN_ERR;
+        }
+    }
+
+    if(infix_token->type == BRT_RND_R){ // Pravá zátvorka pri prázdnom zásobníku
+        return 0;
+    }
+    return stack_push_token(ctx, stack, infix_token); // Zásobník je prázdny, vloženie znaku na zásobník
 }
 
 /**
@@ -559,13 +1120,18 @@ void copy_data(ptoken_T *source, ptoken_T *destination){
     destination->id = source->id; 
     destination->ln = source->ln;
     destination->col = source->col;
+    destination->node = source->node;
 }
 
 /**************************************************************************************************
  *Hlavná funkcia
 **************************************************************************************************/
 
-int parseExpression(char* result_type, bool *literal) {
+/**
+ * @brief Spoločná implementácia parseExpression a parseCondition
+ * @param false_label NULL ak má byť výsledok na vrchole zásobníka, inak náveštie pre skok pri nepravdivom výsledku
+*/
+static int parseExpressionGen(ctx_T *ctx, char* result_type, bool *literal, char *false_label) {
 
     stack_t stack;              // Zásobník pre konverziu výrazu na postfixovú formu
     stack_t postfixExpr;        // Zásobník pre uloženie postfixového výrazu
@@ -582,52 +1148,52 @@ int parseExpression(char* result_type, bool *literal) {
 
     while(true) // Pokým sa nespracuje celý výraz
     {
-        if(!valid_token_type(tkn->type)) // Ak token nemôže patriť do výrazu 
+        if(!valid_token_type(ctx->tkn->type)) // Ak token nemôže patriť do výrazu 
         {
-            if(tkn->type == INVALID) // Token je typu INVALID
+            if(ctx->tkn->type == INVALID) // Token je typu INVALID
             {
                 endParse_syn(&stack, &postfixExpr); // Upratanie pred skončením funkcie
                 return LEX_ERR; // Lexikálna chyba
             }
             if(prevTokenType == NO_PREV){ // Token je prvý vo výraze
-                logErrCodeAnalysis(SYN_ERR, tkn->ln, tkn->col,"expression is empty");
+                logErrCodeAnalysis(&ctx->log, SYN_ERR, ctx->tkn->ln, ctx->tkn->col,"expression is empty");
                 break; // Výraz nie je valídny
             }
             else // Predpokladáme že token už nie je súčasťou výrazu => znamená to ukončenie výrazu
             {
                 if(is_binary_operator(prevTokenType)) // Predošlý token je binárny operátor
                 {
-                    logErrCodeAnalysis(SYN_ERR, tkn->ln, tkn->col,"binary operator expected a second operand");
+                    logErrCodeAnalysis(&ctx->log, SYN_ERR, ctx->tkn->ln, ctx->tkn->col,"binary operator expected a second operand");
                     prevTokenType = NO_PREV;
                     break; // Výraz nie je valídny
                 }
                 if(bracketCount != 0) // Vo výraze nie sú uzatvorené všetky zátvorky
                 {
-                    logErrCodeAnalysis(SYN_ERR, tkn->ln, tkn->col,"expression has unclosed brackets");
+                    logErrCodeAnalysis(&ctx->log, SYN_ERR, ctx->tkn->ln, ctx->tkn->col,"expression has unclosed brackets");
                     prevTokenType = NO_PREV;
                     break; // Výraz nie je valídny
                 }
-                if(infix2postfix(&stack, &postfixExpr, NULL) == COMPILER_ERROR){ // Ukončenie postfix výrazu
+                if(infix2postfix(ctx, &stack, &postfixExpr, NULL) == COMPILER_ERROR){ // Ukončenie postfix výrazu
                     endParse_syn(&stack, &postfixExpr); // Upratenie pred ukončením pri chybovom stave
                     return COMPILER_ERROR; // Nastala chyba pri malloc/realloc
                 }
-                saveToken();    // Vloženie tokenu späť do input streamu
+                saveToken(ctx);    // Vloženie tokenu späť do input streamu
                 break;          // Úspešný koniec syntaktickej analýzy výrazu
             }
         }
 
-        if(is_binary_operator(tkn->type)) // Binárny operátor
+        if(is_binary_operator(ctx->tkn->type)) // Binárny operátor
         {
             if(prevTokenType == NO_PREV || is_binary_operator(prevTokenType) || prevTokenType == BRT_RND_L) 
             { // Token je prvý vo výraze, je za binárnym operátorom alebo ľavou zátvorkou
 
-                logErrCodeAnalysis(SYN_ERR, tkn->ln, tkn->col,"binary operator has no operands");
+                logErrCodeAnalysis(&ctx->log, SYN_ERR, ctx->tkn->ln, ctx->tkn->col,"binary operator has no operands");
                 prevTokenType = NO_PREV;
                 break; // Výraz nie je valídny
             }
         }
 
-        if(is_operand(tkn->type)) // Operand
+        if(is_operand(ctx->tkn->type)) // Operand
         {
             if(prevTokenType != NO_PREV) // Operand nie je prvý token vo výraze
             {
@@ -635,27 +1201,27 @@ int parseExpression(char* result_type, bool *literal) {
                 {
                     if(bracketCount != 0) // Ak nie sú uzavreté všetky zátvorky
                     {
-                        logErrCodeAnalysis(SYN_ERR, tkn->ln, tkn->col,"expected an operator before operand");
+                        logErrCodeAnalysis(&ctx->log, SYN_ERR, ctx->tkn->ln, ctx->tkn->col,"expected an operator before operand");
                         prevTokenType = NO_PREV;
                         break; // Výraz nie je valídny
                     }
                     else
                     {
-                        if(infix2postfix(&stack, &postfixExpr, NULL) == COMPILER_ERROR){ // Signalizuje ukončenie postfix výrazu
+                        if(infix2postfix(ctx, &stack, &postfixExpr, NULL) == COMPILER_ERROR){ // Signalizuje ukončenie postfix výrazu
                             endParse_syn(&stack, &postfixExpr); // Upratenie pred ukončením
                             return COMPILER_ERROR; // Nastala chyba pri malloc/realloc
                         }
-                        saveToken(); // Vloženie tokenu späť do input streamu
+                        saveToken(ctx); // Vloženie tokenu späť do input streamu
                         break; // Úspešný koniec syntaktickej analýzy výrazu
                     }
                 }
             }
         }
-        if(tkn->type == BRT_RND_L) // Ľavá zátvorka
+        if(ctx->tkn->type == BRT_RND_L) // Ľavá zátvorka
         {
             if(prevTokenType != NO_PREV && !is_binary_operator(prevTokenType) && prevTokenType != BRT_RND_L) 
             { // Token nie je prvý vo výraze a predošlý token nie je binárny operátor
-                logErrCodeAnalysis(SYN_ERR, tkn->ln, tkn->col,"expected an operator before opening bracket");
+                logErrCodeAnalysis(&ctx->log, SYN_ERR, ctx->tkn->ln, ctx->tkn->col,"expected an operator before opening bracket");
                 prevTokenType = NO_PREV;
                 break; // Výraz nie je valídny
             }
@@ -663,18 +1229,18 @@ int parseExpression(char* result_type, bool *literal) {
             bracketCount ++; // Zvýšenie počtu otvorených ľavých zátvoriek
             }
         }
-        if(tkn->type == BRT_RND_R) // Pravá zátvorka
+        if(ctx->tkn->type == BRT_RND_R) // Pravá zátvorka
         {
             if(is_binary_operator(prevTokenType) || bracketCount == 0 || prevTokenType == BRT_RND_L) 
             { // Predošlý token je binárny operátor, ľavá zátvorka, alebo vo výraze nie je otvorená zátvorka
                 if(bracketCount == 0){
-                    logErrCodeAnalysis(SYN_ERR, tkn->ln, tkn->col,"expected an opened left bracket");
+                    logErrCodeAnalysis(&ctx->log, SYN_ERR, ctx->tkn->ln, ctx->tkn->col,"expected an opened left bracket");
                 }
                 if(prevTokenType == BRT_RND_L){
-                    logErrCodeAnalysis(SYN_ERR, tkn->ln, tkn->col,"brackets without an operand");
+                    logErrCodeAnalysis(&ctx->log, SYN_ERR, ctx->tkn->ln, ctx->tkn->col,"brackets without an operand");
                 }
                 if(is_binary_operator(prevTokenType)){
-                    logErrCodeAnalysis(SYN_ERR, tkn->ln, tkn->col,"expected an operand before right bracket");
+                    logErrCodeAnalysis(&ctx->log, SYN_ERR, ctx->tkn->ln, ctx->tkn->col,"expected an operand before right bracket");
                 }
                 prevTokenType = NO_PREV;
                 break; // Výraz nie je valídny
@@ -683,25 +1249,25 @@ int parseExpression(char* result_type, bool *literal) {
             bracketCount--; // Uzatvorenie páru zátvoriek
 
         }
-        if(tkn->type == EXCL) // Výkričník
+        if(ctx->tkn->type == EXCL) // Výkričník
         {
             if(!is_operand(prevTokenType) && prevTokenType != BRT_RND_R) // Predošlý token nie je operand alebo ")"
             {
-                logErrCodeAnalysis(SYN_ERR, tkn->ln, tkn->col,"expected an operand or right bracket before '!'");
+                logErrCodeAnalysis(&ctx->log, SYN_ERR, ctx->tkn->ln, ctx->tkn->col,"expected an operand or right bracket before '!'");
                 prevTokenType = NO_PREV;
                 break; // Výraz nie je valídny
             }
         }
 
-        status = infix2postfix(&stack, &postfixExpr, tkn); // Pridanie tokenu do postfix výrazu
+        status = infix2postfix(ctx, &stack, &postfixExpr, ctx->tkn); // Pridanie tokenu do postfix výrazu
         if(status != 0) // Pridanie tokenu do postfix výrazu nebolo úspešné
         {
             endParse_syn(&stack, &postfixExpr); // Upratenie pred ukončením
             return status;                      // Vrátenie chybového kódu            
         }
         
-        prevTokenType = tkn->type;      // Uloženie typu predošlého tokenu
-        status = nextToken();           // Požiadanie o ďalší token z výrazu
+        prevTokenType = ctx->tkn->type;      // Uloženie typu predošlého tokenu
+        status = nextToken(ctx);           // Požiadanie o ďalší token z výrazu
         if(status == COMPILER_ERROR){   // nextToken vrátil compiler error
             fprintf(stderr, "nextToken: memory allocation error\n");
             endParse_syn(&stack, &postfixExpr); // Upratanie pred skončením funkcie
@@ -723,22 +1289,27 @@ int parseExpression(char* result_type, bool *literal) {
 //=====================================Sémantická analýza=========================================/
 
     ptoken_T *var_a, *var_b; // Pomocné premenné pre sémantickú analýzu
+    node_pool_T pool;        // Uzly stromu výrazu, z ktorého sa generuje cieľový kód
+    pool_init(&pool);
     status = 0;
 
     for(int index = 0; index<postfixExpr.size; index++) // Kým sa nespracuje celý postfix výraz
     {
+        var_a = var_b = NULL; // Tokeny z predošlých operácií sú už na zásobníku alebo uvoľnené
+        int op = postfixExpr.array[index]->type; // Typ spracovávaného tokenu
+
         if(is_operand(postfixExpr.array[index]->type))  // Operand
         {
-            ptoken_T *new_token = malloc(sizeof(ptoken_T)); // Vytvorenie nového tokenu kvôli zachovaniu hodnôt v pôvodnom
+            ptoken_T *new_token = memAlloc(MEM_EXPRESSION, sizeof(ptoken_T)); // Vytvorenie nového tokenu kvôli zachovaniu hodnôt v pôvodnom
             copy_data(postfixExpr.array[index], new_token); // Skopírovanie hodnôt z pôvodného tokenu
+            new_token->node = node_new(&pool, leaf_op(new_token), new_token->st_type, StrRead(&(new_token->codename)), NULL, NULL);
 
             if(stack_push_ptoken(&stack, new_token) == COMPILER_ERROR) // Operand sa vloží na zásobník
             {
+                pool_dispose(&pool);
                 endParse_sem(&stack, &postfixExpr); // Upratanie pred skončením funkcie
                 return COMPILER_ERROR; // Vrátenie chybového stavu
             }
-
-            genCode("PUSHS",StrRead(&(postfixExpr.array[index]->codename)),NULL, NULL); // Vloženie premennej na zásobník
         }
         if(is_binary_operator(postfixExpr.array[index]->type)) // Binárny operátor
         {
@@ -755,10 +1326,10 @@ int parseExpression(char* result_type, bool *literal) {
                 var_b->st_type == 'S' || var_b->st_type == 'N')
                 { // Jeden z operandov je nil alebo nil typ
                     if(var_a->st_type == 'I' || var_a->st_type == 'D' || var_a->st_type == 'S' || var_a->st_type == 'N'){
-                        logErrCodeAnalysis(SEM_ERR_TYPE, var_a->ln, var_a->col,"operand is a nil type");
+                        logErrCodeAnalysis(&ctx->log, SEM_ERR_TYPE, var_a->ln, var_a->col,"operand is a nil type");
                     }
                     else{
-                        logErrCodeAnalysis(SEM_ERR_TYPE, var_b->ln, var_b->col,"operand is a nil type");
+                        logErrCodeAnalysis(&ctx->log, SEM_ERR_TYPE, var_b->ln, var_b->col,"operand is a nil type");
                     }
                     status = SEM_ERR_TYPE;
                     break;
@@ -771,167 +1342,106 @@ int parseExpression(char* result_type, bool *literal) {
                         if(var_b->st_type == 's' || var_b->type == STRING_CONST) // Druhý operand je tiež reťazec
                         {
                             var_a->st_type = 's';   // Výsledok konkatenácie je typu string
-                            free(var_b);            // Vymazanie tokenu
+                            var_a->node = node_new(&pool, op, 's', NULL, var_a->node, var_b->node);
+                            memFree(MEM_EXPRESSION, var_b);            // Vymazanie tokenu
+                            var_b = NULL;
                             if((status = stack_push_ptoken(&stack, var_a)) != 0){  // Vloženie tokenu na zásobník
                                 break;
                             }
 
-                            genCode("POPS","GF@!tmp2", NULL, NULL);                 // Popnutie reťazca do pomocnej premennej
-                            genCode("POPS","GF@!tmp1", NULL, NULL);                 // Popnutie reťazca do pomocnej premennej
-                            genCode("CONCAT", "GF@!tmp3", "GF@!tmp1", "GF@!tmp2");  // Konkatenácia reťazcov
-                            genCode("PUSHS", "GF@!tmp3", NULL, NULL);               // Pushnutie konkatenovaného reťazca na stack
-
                             continue; // Posúvame sa na ďalší znak v postfix výraze
                         }
                         else{ // Druhý operand nie je reťazec
-                            logErrCodeAnalysis(SEM_ERR_TYPE, var_b->ln, var_b->col,"expected operand of type string");
+                            logErrCodeAnalysis(&ctx->log, SEM_ERR_TYPE, var_b->ln, var_b->col,"expected operand of type string");
                             status = SEM_ERR_TYPE;
                             break;
                         }
                     }
                     else{ // Operátor nie je "+"
-                        logErrCodeAnalysis(SEM_ERR_TYPE, postfixExpr.array[index]->ln, postfixExpr.array[index]->col,"expected the '+' operator");
+                        logErrCodeAnalysis(&ctx->log, SEM_ERR_TYPE, postfixExpr.array[index]->ln, postfixExpr.array[index]->col,"expected the '+' operator");
                         status = SEM_ERR_TYPE;
                         break;
                     }
                 }
-                if((var_a->st_type == 'i' || var_a->type == INT_CONST) && (var_b->st_type == 'i' || var_b->type == INT_CONST)) 
+                if(var_a->st_type == 'i' && var_b->st_type == 'i') // Int literál má tiež typ 'i'
                 { // 2 Inty
                     var_a->st_type = 'i'; // Výsledok operácie je typu int
                     
                     if(var_b->type != INT_CONST){   // Ak je jeden z operandov premenná, výsledok operácie sa nebude implicitne konvertovať na double
                         var_a->type = ID;           // V tomto prípade musíme na zásobník vložiť výsledok operácie ako typ ID, čiže premenná
                     }
+                    var_a->node = node_new(&pool, op, 'i', NULL, var_a->node, var_b->node);
 
-                    free(var_b); // Vymazanie tokenu
+                    memFree(MEM_EXPRESSION, var_b); // Vymazanie tokenu
+                    var_b = NULL;
                     if(stack_push_ptoken(&stack, var_a) != 0){  // Vloženie tokenu na zásobník
-                        free(var_a); // Vymazanie tokenu
+                        memFree(MEM_EXPRESSION, var_a); // Vymazanie tokenu
+                        pool_dispose(&pool);
                         endParse_sem(&stack, &postfixExpr);     // Upratanie pred skončením funkcie
                         return COMPILER_ERROR;
                     }
-                    switch (postfixExpr.array[index]->type){
-                    case OP_PLUS:
-                        genCode("ADDS",NULL, NULL, NULL);   // Sčítanie hodnôt na vrchole zásobníka
-                        break;
-                    case OP_MINUS:
-                        genCode("SUBS",NULL, NULL, NULL);   // Odčítanie hodnôt na vrchole zásobníka
-                        break;
-                    case OP_DIV:
-                        genCode("IDIVS",NULL, NULL, NULL);  // Podiel integer hodnôt na vrchole zásobníka
-                        break;
-                    case OP_MUL:
-                        genCode("MULS",NULL, NULL, NULL);   // Vynásobenie hodnôt na vrchole zásobníka
-                        break;
-                    }
 
                     continue; // Posúvame sa na ďalší znak v postfix výraze
                 }
                 if((var_a->st_type == 'd' || var_a->type == DOUBLE_CONST) && (var_b->st_type == 'd' || var_b->type == DOUBLE_CONST))
                 { // 2 Double
                     var_a->st_type = 'd'; // Výsledok operácie je typu double
+                    var_a->node = node_new(&pool, op, 'd', NULL, var_a->node, var_b->node);
+                    memFree(MEM_EXPRESSION, var_b); // Vymazanie tokenu
+                    var_b = NULL;
                     if((status = stack_push_ptoken(&stack, var_a)) != 0){  // Vloženie tokenu na zásobník
                         break;
                     }
-                    free(var_b); // Vymazanie tokenu
-
-                    switch (postfixExpr.array[index]->type){
-                    case OP_PLUS:
-                        genCode("ADDS",NULL, NULL, NULL); // Sčítanie hodnôt na vrchole zásobníka
-                        break;
-                    case OP_MINUS:
-                        genCode("SUBS",NULL, NULL, NULL); // Odčítanie hodnôt na vrchole zásobníka
-                        break;
-                    case OP_DIV:
-                        genCode("DIVS",NULL, NULL, NULL); // Podiel hodnôt na vrchole zásobníka
-                        break;
-                    case OP_MUL:
-                        genCode("MULS",NULL, NULL, NULL);  //  Vynásobenie hodnôt na vrchole zásobníka
-                        break;
-                    }
                     continue; // Posúvame sa na ďalší znak v postfix výraze
                 }
                 if( (var_a->type == INT_CONST && (var_b->type == DOUBLE_CONST || var_b->st_type == 'd') ) || 
                 (var_b->type == INT_CONST && (var_a->type == DOUBLE_CONST || var_a->st_type == 'd') ) ) 
                 { // Int konštanta a Double
-                    int2double(var_a, var_b); // Konverzia int typu na double typ
+                    int2double(&pool, var_a); // Konverzia int typu na double typ
+                    int2double(&pool, var_b);
 
                     var_a->st_type = 'd';   // Výsledok operácie je typu double
-                    free(var_b);            // Vymazanie tokenu
+                    var_a->node = node_new(&pool, op, 'd', NULL, var_a->node, var_b->node);
+                    memFree(MEM_EXPRESSION, var_b);            // Vymazanie tokenu
+                    var_b = NULL;
                     if((status = stack_push_ptoken(&stack, var_a)) != 0){  // Vloženie tokenu na zásobník
                         break;
                     }
-
-                    switch (postfixExpr.array[index]->type){
-                    case OP_PLUS:
-                        genCode("ADDS",NULL, NULL, NULL); // Sčítanie hodnôt na vrchole zásobníka
-                        break;
-                    case OP_MINUS:
-                        genCode("SUBS",NULL, NULL, NULL); // Odčítanie hodnôt na vrchole zásobníka
-                        break;
-                    case OP_DIV:
-                        genCode("DIVS",NULL, NULL, NULL); // Podiel hodnôt na vrchole zásobníka
-                        break;
-                    case OP_MUL:
-                        genCode("MULS",NULL, NULL, NULL); // Vynásobenie hodnôt na vrchole zásobníka
-                        break;
-                    }
                     continue; // Posúvame sa na ďalší znak v postfix výraze
 
                 }
                 else{ // Typy nie sú kompatibilné
-                    logErrCodeAnalysis(SEM_ERR_TYPE, var_b->ln, var_b->col,"data type of operand is not compatible");
+                    logErrCodeAnalysis(&ctx->log, SEM_ERR_TYPE, var_b->ln, var_b->col,"data type of operand is not compatible");
                     status = SEM_ERR_TYPE;
                     break;
                 }
             }
             if(is_logical_operator(postfixExpr.array[index]->type)) // Logický operátor
             {
-                if(are_compatible_l(var_a, var_b)) // Overenie, či sú dátové typy kompatibilné pre logickú operáciu
+                if(are_compatible_l(var_a, var_b, &pool)) // Overenie, či sú dátové typy kompatibilné pre logickú operáciu
                 { // Ak sú int a double, are_compatible_l vykoná implicitnú konverzia
 
                     if(var_a->st_type == 'b' && var_b->st_type == 'b' &&
                     (postfixExpr.array[index]->type != EQ && postfixExpr.array[index]->type != NEQ))
                     {// Bool operandy môžu byť porovnané iba operátorom "==" alebo "!="
 
-                        logErrCodeAnalysis(SEM_ERR_TYPE, postfixExpr.array[index]->ln, postfixExpr.array[index]->col,"expected the '==' or '!=' operator");
+                        logErrCodeAnalysis(&ctx->log, SEM_ERR_TYPE, postfixExpr.array[index]->ln, postfixExpr.array[index]->col,"expected the '==' or '!=' operator");
                         status = SEM_ERR_TYPE;
                         break;
                     }
 
                     var_a->st_type = 'b'; // Výsledný token bude typu boolean
+                    var_a->node = node_new(&pool, op, 'b', NULL, var_a->node, var_b->node);
+                    memFree(MEM_EXPRESSION, var_b); // Vymazanie druhého tokenu
+                    var_b = NULL;
                     if((status = stack_push_ptoken(&stack, var_a)) != 0){ // Pushnutie nového tokenu na stack
                         break;
                     }
-                    free(var_b); // Vymazanie druhého tokenu
-
-                    switch (postfixExpr.array[index]->type){
-                    case EQ:
-                        genCode("EQS",NULL, NULL, NULL); // Rovnosť hodnôt
-                        break;
-                    case NEQ:
-                        genCode("EQS",NULL, NULL, NULL); // Rovnosť hodnôt
-                        genCode("NOTS",NULL, NULL, NULL); // => nerovnosť hodnôt
-                        break;
-                    case GT:
-                        genCode("GTS",NULL, NULL, NULL); // A > B
-                        break;
-                    case LT:
-                        genCode("LTS",NULL, NULL, NULL); // A<B
-                        break;
-                    case LTEQ:
-                        genCode("GTS",NULL, NULL, NULL); // A > B
-                        genCode("NOTS",NULL, NULL, NULL); // A <= B
-                        break;
-                    case GTEQ:
-                        genCode("LTS",NULL, NULL, NULL); // A < B
-                        genCode("NOTS",NULL, NULL, NULL); // A >= B
-                        break;
-                    }
                     continue; // Posúvame sa na ďalší znak v postfix výraze
                 }
                 
                 else{ // Typy nie sú kompatibilné
-                    logErrCodeAnalysis(SEM_ERR_TYPE, var_b->ln, var_b->col,"data type of operand is not compatible");
+                    logErrCodeAnalysis(&ctx->log, SEM_ERR_TYPE, var_b->ln, var_b->col,"data type of operand is not compatible");
                     status = SEM_ERR_TYPE;
                     break;
                 }
@@ -940,63 +1450,44 @@ int parseExpression(char* result_type, bool *literal) {
             {
                 if(is_nil_type(var_b)) // Druhý operand je nil alebo nil typ
                 {
-                    logErrCodeAnalysis(SEM_ERR_TYPE, var_b->ln, var_b->col,"operand is a nil type");
+                    logErrCodeAnalysis(&ctx->log, SEM_ERR_TYPE, var_b->ln, var_b->col,"operand is a nil type");
                     status = SEM_ERR_TYPE;
                     break;
                 }
                 if(var_a->st_type == 'N')// Prvý operand je nil
                 {
+                    memFree(MEM_EXPRESSION, var_a); // Vymazanie prvého tokenu, výsledkom je druhý operand
+                    var_a = NULL;
                     if((status = stack_push_ptoken(&stack, var_b)) != 0){  // Pushnutie druhého tokenu na stack
                         break;
                     }
-                    free(var_a); // Vymazanie prvého tokenu
-                    genCode("POPS","GF@!tmp1", NULL, NULL);     // Popnutie non-nil premennej do pomocnej premennej
-                    genCode("POPS","GF@!tmp2", NULL, NULL);     // Odstránenie nil zo zásobníka
-                    genCode("PUSHS","GF@!tmp1", NULL, NULL);    // Vrátenie non-nil premennej späť na zásobník
                     continue; // Posúvame sa na ďalší token
                 }
                 if(are_compatible_n(var_a, var_b)) // Ak majú tokeny kompatibilný dátový typ
                 {
                     if(!is_nil_type(var_a)) // Prvý operand nikdy nebude nil => je výsledok výrazu
                     {
-                        if((status = stack_push_ptoken(&stack, var_a)) != 0){  // Pushnutie druhého tokenu na stack
+                        memFree(MEM_EXPRESSION, var_b); // Vymazanie druhého tokenu, výsledkom je prvý operand
+                        var_b = NULL;
+                        if((status = stack_push_ptoken(&stack, var_a)) != 0){  // Pushnutie prvého tokenu na stack
                         break;
                         }
-                        free(var_b); // Vymazanie druhého tokenu
-                        genCode("POPS","GF@!tmp1", NULL, NULL); // Odstránenie nil zo zásobníka
                         continue;
                     }
                     else // Prvý operand môže byť nil
                     {
+                        var_b->node = node_new(&pool, op, var_b->st_type, NULL, var_a->node, var_b->node);
+                        memFree(MEM_EXPRESSION, var_a); // Vymazanie prvého tokenu
+                        var_a = NULL;
                         if((status = stack_push_ptoken(&stack, var_b)) != 0){  // Pushnutie druhého tokenu na stack
                         break;
                         }
-                        free(var_a); // Vymazanie druhého tokenu
-
-                        str_T label1, label2;
-                        StrInit(&label1);
-                        StrInit(&label2);
-
-                        genUniqLabel("testnil","l1",&label1); // Vygenerovanie labelu pre podmienený skok
-                        genUniqLabel("testnil","l2",&label2); // Vygenerovanie labelu pre podmienený skok
-
-                        genCode("POPS","GF@!tmp2", NULL, NULL); // Popnutie non-nil premennej do pomocnej premennej
-                        genCode("POPS","GF@!tmp1", NULL, NULL); // Popnutie possible-nil premennej do pomocnej premennej
-                        genCode("JUMPIFEQ", StrRead(&label1),"GF@!tmp1", "nil@nil"); // Ak sa prvá premenná rovná nil, skok na náveštie 1
-                        genCode("PUSHS","GF@!tmp1", NULL, NULL); // V tomto prípade prvá premenná nie je nil, pushnutie prvej premennej na zásobník
-                        genCode("JUMP", StrRead(&label2), NULL, NULL); // Skok na koniec funkcie
-                        genCode("LABEL", StrRead(&label1), NULL, NULL); // Náveštie 1
-                        genCode("PUSHS","GF@!tmp2", NULL, NULL); // V tomto prípade prvá premenná je nil, pushnutie 2. premennej na zásobník
-                        genCode("LABEL", StrRead(&label2), NULL, NULL); // Náveštie 2 - koniec funkcie
-
-                        StrDestroy(&label1);
-                        StrDestroy(&label2);
                         continue;
                     }
                 }
                 else
                 {
-                    logErrCodeAnalysis(SEM_ERR_TYPE, var_b->ln, var_b->col,"operand types are not compatible");
+                    logErrCodeAnalysis(&ctx->log, SEM_ERR_TYPE, var_b->ln, var_b->col,"operand types are not compatible");
                     status = SEM_ERR_TYPE;
                     break;
                 }
@@ -1015,7 +1506,7 @@ int parseExpression(char* result_type, bool *literal) {
                 stack_top(&stack)->st_type = 's'; // pretypovanie na String
             }
             if(stack_top(&stack)->type == NIL){ // Výraz "nil!"
-                logErrCodeAnalysis(SEM_ERR_TYPE, stack_top(&stack)->ln, stack_top(&stack)->col,"not possible to make a non-nil value from 'nil'");
+                logErrCodeAnalysis(&ctx->log, SEM_ERR_TYPE, stack_top(&stack)->ln, stack_top(&stack)->col,"not possible to make a non-nil value from 'nil'");
                 status = SEM_ERR_OTHER;
                 break;
             }
@@ -1024,8 +1515,9 @@ int parseExpression(char* result_type, bool *literal) {
     }// Koniec for loopu
 
     if(status != COMPILATION_OK){ // Počas sémantickej analýzy bola zistená chyba
-        free(var_a);
-        free(var_b);
+        memFree(MEM_EXPRESSION, var_a);
+        memFree(MEM_EXPRESSION, var_b);
+        pool_dispose(&pool);
         endParse_sem(&stack, &postfixExpr); // Upratanie pred skončením funkcie
         return status; // Koniec 
     }
@@ -1035,11 +1527,22 @@ int parseExpression(char* result_type, bool *literal) {
         if(stack_top(&stack)->type == INT_CONST){
             *literal = true; // Výsledok je int literál, je možné ho implicitne pretypovať na double
         }
+
+        exp_node_T *root = simplify(&pool, stack_top(&stack)->node); // Zjednodušenie stromu výrazu
+        if(false_label == NULL){
+            emit_node(ctx, root);    // Výsledok výrazu bude na vrchole zásobníka
+        }
+        else{
+            emit_cond_jump(ctx, root, false_label);
+        }
+
+        pool_dispose(&pool);
         endParse_sem(&stack, &postfixExpr); // Upratanie pred skončením funkcie
 
         return COMPILATION_OK; // Úspešný koniec
     }
     else{
+        pool_dispose(&pool);
         endParse_sem(&stack, &postfixExpr); // Upratanie pred skončením funkcie
         return SEM_ERR_OTHER;
     }
@@ -1047,5 +1550,20 @@ int parseExpression(char* result_type, bool *literal) {
     return COMPILATION_OK;
 }
 
+int parseExpression(ctx_T *ctx, char* result_type, bool *literal) {
+    REPORT_ENTER(REPORT_EXPRESSION);
+    int result = parseExpressionGen(ctx, result_type, literal, NULL);
+    REPORT_LEAVE();
+    return result;
+}
+
+int parseCondition(ctx_T *ctx, char* result_type, char* false_label) {
+    bool literal = false; // Podmienka nie je nikdy implicitne konvertovaná
+    REPORT_ENTER(REPORT_EXPRESSION);
+    int result = parseExpressionGen(ctx, result_type, &literal, false_label);
+    REPORT_LEAVE();
+    return result;
+}
+
 
 /* Koniec súboru exp.c */
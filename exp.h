@@ -20,7 +20,7 @@
  *          - či sedia dátové typy operandov
  *  - výsledok je v cieľovom kóde uložený na vrchol zásobníka
  *  
- *  Funkcia očakáva v globálnej premennej tkn (súbor parser.h/c) načítaný prvý token
+ *  Funkcia očakáva v ctx->tkn načítaný prvý token
  *  a zanechá túto premennú prázdnu (NULL), resp. uloží posledný token nepatriaci do
  *  výrazu naspäť skeneru.
  *
@@ -29,7 +29,19 @@
  * @param literal Indikuje, či je výraz literál, aby mohol byť v prípade potreby implicitne konvertovaný na double
  * @return 0 v prípade úspechu, inak číslo chyby
 */
-int parseExpression(char* result_type, bool *literal);
+int parseExpression(ctx_T *ctx, char* result_type, bool *literal);
+
+/**
+ * Funguje rovnako ako parseExpression, ale výsledok výrazu sa neukladá na zásobník.
+ * Namiesto toho sa vygeneruje podmienený skok na false_label, ktorý sa vykoná ak je
+ * výsledok výrazu false. Porovnanie sa tak nemusí negovať ani porovnávať s bool@false.
+ *
+ * @brief Precedenčná syntaktická analýza výrazu v podmienke príkazu if alebo while
+ * @param result_type Dátový typ výsledku výrazu
+ * @param false_label Náveštie, na ktoré sa skočí ak je podmienka nepravdivá
+ * @return 0 v prípade úspechu, inak číslo chyby
+*/
+int parseCondition(ctx_T *ctx, char* result_type, char* false_label);
 
 #endif // ifndef _EXP_H_
 /* Koniec súboru exp.h */
@@ -6,19 +6,35 @@
  */
 
 #include "generator.h"
+#include "memory.h"
+#include "parser.h"
+#include "report.h"
 #include <stdarg.h>
 
-DLLstr_T code_fn;
-DLLstr_T code_main;
-
 void fnParamIdentificator(char *identificator, str_T *id);
 
-void genUniqVar(char *scope, char *sub, str_T *id) {
-    static int count = 0;
-    count++;
+void genInit(gen_T *gen, const options_T *options) {
+    DLLstr_Init(&(gen->code_fn));
+    DLLstr_Init(&(gen->code_main));
+    gen->code_fns = (gen_fn_list_T){ NULL, 0, 0, -1 };
+    gen->inside_fn_def = false;
+    gen->uniq_var_count = 0;
+    gen->uniq_label_count = 0;
+    gen->inline_count = 0;
+    gen->options = options;
+}
+
+void genDestroy(gen_T *gen) {
+    DLLstr_Dispose(&(gen->code_main));
+    DLLstr_Dispose(&(gen->code_fn));
+    genFnCodeDispose(gen);
+}
+
+void genUniqVar(gen_T *gen, char *scope, char *sub, str_T *id) {
+    gen->uniq_var_count++;
 
     char numStr[100];
-    sprintf(numStr, "%d", count);
+    sprintf(numStr, "%d", gen->uniq_var_count);
 
     if(numStr == NULL || scope == NULL || sub == NULL)
         exit(COMPILER_ERROR);
@@ -31,12 +47,11 @@ void genUniqVar(char *scope, char *sub, str_T *id) {
 
 }
 
-void genUniqLabel(char *fn, char *sub, str_T *label){
-    static int count = 0;
-    count++;
+void genUniqLabel(gen_T *gen, char *fn, char *sub, str_T *label){
+    gen->uniq_label_count++;
 
     char numStr[100];
-    sprintf(numStr, "%d", count);
+    sprintf(numStr, "%d", gen->uniq_label_count);
 
     if(numStr == NULL || fn == NULL || sub == NULL)
         exit(COMPILER_ERROR);
@@ -81,11 +96,13 @@ void genConstVal(int const_type, char *value, str_T *cval) {
     }
 }
 
-void genCode(char *instruction, char *op1, char *op2, char *op3) {
+void genCode(gen_T *gen, char *instruction, char *op1, char *op2, char *op3) {
     if (instruction == NULL)
         exit (COMPILER_ERROR);
 
-    str_T *code = malloc(sizeof(str_T));
+    REPORT_ENTER(REPORT_CODEGEN);
+    report_counters.instructions++;
+    str_T *code = memAlloc(MEM_GENERATOR, sizeof(str_T));
     if(code == NULL) exit(COMPILER_ERROR);
     StrInit(code);
 
@@ -106,16 +123,17 @@ void genCode(char *instruction, char *op1, char *op2, char *op3) {
         StrCatString(code, op3);
     }
 
-    if(parser_inside_fn_def == true)
-        DLLstr_InsertLast(&code_fn, StrRead(code));
+    if(gen->inside_fn_def == true)
+        DLLstr_InsertLast(&gen->code_fn, StrRead(code));
     else
-        DLLstr_InsertLast(&code_main, StrRead(code));
+        DLLstr_InsertLast(&gen->code_main, StrRead(code));
 
     StrDestroy(code);
-    free(code);
+    REPORT_LEAVE();
+    memFree(MEM_GENERATOR, code);
 }
 
-void genDefVarsBeforeLoop(char *label, DLLstr_T *variables) {
+void genDefVarsBeforeLoop(gen_T *gen, char *label, DLLstr_T *variables) {
     //Získání hodnoty z něterého seznamu
     str_T var;
     //Zde bude uložená instrukce
@@ -123,10 +141,11 @@ void genDefVarsBeforeLoop(char *label, DLLstr_T *variables) {
     str_T label_instruction;
     DLLstr_T *list;
 
-    if (parser_inside_fn_def) {
-        list = &code_fn;
+    REPORT_ENTER(REPORT_DEFVARS);
+    if (gen->inside_fn_def) {
+        list = &gen->code_fn;
     } else {
-        list = &code_main;
+        list = &gen->code_main;
     }
 
     StrInit(&label_instruction);
@@ -157,6 +176,7 @@ void genDefVarsBeforeLoop(char *label, DLLstr_T *variables) {
                 StrCatString(&instruction, StrRead(&var));
     
                 DLLstr_InsertBefore(list, StrRead(&instruction));
+                report_counters.instructions++;
 
                 DLLstr_Next(variables);
             }
@@ -170,9 +190,10 @@ void genDefVarsBeforeLoop(char *label, DLLstr_T *variables) {
     StrDestroy(&label_instruction);
     StrDestroy(&instruction);
     StrDestroy(&var);
+    REPORT_LEAVE();
 }
 
-void genFnDefBegin(char *fn, DLLstr_T *params) {
+void genFnDefBegin(gen_T *gen, char *fn, DLLstr_T *params) {
     //zde bude zapsán celý identifikator parametru
     str_T idpar;
     //zde budou uloženy parametry funkce
@@ -181,31 +202,103 @@ void genFnDefBegin(char *fn, DLLstr_T *params) {
     StrInit(&idpar);
     StrInit(&fnpar);
 
-    genCode("LABEL", fn, NULL, NULL);
-    genCode("CREATEFRAME", NULL, NULL, NULL);
-    genCode("PUSHFRAME", NULL, NULL, NULL);
+    genCode(gen, "LABEL", fn, NULL, NULL);
+    genCode(gen, "CREATEFRAME", NULL, NULL, NULL);
+    genCode(gen, "PUSHFRAME", NULL, NULL, NULL);
     DLLstr_First(params);
+    int param_count = 0;
 
     while(DLLstr_IsActive(params)) {
         DLLstr_GetValue(params, &fnpar);
         if(strcmp(StrRead(&fnpar), "_") == 0) {
             // parameter s identifikátorom '_' nie je využívaný v tele funkcie
             // Hodnota argumentu na zásobníku je preto zahodená
-            genCode(INS_POPS, VAR_TMP1, NULL, NULL);
+            genCode(gen, INS_POPS, VAR_TMP1, NULL, NULL);
         }
         else {
             fnParamIdentificator(StrRead(&fnpar), &idpar);
-            genCode("DEFVAR", StrRead(&idpar), NULL, NULL);
-            genCode("POPS", StrRead(&idpar), NULL, NULL);
+            genCode(gen, "DEFVAR", StrRead(&idpar), NULL, NULL);
+            genCode(gen, "POPS", StrRead(&idpar), NULL, NULL);
         }
         DLLstr_Next(params);
+        param_count++;
     }
+    if (gen->code_fns.current != -1) gen->code_fns.array[gen->code_fns.current].param_count = param_count;
 
     StrDestroy(&idpar);
     StrDestroy(&fnpar);
 }
 
-void genFnCall(char *fn, DLLstr_T *args) {
+int genFnAdd(gen_T *gen, char *fn, int parent) {
+    if (gen->code_fns.count == gen->code_fns.capacity) {
+        gen->code_fns.capacity = gen->code_fns.capacity == 0 ? 16 : gen->code_fns.capacity * 2;
+        gen->code_fns.array = memRealloc(MEM_GENERATOR, gen->code_fns.array, sizeof(gen_fn_T) * gen->code_fns.capacity);
+        if (gen->code_fns.array == NULL) exit(COMPILER_ERROR);
+    }
+
+    gen_fn_T *new_fn = &(gen->code_fns.array[gen->code_fns.count]);
+    new_fn->name = memAlloc(MEM_GENERATOR, strlen(fn) + 1);
+    if (new_fn->name == NULL) exit(COMPILER_ERROR);
+    strcpy(new_fn->name, fn);
+    DLLstr_Init(&(new_fn->code));
+    new_fn->parent = parent;
+    new_fn->param_count = -1;
+    new_fn->returns_value = true;
+    new_fn->outer_var_count = new_fn->outer_label_count = 0;
+    return gen->code_fns.count++;
+}
+
+void genFnCodeBegin(gen_T *gen, char *fn) {
+    int index = genFnAdd(gen, fn, gen->code_fns.current);
+    gen_fn_T *new_fn = &(gen->code_fns.array[index]);
+    new_fn->outer_var_count = gen->uniq_var_count;
+    new_fn->outer_label_count = gen->uniq_label_count;
+    gen->uniq_var_count = gen->uniq_label_count = 0;
+
+    if (gen->code_fns.current != -1) {
+        // rozpracovaný kód nadradenej funkcie sa odloží
+        gen->code_fns.array[gen->code_fns.current].code = gen->code_fn;
+        DLLstr_Init(&gen->code_fn);
+    }
+    gen->code_fns.current = index;
+}
+
+void genFnCodeEnd(gen_T *gen) {
+    if (gen->code_fns.current == -1) return;
+
+    gen_fn_T *fn = &(gen->code_fns.array[gen->code_fns.current]);
+    fn->code = gen->code_fn;
+    DLLstr_Init(&gen->code_fn);
+    gen->uniq_var_count = fn->outer_var_count;
+    gen->uniq_label_count = fn->outer_label_count;
+
+    gen->code_fns.current = fn->parent;
+    if (gen->code_fns.current != -1) {
+        // pokračuje sa v kóde nadradenej funkcie
+        gen->code_fn = gen->code_fns.array[gen->code_fns.current].code;
+        DLLstr_Init(&(gen->code_fns.array[gen->code_fns.current].code));
+    }
+}
+
+int genFnLookup(gen_T *gen, char *fn) {
+    for (int i = 0; i < gen->code_fns.count; i++) {
+        if (strcmp(gen->code_fns.array[i].name, fn) == 0) return i;
+    }
+    return -1;
+}
+
+void genFnCodeDispose(gen_T *gen) {
+    for (int i = 0; i < gen->code_fns.count; i++) {
+        memFree(MEM_GENERATOR, gen->code_fns.array[i].name);
+        DLLstr_Dispose(&(gen->code_fns.array[i].code));
+    }
+    memFree(MEM_GENERATOR, gen->code_fns.array);
+    gen->code_fns.array = NULL;
+    gen->code_fns.count = gen->code_fns.capacity = 0;
+    gen->code_fns.current = -1;
+}
+
+void genFnCall(gen_T *gen, char *fn, DLLstr_T *args) {
     //zde budou uloženy argumenty funkce fn
     str_T arg;
     StrInit(&arg);
@@ -214,17 +307,17 @@ void genFnCall(char *fn, DLLstr_T *args) {
     //Průchod přes všechny argumenty funkce
     while (DLLstr_IsActive(args)) {
         DLLstr_GetValue(args, &arg);
-        genCode("PUSHS", StrRead(&arg), NULL, NULL);
+        genCode(gen, "PUSHS", StrRead(&arg), NULL, NULL);
         DLLstr_Previous(args);
     }
     //Vložení na zásobník CALL instrukce
-    genCode("CALL", fn, NULL, NULL);
+    genCode(gen, "CALL", fn, NULL, NULL);
    
     //Uvolnění řetězců
     StrDestroy(&arg);
 }
 
-void genWrite(DLLstr_T *args) {
+void genWrite(gen_T *gen, DLLstr_T *args) {
     //zde budou uloženy argumenty funkce write
     str_T arg;
     StrInit(&arg);
@@ -233,24 +326,25 @@ void genWrite(DLLstr_T *args) {
     while(DLLstr_IsActive(args)) {
         DLLstr_GetValue(args, &arg);
 
-        genCode("WRITE", StrRead(&arg), NULL, NULL);
+        genCode(gen, "WRITE", StrRead(&arg), NULL, NULL);
 
         DLLstr_Next(args);
     }
 }
 
-void genSubstring() {
-    bool previous_parser_in_fn_def_value = parser_inside_fn_def;
+void genSubstring(gen_T *gen) {
+    bool previous_parser_in_fn_def_value = gen->inside_fn_def;
     //Nastavení této proměnné true, aby se kód vygenerovaný genCode ukládal do code_fn
-    parser_inside_fn_def = true;
+    gen->inside_fn_def = true;
     
     int num_of_params = 3;      //počet parametrů funkce 
-    int num_of_local_vars = 7;  //celkový počet lokálních proměnných, které se budou používat
-    int num_of_lables = 3;
+    int num_of_local_vars = 10; //celkový počet lokálních proměnných, které se budou používat
+    int num_of_lables = 8;
 
     //char *local_variables[] = {"?!end", "?!begin", "?!string", "?!strlen", "?!check", "?!output", "?!char"};
-    char *local_variables[] = {"?!string", "?!begin", "?!end", "?!strlen", "?!check", "?!output", "?!char"};
-    char *lables[] = {"substring", "cycle", "end"};
+    char *local_variables[] = {"?!string", "?!begin", "?!end", "?!strlen", "?!check", "?!output", "?!char",
+        "?!count", "?!rest", "?!piece"};
+    char *lables[] = {"substring", "cycle", "end", "doubling", "dcycle", "merge", "merged", "collect"};
     
     str_T uniq_vars[num_of_local_vars];   //Pole lokálních proměnných
     str_T uniq_lables[num_of_lables];
@@ -258,65 +352,111 @@ void genSubstring() {
     /*Oblast inicializace a Generovaní unikátních identifikátorů*/
     for (int i = 0; i < num_of_local_vars; i++) {
         StrInit(&uniq_vars[i]);
-        genUniqVar("LF", local_variables[i], &uniq_vars[i]);
+        genUniqVar(gen, "LF", local_variables[i], &uniq_vars[i]);
     }
     for (int i = 0; i < num_of_lables; i++) {
         StrInit(&uniq_lables[i]);
-        genUniqLabel(lables[i], "", &uniq_lables[i]);
+        genUniqLabel(gen, lables[i], "", &uniq_lables[i]);
     }
     /*Konec inicializace a generování unikátních identifikátorů*/
 
     /*Hlavní část vygenerování kódu*/
-    genCode("LABEL", "substring", NULL, NULL);
-    genCode("CREATEFRAME", NULL, NULL, NULL);
-    genCode("PUSHFRAME", NULL, NULL, NULL);
+    genCode(gen, "LABEL", "substring", NULL, NULL);
+    genCode(gen, "CREATEFRAME", NULL, NULL, NULL);
+    genCode(gen, "PUSHFRAME", NULL, NULL, NULL);
 
     for (int i = 0; i < num_of_params; i++) {
-        genCode("DEFVAR", StrRead(&uniq_vars[i]), NULL, NULL);    
-        genCode("POPS", StrRead(&uniq_vars[i]), NULL, NULL);
+        genCode(gen, "DEFVAR", StrRead(&uniq_vars[i]), NULL, NULL);    
+        genCode(gen, "POPS", StrRead(&uniq_vars[i]), NULL, NULL);
     }
     //Inicializace lokalnich promennych (neberou se v potza parametry, ty uz jsou nainicializovane)
     for (int i = num_of_params; i < num_of_local_vars; i++) {
-        genCode("DEFVAR", StrRead(&uniq_vars[i]), NULL, NULL);
+        genCode(gen, "DEFVAR", StrRead(&uniq_vars[i]), NULL, NULL);
     }
     //Overeni spravnosti zadanych mezi retezce
-    genCode("MOVE", StrRead(&uniq_vars[5]), "nil@nil", NULL);
-    genCode("STRLEN", StrRead(&uniq_vars[3]), StrRead(&uniq_vars[0]), NULL);
+    genCode(gen, "MOVE", StrRead(&uniq_vars[5]), "nil@nil", NULL);
+    genCode(gen, "STRLEN", StrRead(&uniq_vars[3]), StrRead(&uniq_vars[0]), NULL);
     /*Overovani*/
-    genCode("GT", StrRead(&uniq_vars[4]), StrRead(&uniq_vars[1]), StrRead(&uniq_vars[3]));
-    genCode("EQ", StrRead(&uniq_vars[4]), StrRead(&uniq_vars[1]), StrRead(&uniq_vars[3]));
-    genCode("JUMPIFEQ", StrRead(&uniq_lables[2]), StrRead(&uniq_vars[4]), "bool@true");
+    genCode(gen, "GT", StrRead(&uniq_vars[4]), StrRead(&uniq_vars[1]), StrRead(&uniq_vars[3]));
+    genCode(gen, "EQ", StrRead(&uniq_vars[4]), StrRead(&uniq_vars[1]), StrRead(&uniq_vars[3]));
+    genCode(gen, "JUMPIFEQ", StrRead(&uniq_lables[2]), StrRead(&uniq_vars[4]), "bool@true");
 
-    genCode("GT", StrRead(&uniq_vars[4]), StrRead(&uniq_vars[2]), StrRead(&uniq_vars[3]));
-    genCode("JUMPIFEQ", StrRead(&uniq_lables[2]), StrRead(&uniq_vars[4]), "bool@true");
+    genCode(gen, "GT", StrRead(&uniq_vars[4]), StrRead(&uniq_vars[2]), StrRead(&uniq_vars[3]));
+    genCode(gen, "JUMPIFEQ", StrRead(&uniq_lables[2]), StrRead(&uniq_vars[4]), "bool@true");
 
-    genCode("LT", StrRead(&uniq_vars[4]), StrRead(&uniq_vars[1]), "int@0");
-    genCode("JUMPIFEQ", StrRead(&uniq_lables[2]), StrRead(&uniq_vars[4]), "bool@true");
+    genCode(gen, "LT", StrRead(&uniq_vars[4]), StrRead(&uniq_vars[1]), "int@0");
+    genCode(gen, "JUMPIFEQ", StrRead(&uniq_lables[2]), StrRead(&uniq_vars[4]), "bool@true");
 
-    genCode("LT", StrRead(&uniq_vars[4]), StrRead(&uniq_vars[2]), "int@0");
-    genCode("JUMPIFEQ", StrRead(&uniq_lables[2]), StrRead(&uniq_vars[4]), "bool@true");
+    genCode(gen, "LT", StrRead(&uniq_vars[4]), StrRead(&uniq_vars[2]), "int@0");
+    genCode(gen, "JUMPIFEQ", StrRead(&uniq_lables[2]), StrRead(&uniq_vars[4]), "bool@true");
 
-    genCode("GT", StrRead(&uniq_vars[4]), StrRead(&uniq_vars[1]), StrRead(&uniq_vars[2]));
-    genCode("JUMPIFEQ", StrRead(&uniq_lables[2]), StrRead(&uniq_vars[4]), "bool@true");
+    genCode(gen, "GT", StrRead(&uniq_vars[4]), StrRead(&uniq_vars[1]), StrRead(&uniq_vars[2]));
+    genCode(gen, "JUMPIFEQ", StrRead(&uniq_lables[2]), StrRead(&uniq_vars[4]), "bool@true");
     /*Konec overovani*/
     //Inicializace vystupni promenne
-    genCode("MOVE", StrRead(&uniq_vars[5]), "string@", NULL);
+    genCode(gen, "MOVE", StrRead(&uniq_vars[5]), "string@", NULL);
     //Jsou indexy stejne?
-    genCode("EQ", StrRead(&uniq_vars[4]), StrRead(&uniq_vars[1]), StrRead(&uniq_vars[2]));
-    genCode("JUMPIFEQ", StrRead(&uniq_lables[2]), StrRead(&uniq_vars[4]), "bool@true");
+    genCode(gen, "EQ", StrRead(&uniq_vars[4]), StrRead(&uniq_vars[1]), StrRead(&uniq_vars[2]));
+    genCode(gen, "JUMPIFEQ", StrRead(&uniq_lables[2]), StrRead(&uniq_vars[4]), "bool@true");
+    //Dlouhy podretezec se sklada zdvojovanim, strlen je dale pouzit jako delka podretezce
+    genCode(gen, "SUB", StrRead(&uniq_vars[3]), StrRead(&uniq_vars[2]), StrRead(&uniq_vars[1]));
+    char doubling_min[32];
+    sprintf(doubling_min, "int@%d", gen->options->substr_doubling_min);
+    genCode(gen, "GT", StrRead(&uniq_vars[4]), StrRead(&uniq_vars[3]), doubling_min);
+    genCode(gen, "JUMPIFEQ", StrRead(&uniq_lables[3]), StrRead(&uniq_vars[4]), "bool@true");
 
     /*Hlavni cyklus*/
-    genCode("LABEL", StrRead(&uniq_lables[1]), NULL, NULL);
-    genCode("GETCHAR", StrRead(&uniq_vars[3]), StrRead(&uniq_vars[0]), StrRead(&uniq_vars[1]));
-    genCode("CONCAT", StrRead(&uniq_vars[5]), StrRead(&uniq_vars[5]), StrRead(&uniq_vars[3]));
-    genCode("ADD", StrRead(&uniq_vars[1]), StrRead(&uniq_vars[1]), "int@1");
-    genCode("JUMPIFNEQ", StrRead(&uniq_lables[1]), StrRead(&uniq_vars[1]), StrRead(&uniq_vars[2]));
+    genCode(gen, "LABEL", StrRead(&uniq_lables[1]), NULL, NULL);
+    genCode(gen, "GETCHAR", StrRead(&uniq_vars[3]), StrRead(&uniq_vars[0]), StrRead(&uniq_vars[1]));
+    genCode(gen, "CONCAT", StrRead(&uniq_vars[5]), StrRead(&uniq_vars[5]), StrRead(&uniq_vars[3]));
+    genCode(gen, "ADD", StrRead(&uniq_vars[1]), StrRead(&uniq_vars[1]), "int@1");
+    genCode(gen, "JUMPIFNEQ", StrRead(&uniq_lables[1]), StrRead(&uniq_vars[1]), StrRead(&uniq_vars[2]));
     /*Konec hlavniho cyklu*/
-    genCode("LABEL", StrRead(&uniq_lables[2]), NULL, NULL);
-    genCode("PUSHS", StrRead(&uniq_vars[5]), NULL, NULL);
-
-    genCode("RETURN", NULL, NULL, NULL);
-    parser_inside_fn_def = previous_parser_in_fn_def_value;
+    genCode(gen, "LABEL", StrRead(&uniq_lables[2]), NULL, NULL);
+    genCode(gen, "PUSHS", StrRead(&uniq_vars[5]), NULL, NULL);
+
+    genCode(gen, "RETURN", NULL, NULL, NULL);
+
+    /*Skladani zdvojovanim*/
+    //Na zasobniku jsou casti vysledku, jejich delky jsou mocniny dvojky klesajici smerem k vrcholu
+    //(jako jednicky v binarnim zapisu poctu znaku). Po pridani k-teho znaku se spoji tolik dvojic
+    //stejne dlouhych casti, kolik ma k nul na konci binarniho zapisu. Kazdy znak se tak kopiruje
+    //nejvyse log2(n)-krat misto n-krat. Zarazka nil@nil oddeluje casti od obsahu zasobniku volajiciho.
+    genCode(gen, "LABEL", StrRead(&uniq_lables[3]), NULL, NULL);
+    genCode(gen, "PUSHS", "nil@nil", NULL, NULL);
+    genCode(gen, "MOVE", StrRead(&uniq_vars[7]), "int@0", NULL);
+    genCode(gen, "LABEL", StrRead(&uniq_lables[4]), NULL, NULL);
+    genCode(gen, "GETCHAR", StrRead(&uniq_vars[6]), StrRead(&uniq_vars[0]), StrRead(&uniq_vars[1]));
+    genCode(gen, "PUSHS", StrRead(&uniq_vars[6]), NULL, NULL);
+    genCode(gen, "ADD", StrRead(&uniq_vars[1]), StrRead(&uniq_vars[1]), "int@1");
+    genCode(gen, "ADD", StrRead(&uniq_vars[7]), StrRead(&uniq_vars[7]), "int@1");
+    genCode(gen, "MOVE", StrRead(&uniq_vars[8]), StrRead(&uniq_vars[7]), NULL);
+    //Je zbytek sudy? Pak se spoji dve casti na vrcholu zasobniku
+    genCode(gen, "LABEL", StrRead(&uniq_lables[5]), NULL, NULL);
+    genCode(gen, "IDIV", StrRead(&uniq_vars[3]), StrRead(&uniq_vars[8]), "int@2");
+    genCode(gen, "MUL", StrRead(&uniq_vars[4]), StrRead(&uniq_vars[3]), "int@2");
+    genCode(gen, "JUMPIFNEQ", StrRead(&uniq_lables[6]), StrRead(&uniq_vars[4]), StrRead(&uniq_vars[8]));
+    genCode(gen, "POPS", StrRead(&uniq_vars[6]), NULL, NULL);
+    genCode(gen, "POPS", StrRead(&uniq_vars[9]), NULL, NULL);
+    genCode(gen, "CONCAT", StrRead(&uniq_vars[9]), StrRead(&uniq_vars[9]), StrRead(&uniq_vars[6]));
+    genCode(gen, "PUSHS", StrRead(&uniq_vars[9]), NULL, NULL);
+    genCode(gen, "MOVE", StrRead(&uniq_vars[8]), StrRead(&uniq_vars[3]), NULL);
+    genCode(gen, "JUMP", StrRead(&uniq_lables[5]), NULL, NULL);
+    genCode(gen, "LABEL", StrRead(&uniq_lables[6]), NULL, NULL);
+    genCode(gen, "JUMPIFNEQ", StrRead(&uniq_lables[4]), StrRead(&uniq_vars[1]), StrRead(&uniq_vars[2]));
+    //Spojeni zbylych casti od nejkratsi (vrchol zasobniku) po nejdelsi
+    genCode(gen, "POPS", StrRead(&uniq_vars[5]), NULL, NULL);
+    genCode(gen, "LABEL", StrRead(&uniq_lables[7]), NULL, NULL);
+    genCode(gen, "POPS", StrRead(&uniq_vars[9]), NULL, NULL);
+    genCode(gen, "JUMPIFEQ", StrRead(&uniq_lables[2]), StrRead(&uniq_vars[9]), "nil@nil");
+    genCode(gen, "CONCAT", StrRead(&uniq_vars[5]), StrRead(&uniq_vars[9]), StrRead(&uniq_vars[5]));
+    genCode(gen, "JUMP", StrRead(&uniq_lables[7]), NULL, NULL);
+    /*Konec skladani zdvojovanim*/
+    gen->inside_fn_def = previous_parser_in_fn_def_value;
+    if (gen->code_fns.current != -1) {
+        gen->code_fns.array[gen->code_fns.current].param_count = num_of_params;
+        gen->code_fns.array[gen->code_fns.current].returns_value = true;
+    }
 
     /* dealokácia pomocných str_T */
     for (int i = 0; i < num_of_local_vars; i++) {
@@ -9,7 +9,8 @@
 #define _GENERATOR_H_
 
 #include "dll.h"
-#include "parser.h"
+#include "scanner.h"
+#include "options.h"
 #include "decode.h"
 
 #define BOOL_CONST -50  ///< Konštanta - true/false ... Musí byť rôzna od hodnôt token_ids.
@@ -43,6 +44,9 @@
 #define INS_LABEL           "LABEL"
 #define INS_JUMP            "JUMP"
 #define INS_JUMPIFEQS       "JUMPIFEQS"
+#define INS_JUMPIFNEQS      "JUMPIFNEQS"
+#define INS_JUMPIFEQ        "JUMPIFEQ"
+#define INS_JUMPIFNEQ       "JUMPIFNEQ"
 #define INS_EXIT            "EXIT"
 
 // Pomocné globálne premenné
@@ -51,14 +55,53 @@
 #define VAR_TMP3 "GF@!tmp3"
 
 /**
- * @brief Vygenerovaný kód pre funkcie
+ * @brief Vygenerovaný kód jednej funkcie
 */
-extern DLLstr_T code_fn;
+typedef struct gen_fn {
+    char *name;         ///< názov funkcie, zároveň náveštie jej začiatku
+    DLLstr_T code;      ///< inštrukcie funkcie
+    int parent;         ///< index funkcie, v ktorej definícii je táto funkcia vnorená, inak -1
+    int param_count;    ///< počet argumentov, ktoré funkcia vyberie zo zásobníka, -1 ak nie je známy
+    bool returns_value; ///< funkcia pri návrate zanechá na zásobníku návratovú hodnotu
+    int outer_var_count;   ///< počítadlo premenných nadradeného kódu, obnoví sa na konci definície
+    int outer_label_count; ///< počítadlo náveští nadradeného kódu, obnoví sa na konci definície
+} gen_fn_T;
 
 /**
- * @brief Vygenerovaný kód pre hlavný program (všetko mimo funkcií)
+ * @brief Zoznam funkcií, ktorých kód bol vygenerovaný
 */
-extern DLLstr_T code_main;
+typedef struct gen_fn_list {
+    gen_fn_T *array;    ///< funkcie v poradí začiatku ich definície
+    int count;          ///< počet funkcií
+    int capacity;       ///< kapacita poľa
+    int current;        ///< index práve definovanej funkcie, ktorej kód je v code_fn, inak -1
+} gen_fn_list_T;
+
+/**
+ * @brief Stav generátora počas prekladu jedného programu
+*/
+typedef struct gen {
+    DLLstr_T code_fn;           ///< vygenerovaný kód práve definovanej funkcie
+    DLLstr_T code_main;         ///< vygenerovaný kód hlavného programu (všetko mimo funkcií)
+    gen_fn_list_T code_fns;     ///< kód všetkých funkcií, ktorých definícia už bola spracovaná
+    bool inside_fn_def;         ///< kód sa generuje do code_fn (vo vnútri definície funkcie), inak do code_main
+    int uniq_var_count;         ///< počítadlo unikátnych identifikátorov premenných
+    int uniq_label_count;       ///< počítadlo unikátnych náveští
+    int inline_count;           ///< počítadlo vložených volaní funkcií (optimizer.c)
+    const options_T *options;   ///< nastavenia prekladu
+} gen_T;
+
+/**
+ * Identifikátory sa generujú od začiatku, takže sú rovnaké ako pri samostatnom preklade.
+ * @brief Pripraví prázdny stav generátora pred prekladom programu
+ * @param options nastavenia prekladu, musia platiť počas celého prekladu
+*/
+void genInit(gen_T *gen, const options_T *options);
+
+/**
+ * @brief Uvoľní vygenerovaný kód hlavného programu aj všetkých funkcií
+*/
+void genDestroy(gen_T *gen);
 
 /**
  * Vygenerovaný identifikátor bude v tvare "<scope>@<id>$<cislo>", kde
@@ -78,7 +121,7 @@ extern DLLstr_T code_main;
  * @param id Výsledný unikátny identifikátor. V prípade neúspechu nedefinované.
  *           Dátovú štruktúru treba inicializovať.
 */
-void genUniqVar(char *scope, char *sub, str_T *id);
+void genUniqVar(gen_T *gen, char *scope, char *sub, str_T *id);
 
 /**
  * Vygenerované náveštie bude v tvare "<fn>&<sub><cislo>", kde 
@@ -98,7 +141,7 @@ void genUniqVar(char *scope, char *sub, str_T *id);
  * @param label Výsledný unikátny názov náveštia. V prípade neúspechu nedefinované.
  *              Dátovú štruktúru treba inicializovať.
 */
-void genUniqLabel(char *fn, char *sub, str_T *label);
+void genUniqLabel(gen_T *gen, char *fn, char *sub, str_T *label);
 
 /**
  * V prípade reťazca treba reťazec prispoôsobiť požiadavkam cieľového kódu pomocou funkcie decode.
@@ -119,8 +162,7 @@ void genUniqLabel(char *fn, char *sub, str_T *label);
 void genConstVal(int const_type, char *value, str_T *cval);
 
 /**
- * Vygenerovaný kód bude vložený na koniec zoznamu code_fn pokiaľ parser_inside_fn_def==true
- * (globálna premenná v parser.h), inak na koniec code_main.
+ * Vygenerovaný kód bude vložený na koniec zoznamu code_fn pokiaľ gen->inside_fn_def==true, inak na koniec code_main.
  * 
  * Príklady:
  *      genCode("ADD", "GF@x", "GF@y", "LF@z") vygeneruje "ADD GF@x GF@y LF@z"
@@ -132,11 +174,10 @@ void genConstVal(int const_type, char *value, str_T *cval);
  * @param op2 Druhý operand. Ak sa rovná NULL, je ignorovaný.
  * @param op3 Tretí operand. Ak sa rovná NULL, je ignorovaný.
 */
-void genCode(char *instruction, char *op1, char *op2, char *op3);
+void genCode(gen_T *gen, char *instruction, char *op1, char *op2, char *op3);
 
 /**
- * Funkcia pracuje so zoznamom code_fn pokiaľ parser_inside_fn_def==true
- * (globálna premenná v parser.h), inak s code_main.
+ * Funkcia pracuje so zoznamom code_fn pokiaľ gen->inside_fn_def==true, inak s code_main.
  * 
  * Vygenerované inštrukcie definícií premenných budú vložené pred náveštie zadané náveštie,
  * resp. pred inštrukciu "LABEL <label>".
@@ -155,7 +196,7 @@ void genCode(char *instruction, char *op1, char *op2, char *op3);
  * @param label Názov náveštia cyklu.
  * @param variables Zoznam identifikátorov premenných, ktoré treba definovať pred cyklom.
 */
-void genDefVarsBeforeLoop(char *label, DLLstr_T *variables);
+void genDefVarsBeforeLoop(gen_T *gen, char *label, DLLstr_T *variables);
 
 /**
  * Vygenerovaný kód bude vložený na koniec zoznamu code_fn.
@@ -184,11 +225,48 @@ void genDefVarsBeforeLoop(char *label, DLLstr_T *variables);
  * @param fn Názov funkcie
  * @param params Identifikátory parametrov funkcie
 */
-void genFnDefBegin(char *fn, DLLstr_T *params);
+void genFnDefBegin(gen_T *gen, char *fn, DLLstr_T *params);
+
+/**
+ * Kód funkcie sa nevygeneruje, ale vloží hotový (napr. z cache), práve definovaná funkcia sa nemení.
+ * @brief Pridá na koniec zoznamu code_fns funkciu s prázdnym kódom
+ * @param fn Názov funkcie
+ * @param parent Index funkcie, v ktorej je definícia vnorená, inak -1
+ * @return Index pridanej funkcie v code_fns
+*/
+int genFnAdd(gen_T *gen, char *fn, int parent);
+
+/**
+ * Kód funkcie sa generuje do code_fn. Ak je definícia funkcie vnorená do inej funkcie,
+ * rozpracovaný kód nadradenej funkcie sa dočasne odloží do jej záznamu v code_fns.
+ * Počítadlá unikátnych identifikátorov začínajú pre každú funkciu od nuly, takže jej kód
+ * nezávisí od toho, kde v programe je definovaná (náveštia sú rozlíšené názvom funkcie).
+ *
+ * @brief Začne generovanie kódu novej funkcie a zaradí ju do zoznamu code_fns.
+ * @param fn Názov funkcie
+*/
+void genFnCodeBegin(gen_T *gen, char *fn);
+
+/**
+ * @brief Presunie kód práve definovanej funkcie z code_fn do jej záznamu v code_fns
+ *        a obnoví kód a počítadlá identifikátorov nadradeného kódu.
+*/
+void genFnCodeEnd(gen_T *gen);
+
+/**
+ * @brief Vyhľadá funkciu v zozname code_fns
+ * @param fn Názov funkcie
+ * @return index funkcie alebo -1, ak sa v zozname nenachádza
+*/
+int genFnLookup(gen_T *gen, char *fn);
 
 /**
- * Vygenerovaný kód bude vložený na koniec zoznamu code_fn pokiaľ parser_inside_fn_def==true
- * (globálna premenná v parser.h), inak na koniec code_main.
+ * @brief Uvoľní kód všetkých funkcií v code_fns
+*/
+void genFnCodeDispose(gen_T *gen);
+
+/**
+ * Vygenerovaný kód bude vložený na koniec zoznamu code_fn pokiaľ gen->inside_fn_def==true, inak na koniec code_main.
  * 
  * Vygenerovaný kód:    vloží do zásobníka argumenty (prvý argument bude na vrchole, posledný na dne)
  *                       a predá riadenie pomocou CALL.
@@ -207,11 +285,10 @@ void genFnDefBegin(char *fn, DLLstr_T *params);
  * @param args Predávané argumenty
     return COMPILATION_OK;
 */
-void genFnCall(char *fn, DLLstr_T *args);
+void genFnCall(gen_T *gen, char *fn, DLLstr_T *args);
 
 /**
- * Vygenerovaný kód bude vložený na koniec zoznamu code_fn pokiaľ parser_inside_fn_def==true
- * (globálna premenná v parser.h), inak na koniec code_main.
+ * Vygenerovaný kód bude vložený na koniec zoznamu code_fn pokiaľ gen->inside_fn_def==true, inak na koniec code_main.
  * 
  * Argumenty funkce se budou zpracovávat z leva doprava. Jako kod se vygeneruje sekvence WRITE prikazu s argumenty v args
  * Ve tvaru:
@@ -226,7 +303,7 @@ void genFnCall(char *fn, DLLstr_T *args);
  * 
  * @param args Předané argumenty
  */
-void genWrite(DLLstr_T *args);
+void genWrite(gen_T *gen, DLLstr_T *args);
 
 /**
  * Vygenerovaný kód bude vložený na koniec zoznamu code_fn.
@@ -281,6 +358,10 @@ void genWrite(DLLstr_T *args);
             PUSHS LF@?!output$6
         RETURN
  * 
+ * Podřetězce delší než gen->options->substr_doubling_min znaků se neskládají po jednom znaku (kvadratický
+ * počet kopírovaných znaků), ale zdvojováním částí na datovém zásobníku (O(n log n) znaků).
+ * Zdvojování vykoná na znak asi čtyřikrát více instrukcí, vyplatí se proto až u dlouhých řetězců.
+ * 
  * Všechny proměnné a labely, použité v této funkci, musí mít unikatní 
  * pojmenování v rámci celého programu
  * 
@@ -288,7 +369,7 @@ void genWrite(DLLstr_T *args);
  * 
  * @param ans Předpokládá se nějaké externí proměnná (z pohledu této funkce), kam bude uložen výsledek
  */
-void genSubstring();
+void genSubstring(gen_T *gen);
 
 #endif // ifndef _GENERATOR_H_
 /* Koniec súboru generator.h */
@@ -0,0 +1,411 @@
+/** Projekt IFJ2023
+ * @file incremental.c
+ * @brief Inkrementálny preklad, cache vygenerovaného kódu jednotlivých funkcií
+ * @author agent (agent@local)
+ * @date 19.10.2026
+ *
+ * Záznam funkcie v cache obsahuje čísla a reťazce v tvare "<číslo> " a "<dĺžka> <znaky> ":
+ *      "IFJ23FN", či definícia volá substring,
+ *      počet funkcií a pre každú názov, index nadradenej funkcie v zázname (-1 pre funkciu
+ *          na najvyššej úrovni), počet parametrov, či vracia hodnotu a zoznam inštrukcií,
+ *      počet zmenených globálnych symbolov a ich nové záznamy,
+ *      zoznam funkcií volaných pred ich definíciou, ktoré pribudli do kontroly na konci programu.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "incremental.h"
+#include "memory.h"
+#include "generator.h"
+#include "logErr.h"
+#include "options.h"
+#include "parser.h"
+#include "report.h"
+
+/** Začiatok záznamu s kódom funkcie, zároveň oddeľuje kľúče funkcií od kľúčov celých programov */
+#define INCR_MAGIC "IFJ23FN"
+
+/**
+ * @brief Rastúci buffer, do ktorého sa skladá záznam
+*/
+typedef struct incr_buf {
+    char *data;         ///< obsah zakončený '\0'
+    size_t len;         ///< dĺžka obsahu
+    size_t capacity;    ///< alokovaná veľkosť
+} incr_buf_T;
+
+/**
+ * @brief Čítanie záznamu načítaného z cache
+*/
+typedef struct incr_reader {
+    char *pos;  ///< nasledujúci znak
+    char *end;  ///< koniec záznamu
+    bool ok;    ///< záznam je zatiaľ platný
+} incr_reader_T;
+
+/**
+ * @brief Pridá na koniec bufferu blok dát
+*/
+static void incrBufAdd(incr_buf_T *b, const char *data, size_t size) {
+    if (b->len + size + 1 > b->capacity) {
+        b->capacity = (b->len + size + 1) * 2;
+        b->data = memRealloc(MEM_CACHE, b->data, b->capacity);
+        if (b->data == NULL) exit(COMPILER_ERROR);
+    }
+    memcpy(b->data + b->len, data, size);
+    b->len += size;
+    b->data[b->len] = '\0';
+}
+
+/**
+ * @brief Zapíše do záznamu číslo
+*/
+static void incrPutInt(incr_buf_T *b, long n) {
+    char number[32];
+    int len = sprintf(number, "%ld ", n);
+    incrBufAdd(b, number, len);
+}
+
+/**
+ * @brief Zapíše do záznamu reťazec spolu s jeho dĺžkou
+*/
+static void incrPutStr(incr_buf_T *b, const char *s) {
+    size_t len = strlen(s);
+    incrPutInt(b, (long)len);
+    incrBufAdd(b, s, len);
+    incrBufAdd(b, " ", 1);
+}
+
+/**
+ * @brief Zapíše do záznamu počet prvkov zoznamu a jednotlivé reťazce
+*/
+static void incrPutList(incr_buf_T *b, DLLstr_T *list) {
+    long count = 0;
+    for (DLLstr_el_ptr el = list->first; el != NULL; el = el->next) count++;
+    incrPutInt(b, count);
+    for (DLLstr_el_ptr el = list->first; el != NULL; el = el->next) incrPutStr(b, el->string);
+}
+
+/**
+ * @brief Zapíše do záznamu aktuálny stav globálneho symbolu id (aj to, že neexistuje)
+*/
+static void incrPutSymbol(ctx_T *ctx, incr_buf_T *b, char *id) {
+    TSData_T *sym = SymTabLookupGlobal(&ctx->symt, id);
+    incrPutStr(b, id);
+    incrPutInt(b, sym != NULL);
+    if (sym == NULL) return;
+    incrPutInt(b, sym->type);
+    incrPutInt(b, sym->let);
+    incrPutInt(b, sym->init);
+    incrPutStr(b, StrRead(&(sym->codename)));
+    incrPutInt(b, sym->sig != NULL);
+    if (sym->sig == NULL) return;
+    incrPutInt(b, sym->sig->ret_type);
+    incrPutStr(b, StrRead(&(sym->sig->par_types)));
+    incrPutList(b, &(sym->sig->par_names));
+    incrPutList(b, &(sym->sig->par_ids));
+}
+
+/**
+ * @brief Prečíta zo záznamu číslo
+*/
+static long incrGetInt(incr_reader_T *r) {
+    if (!r->ok) return 0;
+    char *end;
+    long n = strtol(r->pos, &end, 10);
+    if (end == r->pos || end >= r->end || *end != ' ') {
+        r->ok = false;
+        return 0;
+    }
+    r->pos = end + 1;
+    return n;
+}
+
+/**
+ * Oddeľovač za reťazcom sa prepíše na '\0', záznam sa preto dá prečítať znova.
+ * @brief Prečíta zo záznamu reťazec
+ * @return ukazateľ do záznamu na reťazec zakončený '\0'
+*/
+static char *incrGetStr(incr_reader_T *r) {
+    long len = incrGetInt(r);
+    if (!r->ok || len < 0 || len >= r->end - r->pos || (r->pos[len] != ' ' && r->pos[len] != '\0')) {
+        r->ok = false;
+        return "";
+    }
+    char *s = r->pos;
+    s[len] = '\0';
+    r->pos += len + 1;
+    return s;
+}
+
+/**
+ * @brief Prečíta zo záznamu zoznam reťazcov a vloží ich na koniec list, ak nie je NULL
+*/
+static void incrGetList(incr_reader_T *r, DLLstr_T *list) {
+    long count = incrGetInt(r);
+    if (count < 0) r->ok = false;
+    for (long i = 0; r->ok && i < count; i++) {
+        char *s = incrGetStr(r);
+        if (r->ok && list != NULL) DLLstr_InsertLast(list, s);
+    }
+}
+
+/**
+ * @brief Prečíta zo záznamu nový stav globálneho symbolu a ak je apply, zapíše ho do tabuľky symbolov
+*/
+static void incrGetSymbol(ctx_T *ctx, incr_reader_T *r, bool apply) {
+    char *id = incrGetStr(r);
+    if (incrGetInt(r) != 1) r->ok = false; // symbol, ktorý raz vznikol, z globálnej tabuľky nezmizne
+    long type = incrGetInt(r), let = incrGetInt(r), init = incrGetInt(r);
+    char *codename = incrGetStr(r);
+    long has_sig = incrGetInt(r);
+    if (has_sig != (type == SYM_TYPE_FUNC)) r->ok = false; // signatúru uvoľňuje len záznam funkcie
+
+    TSData_T *sym = NULL;
+    if (apply && r->ok) {
+        sym = SymTabLookupGlobal(&ctx->symt, id);
+        if (sym == NULL) {
+            sym = SymTabCreateElement(id);
+            SymTabInsertGlobal(&ctx->symt, sym);
+        }
+        sym->type = (char)type;
+        sym->let = let;
+        sym->init = init;
+        StrFillWith(&(sym->codename), codename);
+        if (has_sig && sym->sig == NULL) sym->sig = SymTabCreateFuncSig();
+    }
+    if (!has_sig) return;
+
+    long ret_type = incrGetInt(r);
+    char *par_types = incrGetStr(r);
+    if (sym != NULL && r->ok) {
+        sym->sig->ret_type = (char)ret_type;
+        StrFillWith(&(sym->sig->par_types), par_types);
+        DLLstr_Dispose(&(sym->sig->par_names));
+        DLLstr_Dispose(&(sym->sig->par_ids));
+    }
+    incrGetList(r, sym != NULL ? &(sym->sig->par_names) : NULL);
+    incrGetList(r, sym != NULL ? &(sym->sig->par_ids) : NULL);
+}
+
+/**
+ * Záznam sa najprv celý overí (apply == false) a až potom použije, poškodený záznam preto
+ * nezanechá rozpracovaný stav prekladača.
+ *
+ * @brief Prečíta záznam definície funkcie z cache a ak je apply, doplní ho do stavu prekladu
+ * @return true ak je záznam platný
+*/
+static bool incrApply(ctx_T *ctx, char *data, size_t size, DLLstr_T *undefined_fns, bool *substring_called, bool apply) {
+    incr_reader_T r = { data, data + size, true };
+    if (strcmp(incrGetStr(&r), INCR_MAGIC) != 0) return false;
+    long substring = incrGetInt(&r);
+
+    long fns = incrGetInt(&r);
+    int first = ctx->gen.code_fns.count;
+    for (long i = 0; r.ok && i < fns; i++) {
+        char *name = incrGetStr(&r);
+        long parent = incrGetInt(&r), param_count = incrGetInt(&r), returns_value = incrGetInt(&r);
+        if (parent < -1 || parent >= i) r.ok = false; // vnorená funkcia nasleduje za nadradenou
+        int index = -1;
+        if (apply && r.ok) {
+            index = genFnAdd(&ctx->gen, name, parent == -1 ? -1 : first + (int)parent);
+            ctx->gen.code_fns.array[index].param_count = (int)param_count;
+            ctx->gen.code_fns.array[index].returns_value = returns_value;
+        }
+        incrGetList(&r, index != -1 ? &(ctx->gen.code_fns.array[index].code) : NULL);
+    }
+
+    long symbols = incrGetInt(&r);
+    for (long i = 0; r.ok && i < symbols; i++) incrGetSymbol(ctx, &r, apply);
+    incrGetList(&r, apply ? undefined_fns : NULL);
+
+    if (r.pos != r.end) r.ok = false;
+    if (apply && substring) *substring_called = true;
+    return r.ok;
+}
+
+/**
+ * @brief Pridá predčítaný token definície
+*/
+static void incrAddToken(incr_fn_T *unit, token_T *t) {
+    if (unit->count == unit->capacity) {
+        unit->capacity = unit->capacity == 0 ? 64 : unit->capacity * 2;
+        unit->tokens = memRealloc(MEM_CACHE, unit->tokens, sizeof(token_T *) * unit->capacity);
+        if (unit->tokens == NULL) exit(COMPILER_ERROR);
+    }
+    unit->tokens[unit->count++] = t;
+}
+
+/**
+ * @brief Pridá identifikátor použitý v definícii, ak ešte nebol pridaný
+*/
+static void incrAddId(incr_fn_T *unit, char *id) {
+    for (int i = 0; i < unit->id_count; i++) {
+        if (strcmp(unit->ids[i], id) == 0) return;
+    }
+    if (unit->id_count == unit->id_capacity) {
+        unit->id_capacity = unit->id_capacity == 0 ? 16 : unit->id_capacity * 2;
+        unit->ids = memRealloc(MEM_CACHE, unit->ids, sizeof(char *) * unit->id_capacity);
+        unit->before = memRealloc(MEM_CACHE, unit->before, sizeof(char *) * unit->id_capacity);
+        if (unit->ids == NULL || unit->before == NULL) exit(COMPILER_ERROR);
+    }
+    unit->ids[unit->id_count] = memAlloc(MEM_CACHE, strlen(id) + 1); // tokeny neskôr spracuje a uvoľní parser
+    if (unit->ids[unit->id_count] == NULL) exit(COMPILER_ERROR);
+    strcpy(unit->ids[unit->id_count], id);
+    unit->before[unit->id_count++] = NULL;
+}
+
+/**
+ * @brief Uvoľní stav definície, tokeny už musia byť odovzdané skeneru alebo parseru
+*/
+static void incrFree(incr_fn_T *unit) {
+    for (int i = 0; i < unit->id_count; i++) {
+        memFree(MEM_CACHE, unit->ids[i]);
+        memFree(MEM_CACHE, unit->before[i]);
+    }
+    memFree(MEM_CACHE, unit->before);
+    memFree(MEM_CACHE, unit->ids);
+    memFree(MEM_CACHE, unit->tokens);
+    unit->before = unit->ids = NULL;
+    unit->tokens = NULL;
+    unit->id_count = unit->count = 0;
+}
+
+/**
+ * @brief Vypočíta kľúč definície z jej tokenov a stavu globálnych symbolov, ktoré používa
+*/
+static void incrKey(ctx_T *ctx, incr_fn_T *unit) {
+    cache_hash_T h;
+    cacheHashInit(&h, &ctx->options);
+    cacheHashAdd(&h, INCR_MAGIC, sizeof(INCR_MAGIC));
+
+    incr_buf_T record = { NULL, 0, 0 };
+    for (int i = 0; i < unit->count; i++) {
+        token_T *t = unit->tokens[i];
+        record.len = 0;
+        incrPutInt(&record, t->type);
+        incrPutStr(&record, StrRead(&(t->atr)));
+        cacheHashAdd(&h, record.data, record.len);
+        if (t->type == ID) incrAddId(unit, StrRead(&(t->atr)));
+    }
+    for (int i = 0; i < unit->id_count; i++) {
+        record.len = 0;
+        incrPutSymbol(ctx, &record, unit->ids[i]);
+        cacheHashAdd(&h, record.data, record.len);
+        unit->before[i] = record.data;
+        record.data = NULL;
+        record.capacity = 0;
+    }
+    memFree(MEM_CACHE, record.data);
+    cacheHashKey(&h, unit->key);
+}
+
+bool incrFnBegin(ctx_T *ctx, incr_fn_T *unit, DLLstr_T *undefined_fns, bool *substring_called) {
+    memset(unit, 0, sizeof(incr_fn_T));
+
+    // predčítanie definície po zátvorku, ktorá uzatvára telo funkcie
+    int depth = 0;
+    bool body = false, complete = false;
+    while (true) {
+        REPORT_ENTER(REPORT_SCANNER);
+        token_T *t = getToken(&ctx->scanner);
+        REPORT_LEAVE();
+        if (t == NULL) break;
+        incrAddToken(unit, t);
+        if (t->type == INVALID || t->type == EOF_TKN) break;
+        if (t->type == BRT_CUR_L) {
+            depth++;
+            body = true;
+        }
+        else if (t->type == BRT_CUR_R && --depth <= 0) {
+            complete = body && depth == 0;
+            break;
+        }
+    }
+    if (!complete) { // chybu nahlási parser
+        unreadTokens(&ctx->scanner, unit->tokens, unit->count);
+        incrFree(unit);
+        return false;
+    }
+
+    incrKey(ctx, unit);
+    size_t size;
+    char *data = cacheLoad(ctx->options.cache, unit->key, &size);
+    if (data != NULL && incrApply(ctx, data, size, undefined_fns, substring_called, false)) {
+        incrApply(ctx, data, size, undefined_fns, substring_called, true);
+        memFree(MEM_CACHE, data);
+        destroyToken(ctx->tkn);
+        ctx->tkn = unit->tokens[unit->count - 1];
+        for (int i = 0; i < unit->count - 1; i++) destroyToken(unit->tokens[i]);
+        logErrUpdateTokenInfo(&ctx->log, ctx->tkn);
+        incrFree(unit);
+        cacheCountFunction(true);
+        return true;
+    }
+    memFree(MEM_CACHE, data);
+
+    // definíciu spracuje parser, zaznamená sa stav, voči ktorému sa uložia jej zmeny
+    unit->keyed = true;
+    unit->first_fn = ctx->gen.code_fns.count;
+    unit->calls_last = undefined_fns->last;
+    unit->substring_called = *substring_called;
+    *substring_called = false; // zistí sa, či substring volá práve táto definícia
+    unreadTokens(&ctx->scanner, unit->tokens, unit->count);
+    unit->count = 0;
+    cacheCountFunction(false);
+    return false;
+}
+
+/**
+ * @brief Uloží do cache výsledok spracovania definície parserom
+*/
+static void incrStore(ctx_T *ctx, incr_fn_T *unit, DLLstr_T *undefined_fns, bool substring) {
+    incr_buf_T entry = { NULL, 0, 0 }, changed = { NULL, 0, 0 }, record = { NULL, 0, 0 };
+    incrPutStr(&entry, INCR_MAGIC);
+    incrPutInt(&entry, substring);
+
+    incrPutInt(&entry, ctx->gen.code_fns.count - unit->first_fn);
+    for (int i = unit->first_fn; i < ctx->gen.code_fns.count; i++) {
+        gen_fn_T *fn = &(ctx->gen.code_fns.array[i]);
+        incrPutStr(&entry, fn->name);
+        incrPutInt(&entry, fn->parent == -1 ? -1 : fn->parent - unit->first_fn);
+        incrPutInt(&entry, fn->param_count);
+        incrPutInt(&entry, fn->returns_value);
+        incrPutList(&entry, &(fn->code));
+    }
+
+    long count = 0;
+    for (int i = 0; i < unit->id_count; i++) {
+        record.len = 0;
+        incrPutSymbol(ctx, &record, unit->ids[i]);
+        if (strcmp(record.data, unit->before[i]) != 0) {
+            incrBufAdd(&changed, record.data, record.len);
+            count++;
+        }
+    }
+    incrPutInt(&entry, count);
+    if (count > 0) incrBufAdd(&entry, changed.data, changed.len);
+
+    count = 0;
+    DLLstr_el_ptr first_call = unit->calls_last != NULL ? unit->calls_last->next : undefined_fns->first;
+    for (DLLstr_el_ptr el = first_call; el != NULL; el = el->next) count++;
+    incrPutInt(&entry, count);
+    for (DLLstr_el_ptr el = first_call; el != NULL; el = el->next) incrPutStr(&entry, el->string);
+
+    cacheSave(ctx->options.cache, unit->key, entry.data, entry.len);
+    memFree(MEM_CACHE, entry.data);
+    memFree(MEM_CACHE, changed.data);
+    memFree(MEM_CACHE, record.data);
+}
+
+void incrFnEnd(ctx_T *ctx, incr_fn_T *unit, DLLstr_T *undefined_fns, bool *substring_called, bool parsed) {
+    if (unit->keyed) {
+        bool substring = *substring_called;
+        *substring_called = unit->substring_called || substring;
+        if (parsed) incrStore(ctx, unit, undefined_fns, substring);
+    }
+    incrFree(unit);
+}
+
+/* Koniec súboru incremental.c */
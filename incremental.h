@@ -0,0 +1,59 @@
+/** Projekt IFJ2023
+ * @file incremental.h
+ * @brief Inkrementálny preklad, cache vygenerovaného kódu jednotlivých funkcií
+ * @author agent (agent@local)
+ * @date 19.10.2026
+ */
+
+#ifndef _INCREMENTAL_H_
+#define _INCREMENTAL_H_
+
+#include <stdbool.h>
+#include "cache.h"
+#include "dll.h"
+#include "scanner.h"
+#include "parser.h"
+
+/**
+ * @brief Rozpracovaná definícia funkcie na najvyššej úrovni programu
+*/
+typedef struct incr_fn {
+    token_T **tokens;       ///< predčítané tokeny definície za kľúčovým slovom func
+    int count;              ///< počet predčítaných tokenov
+    int capacity;           ///< kapacita poľa tokenov
+    char **ids;             ///< identifikátory použité v definícii, každý raz
+    char **before;          ///< záznamy globálnych symbolov ids pred spracovaním definície
+    int id_count;           ///< počet identifikátorov
+    int id_capacity;        ///< kapacita polí ids a before
+    char key[CACHE_KEY_LEN + 1]; ///< kľúč záznamu v cache
+    bool keyed;             ///< kľúč je vypočítaný, výsledok prekladu definície sa uloží
+    bool substring_called;  ///< volanie substring pred definíciou
+    int first_fn;           ///< index funkcie v code_fns
+    DLLstr_el_ptr calls_last; ///< posledná nedefinovaná volaná funkcia pred definíciou
+} incr_fn_T;
+
+/**
+ * Kód funkcie závisí len od jej tokenov (bez pozície v súbore), od prepínačov a od záznamov
+ * globálnej tabuľky symbolov pre identifikátory, ktoré sa v definícii vyskytujú (signatúry volaných
+ * funkcií vrátane odvodených pri volaní pred definíciou a globálne premenné). Tieto tvoria kľúč.
+ * Pri zásahu sa z cache doplní kód funkcie (aj vnorených), zmeny tabuľky symbolov, volané ešte
+ * nedefinované funkcie a príznak volania substring; tkn bude uzatváracia zátvorka definície.
+ * Inak sa predčítané tokeny vrátia skeneru, definíciu treba spracovať parserom a zavolať incrFnEnd.
+ *
+ * @brief Pokúsi sa prevziať definíciu funkcie z cache, očakáva tkn FUNC na najvyššej úrovni
+ * @param unit stav definície
+ * @param undefined_fns zoznam volaných a ešte nedefinovaných funkcií
+ * @param substring_called príznak volania vstavanej funkcie substring
+ * @return true pri zásahu, inak false
+*/
+bool incrFnBegin(ctx_T *ctx, incr_fn_T *unit, DLLstr_T *undefined_fns, bool *substring_called);
+
+/**
+ * @brief Uloží výsledok úspešného spracovania definície parserom do cache a uvoľní stav definície
+ * @param unit stav z incrFnBegin, ktorá vrátila false
+ * @param parsed definícia bola spracovaná bez chyby, inak sa výsledok neukladá
+*/
+void incrFnEnd(ctx_T *ctx, incr_fn_T *unit, DLLstr_T *undefined_fns, bool *substring_called, bool parsed);
+
+#endif // ifndef _INCREMENTAL_H_
+/* Koniec súboru incremental.h */
@@ -10,69 +10,73 @@
 #include "logErr.h"
 #include "parser.h"
 
- /**
-  * @brief riadok posledného načítaného tokenu, pre prípady výpisu keď tkn == NULL
- */
-static int last_tkn_ln = 1;
 /**
- * @brief stĺpec posledného načítaného tokenu, pre prípady výpisu keď tkn == NULL
+ * @brief Vráti súbor, do ktorého sa vypisujú hlásenia chýb
 */
-static int last_tkn_col = 1;
+static FILE *logErrOutput(errlog_T *log) {
+    return log->output != NULL ? log->output : stderr;
+}
 
-void logErrCompiler(const char* msg) {
-    fprintf(stderr, "[COMPILER ERROR] %s\n", msg);
+void logErrCompiler(errlog_T *log, const char* msg) {
+    fprintf(logErrOutput(log), "[COMPILER ERROR] %s\n", msg);
 }
 
-void logErrCompilerMemAlloc() {
-    logErrCompiler("memory allocation failed");
+void logErrCompilerMemAlloc(errlog_T *log) {
+    logErrCompiler(log, "memory allocation failed");
 }
 
-void logErrCodeAnalysis(const int err_code, const int ln, const int c, const char* format, ...) {
-    if (err_code == LEX_ERR) fprintf(stderr, "Lexical Error");
-    else if (err_code == SYN_ERR) fprintf(stderr, "Syntax Error");
-    else fprintf(stderr, "Semantic Error");
+void logErrCodeAnalysis(errlog_T *log, const int err_code, const int ln, const int c, const char* format, ...) {
+    if (err_code == LEX_ERR) fprintf(logErrOutput(log), "Lexical Error");
+    else if (err_code == SYN_ERR) fprintf(logErrOutput(log), "Syntax Error");
+    else fprintf(logErrOutput(log), "Semantic Error");
 
-    fprintf(stderr, " - ln %d, col %d: ", ln, c);
+    fprintf(logErrOutput(log), " - ln %d, col %d: ", ln, c);
 
     va_list l;
     va_start(l, format);
-    vfprintf(stderr, format, l);
+    vfprintf(logErrOutput(log), format, l);
     va_end(l);
 
-    fprintf(stderr, "\n");
+    fprintf(logErrOutput(log), "\n");
 }
 
-void logErrSyntax(const token_T* t, const char* expected) {
-    if (t != NULL) logErrCodeAnalysis(SYN_ERR, t->ln, t->col, "expected %s, but got '%s'", expected, StrRead((str_T*)(&(t->atr))));
-    else logErrCodeAnalysis(SYN_ERR, last_tkn_ln, last_tkn_col, "expected %s", expected);
+void logErrSyntax(errlog_T *log, const token_T* t, const char* expected) {
+    if (t != NULL) logErrCodeAnalysis(log, SYN_ERR, t->ln, t->col, "expected %s, but got '%s'", expected, StrRead((str_T*)(&(t->atr))));
+    else logErrCodeAnalysis(log, SYN_ERR, log->last_ln, log->last_col, "expected %s", expected);
 }
 
-void logErrSemantic(const token_T* t, const char* format, ...) {
-    fprintf(stderr, "Semantic Error - ln %d, col %d: ",
-        tkn != NULL ? t->ln : last_tkn_ln, tkn != NULL ? t->col: last_tkn_col);
+void logErrSemantic(errlog_T *log, const token_T* t, const char* format, ...) {
+    fprintf(logErrOutput(log), "Semantic Error - ln %d, col %d: ",
+        t != NULL ? t->ln : log->last_ln, t != NULL ? t->col: log->last_col);
 
     va_list l;
     va_start(l, format);
-    vfprintf(stderr, format, l);
+    vfprintf(logErrOutput(log), format, l);
     va_end(l);
 
-    fprintf(stderr, "\n");
+    fprintf(logErrOutput(log), "\n");
 }
 
-void logErrSemanticFn(const char* fn, const char* format, ...) {
-    fprintf(stderr, "Semantic Error - %s(): ", fn);
+void logErrSemanticFn(errlog_T *log, const char* fn, const char* format, ...) {
+    fprintf(logErrOutput(log), "Semantic Error - %s(): ", fn);
 
     va_list l;
     va_start(l, format);
-    vfprintf(stderr, format, l);
+    vfprintf(logErrOutput(log), format, l);
     va_end(l);
 
-    fprintf(stderr, "\n");
+    fprintf(logErrOutput(log), "\n");
+}
+
+void logErrReset(errlog_T *log, FILE *output) {
+    log->output = output;
+    log->last_ln = 1;
+    log->last_col = 1;
 }
 
-void logErrUpdateTokenInfo(const token_T *t) {
-    last_tkn_ln = t->ln;
-    last_tkn_col = t->col;
+void logErrUpdateTokenInfo(errlog_T *log, const token_T *t) {
+    log->last_ln = t->ln;
+    log->last_col = t->col;
 }
 
 
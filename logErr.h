@@ -8,42 +8,59 @@
 #ifndef _LOGERR_H_
 #define _LOGERR_H_ 1
 
+#include <stdio.h>
 #include "scanner.h"
 
+/**
+ * @brief Stav hlásenia chýb počas prekladu jedného programu
+*/
+typedef struct errlog {
+    FILE *output;       ///< výstup pre hlásenia chýb, NULL značí stderr
+    int last_ln;        ///< riadok posledného načítaného tokenu, pre prípady výpisu keď token == NULL
+    int last_col;       ///< stĺpec posledného načítaného tokenu, pre prípady výpisu keď token == NULL
+} errlog_T;
+
 /**
  * @brief Vypíše do stderr chybu prekladača s priloženou správou
 */
-void logErrCompiler(const char *msg);
+void logErrCompiler(errlog_T *log, const char *msg);
 
 /**
  * @brief Vypíše do stderr chybu alokácie pamäte
 */
-void logErrCompilerMemAlloc();
+void logErrCompilerMemAlloc(errlog_T *log);
 
 /**
  * @brief Vypíše do stderr chybu prekladu kódu, funguje podobne ako printf
 */
-void logErrCodeAnalysis(const int err_code, const int ln, const int c, const char *format, ...);
+void logErrCodeAnalysis(errlog_T *log, const int err_code, const int ln, const int c, const char *format, ...);
 
 /**
  * @brief Vypíše do stderr informáciu o syntaktickej chybe
 */
-void logErrSyntax(const token_T *t, const char *expected);
+void logErrSyntax(errlog_T *log, const token_T *t, const char *expected);
 
 /**
  * @brief Vypíše do stderr informáciu o sémantickej chybe
 */
-void logErrSemantic(const token_T *t, const char *format, ...);
+void logErrSemantic(errlog_T *log, const token_T *t, const char *format, ...);
 
 /**
  * @brief Vypíše do stderr informáciu o sémantickej chybe v definícií funkcie.
 */
-void logErrSemanticFn(const char *fn, const char *format, ...);
+void logErrSemanticFn(errlog_T *log, const char *fn, const char *format, ...);
+
+/**
+ * Všetky funkcie logErr* s týmto stavom potom namiesto stderr vypisujú do output.
+ * @brief Pripraví hlásenie chýb na preklad ďalšieho programu
+ * @param output súbor pre hlásenia chýb, NULL značí stderr
+*/
+void logErrReset(errlog_T *log, FILE *output);
 
 /**
  * @brief Aktualizuje informácie o pozícií posledného tokenu
 */
-void logErrUpdateTokenInfo(const token_T *t);
+void logErrUpdateTokenInfo(errlog_T *log, const token_T *t);
 
 #endif
 
@@ -5,22 +5,32 @@
  * @date 17.11.2023
  */
 
+#include <unistd.h>
 #include "parser.h"
+#include "compiler.h"
+#include "batch.h"
+#include "server.h"
+#include "cache.h"
 
-int main() {
-    if (!initializeParser()) return COMPILER_ERROR; // inicializácia dátových štruktúr parsera
-    TRY_OR_EXIT(nextToken()); // načítať prvý token
-    while (tkn->type != EOF_TKN)
-    {
-        TRY_OR_EXIT(parse());   // spracovanie základneho príkazu, pravidlo <STAT>
-        TRY_OR_EXIT(nextToken());
-    }
+/** Kontext prekladu programu zo stdin, pri rýchlom ukončení ostane alokovaný do konca procesu */
+static ctx_T ctx;
 
-    TRY_OR_EXIT(checkIfAllFnDef()); // zistí, či boli definované všetky volané funkcie
+int main(int argc, char **argv) {
+    options_T settings = options_default;
+    if (!parseOptions(argc, argv, &settings)) return COMPILER_ERROR; // prepínače prekladača
 
-    printOutCompiledCode(); // výpis vygenerovaného cieľového kódu
+    if (settings.server != NULL) return serverRun(settings.server, settings.jobs, &settings);
 
-    destroyParser(); // dealokácia použitých zdrojov
+    int result;
+    if (settings.batch != NULL) {
+        result = batchCompile(settings.batch, settings.jobs, &settings);
+    }
+    else {
+        // proces po preklade skončí, uvoľnenie pamäte je zbytočné (--alloc-stats ho potrebuje)
+        compiler_T c = { stdin, STDOUT_FILENO, NULL, settings, !settings.alloc_stats };
+        result = compileWith(&ctx, &c);
+    }
 
-    return COMPILATION_OK;
-}
\ No newline at end of file
+    if (settings.cache_stats) cachePrintStats(settings.cache, stderr);
+    return result;
+}
@@ -0,0 +1,243 @@
+/** Projekt IFJ2023
+ * @file memory.c
+ * @brief Rozhranie alokátora pamäte prekladača so štatistikami podľa podsystémov
+ * @author agent (agent@local)
+ * @date 19.10.2026
+ */
+
+#include <malloc.h>
+#include <stdlib.h>
+#include <string.h>
+#include "memory.h"
+
+/** Názvy podsystémov vo výpise */
+static const char *mem_names[MEM_TAGS] = {
+    "strings", "lists", "symtable", "scanner", "expressions", "generator", "optimizer", "output", "cache"
+};
+
+static void *memLibcAlloc(void *ctx, size_t size) {
+    (void)ctx;
+    return malloc(size);
+}
+
+static void *memLibcResize(void *ctx, void *ptr, size_t size) {
+    (void)ctx;
+    return realloc(ptr, size);
+}
+
+static void memLibcRelease(void *ctx, void *ptr) {
+    (void)ctx;
+    free(ptr);
+}
+
+static size_t memLibcUsable(void *ctx, void *ptr) {
+    (void)ctx;
+    return malloc_usable_size(ptr);
+}
+
+const allocator_T mem_libc = { memLibcAlloc, memLibcResize, memLibcRelease, memLibcUsable, NULL };
+
+/**
+ * @brief Hlavička bloku pamäte arény
+*/
+typedef struct mem_chunk {
+    struct mem_chunk *next;         ///< predchádzajúci alokovaný blok pamäte
+    size_t size;                    ///< veľkosť dát za hlavičkou
+} mem_chunk_T;
+
+/**
+ * @brief Hlavička veľkého bloku arény alokovaného cez malloc
+*/
+typedef struct mem_large {
+    struct mem_large *prev;         ///< predchádzajúci veľký blok v zozname arény
+    struct mem_large *next;         ///< nasledujúci veľký blok v zozname arény
+    size_t unused;                  ///< zarovnanie dát na MEM_ARENA_ALIGN
+    size_t size;                    ///< veľkosť dát, vždy väčšia ako MEM_ARENA_SMALL_MAX
+} mem_large_T;
+
+/** Hlavička malého bloku, veľkosť je posledná položka ako pri mem_large_T */
+#define MEM_ARENA_HEADER MEM_ARENA_ALIGN
+
+/** Veľkosť dát bloku arény uložená pred blokom */
+#define MEM_ARENA_SIZE(ptr) (((size_t *)(ptr))[-1])
+
+static void *memArenaAlloc(void *ctx, size_t size) {
+    mem_arena_T *arena = ctx;
+    if (size > MEM_ARENA_SMALL_MAX) {
+        mem_large_T *block = malloc(sizeof(mem_large_T) + size);
+        if (block == NULL) return NULL;
+        block->prev = NULL;
+        block->next = arena->large;
+        if (arena->large != NULL) arena->large->prev = block;
+        arena->large = block;
+        block->size = size;
+        return block + 1;
+    }
+
+    int class = size == 0 ? 1 : (size + MEM_ARENA_ALIGN - 1) / MEM_ARENA_ALIGN;
+    void *ptr = arena->free_lists[class];
+    if (ptr != NULL) {
+        arena->free_lists[class] = *(void **)ptr;
+        return ptr;
+    }
+    size_t needed = MEM_ARENA_HEADER + (size_t)class * MEM_ARENA_ALIGN;
+    if (arena->next == NULL || (size_t)(arena->end - arena->next) < needed) {
+        mem_chunk_T *chunk = malloc(sizeof(mem_chunk_T) + MEM_ARENA_CHUNK_SIZE);
+        if (chunk == NULL) return NULL;
+        chunk->next = arena->chunks;
+        chunk->size = MEM_ARENA_CHUNK_SIZE;
+        arena->chunks = chunk;
+        arena->next = (char *)(chunk + 1);
+        arena->end = arena->next + MEM_ARENA_CHUNK_SIZE;
+    }
+    ptr = arena->next + MEM_ARENA_HEADER;
+    arena->next += needed;
+    MEM_ARENA_SIZE(ptr) = (size_t)class * MEM_ARENA_ALIGN;
+    return ptr;
+}
+
+static void memArenaRelease(void *ctx, void *ptr) {
+    mem_arena_T *arena = ctx;
+    if (ptr == NULL) return;
+    size_t size = MEM_ARENA_SIZE(ptr);
+    if (size > MEM_ARENA_SMALL_MAX) {
+        mem_large_T *block = (mem_large_T *)ptr - 1;
+        if (block->prev != NULL) block->prev->next = block->next;
+        else arena->large = block->next;
+        if (block->next != NULL) block->next->prev = block->prev;
+        free(block);
+        return;
+    }
+    int class = size / MEM_ARENA_ALIGN;
+    *(void **)ptr = arena->free_lists[class];
+    arena->free_lists[class] = ptr;
+}
+
+static void *memArenaResize(void *ctx, void *ptr, size_t size) {
+    mem_arena_T *arena = ctx;
+    if (ptr == NULL) return memArenaAlloc(ctx, size);
+    size_t old = MEM_ARENA_SIZE(ptr);
+    if (size <= old) return ptr; // menší blok sa nepresúva, veľký blok tak ostane veľký
+    if (old > MEM_ARENA_SMALL_MAX) {
+        mem_large_T *block = realloc((mem_large_T *)ptr - 1, sizeof(mem_large_T) + size);
+        if (block == NULL) return NULL;
+        if (block->prev != NULL) block->prev->next = block;
+        else arena->large = block;
+        if (block->next != NULL) block->next->prev = block;
+        block->size = size;
+        return block + 1;
+    }
+    void *bigger = memArenaAlloc(ctx, size);
+    if (bigger == NULL) return NULL;
+    memcpy(bigger, ptr, old);
+    memArenaRelease(ctx, ptr);
+    return bigger;
+}
+
+static size_t memArenaUsable(void *ctx, void *ptr) {
+    (void)ctx;
+    return ptr == NULL ? 0 : MEM_ARENA_SIZE(ptr);
+}
+
+void memArenaInit(mem_arena_T *arena) {
+    *arena = (mem_arena_T){
+        .allocator = { memArenaAlloc, memArenaResize, memArenaRelease, memArenaUsable, arena },
+    };
+}
+
+void memArenaDestroy(mem_arena_T *arena) {
+    while (arena->chunks != NULL) {
+        mem_chunk_T *chunk = arena->chunks;
+        arena->chunks = chunk->next;
+        free(chunk);
+    }
+    while (arena->large != NULL) {
+        mem_large_T *block = arena->large;
+        arena->large = block->next;
+        free(block);
+    }
+    memArenaInit(arena);
+}
+
+static _Thread_local const allocator_T *mem_allocator = &mem_libc;
+
+///< štatistiky podsystémov, posledný prvok je súčet
+static _Thread_local mem_stats_T mem_stats[MEM_TAGS + 1];
+
+/** Zbierajú sa štatistiky alokácií, nastavuje memStatsReset */
+static _Thread_local bool mem_tracking = false;
+
+#define MEM_TRACKING mem_tracking
+
+const allocator_T *memSetAllocator(const allocator_T *a) {
+    const allocator_T *previous = mem_allocator;
+    mem_allocator = a != NULL ? a : &mem_libc;
+    return previous;
+}
+
+/**
+ * @brief Pripíše podsystému zmenu obsadenej pamäte
+ * @param allocated veľkosť nového bloku (0 ak sa blok len uvoľnil)
+ * @param released veľkosť uvoľneného alebo zmeneného bloku
+*/
+static void memAccount(mem_tag_T tag, size_t allocated, size_t released) {
+    mem_stats_T *stats[2] = { &mem_stats[tag], &mem_stats[MEM_TAGS] };
+    for (int i = 0; i < 2; i++) {
+        if (allocated > 0) {
+            stats[i]->allocs++;
+            stats[i]->bytes += allocated;
+        }
+        else stats[i]->frees++;
+        stats[i]->live += (long)allocated - (long)released;
+        if (stats[i]->live > stats[i]->peak) stats[i]->peak = stats[i]->live;
+    }
+}
+
+void *memAlloc(mem_tag_T tag, size_t size) {
+    void *ptr = mem_allocator->alloc(mem_allocator->ctx, size);
+    if (MEM_TRACKING && ptr != NULL) memAccount(tag, mem_allocator->usable(mem_allocator->ctx, ptr), 0);
+    return ptr;
+}
+
+void *memCalloc(mem_tag_T tag, size_t count, size_t size) {
+    if (size != 0 && count > (size_t)-1 / size) return NULL;
+    void *ptr = memAlloc(tag, count * size);
+    if (ptr != NULL) memset(ptr, 0, count * size);
+    return ptr;
+}
+
+void *memRealloc(mem_tag_T tag, void *ptr, size_t size) {
+    if (!MEM_TRACKING) return mem_allocator->resize(mem_allocator->ctx, ptr, size);
+    size_t released = mem_allocator->usable(mem_allocator->ctx, ptr);
+    void *result = mem_allocator->resize(mem_allocator->ctx, ptr, size);
+    if (result != NULL) memAccount(tag, mem_allocator->usable(mem_allocator->ctx, result), released);
+    return result;
+}
+
+void memFree(mem_tag_T tag, void *ptr) {
+    if (ptr == NULL) return;
+    if (MEM_TRACKING) memAccount(tag, 0, mem_allocator->usable(mem_allocator->ctx, ptr));
+    mem_allocator->release(mem_allocator->ctx, ptr);
+}
+
+void memStatsReset(bool tracking) {
+    mem_tracking = tracking;
+    memset(mem_stats, 0, sizeof(mem_stats));
+}
+
+mem_stats_T memStats(mem_tag_T tag) {
+    return mem_stats[tag];
+}
+
+void memStatsPrint(FILE *out) {
+    fprintf(out, "allocations:\n  %-12s %10s %10s %12s %12s %12s\n", "subsystem", "allocs", "frees", "bytes",
+        "peak B", "live B");
+    for (int i = 0; i <= MEM_TAGS; i++) {
+        mem_stats_T *s = &mem_stats[i];
+        if (i < MEM_TAGS && s->allocs == 0 && s->frees == 0) continue;
+        fprintf(out, "  %-12s %10ld %10ld %12ld %12ld %12ld\n", i < MEM_TAGS ? mem_names[i] : "total",
+            s->allocs, s->frees, s->bytes, s->peak, s->live);
+    }
+}
+
+/* Koniec súboru memory.c */
@@ -0,0 +1,148 @@
+/** Projekt IFJ2023
+ * @file memory.h
+ * @brief Rozhranie alokátora pamäte prekladača so štatistikami podľa podsystémov
+ * @author agent (agent@local)
+ * @date 19.10.2026
+ */
+
+#ifndef _MEMORY_H_
+#define _MEMORY_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+
+/**
+ * Uvoľnenie a zmena veľkosti bloku sa pripíše podsystému, ktorý blok vlastní v čase volania,
+ * nie nutne tomu, ktorý ho alokoval (napr. reťazec prvku zoznamu nahradený pri skracovaní názvov).
+ * @brief Podsystémy prekladača, ktorým sa pripisujú alokácie
+*/
+typedef enum mem_tag {
+    MEM_STRING,         ///< dynamické reťazce (strR)
+    MEM_LIST,           ///< prvky a reťazce zoznamov (dll), hlavne vygenerovaný kód
+    MEM_SYMTABLE,       ///< tabuľka symbolov
+    MEM_SCANNER,        ///< tokeny a vrátené tokeny skenera
+    MEM_EXPRESSION,     ///< zásobník a uzly precedenčnej analýzy
+    MEM_GENERATOR,      ///< zoznam funkcií a pomocné reťazce generátora
+    MEM_OPTIMIZER,      ///< graf toku riadenia a dátové štruktúry optimalizácií
+    MEM_OUTPUT,         ///< skracovanie názvov
+    MEM_CACHE,          ///< prekladová cache a inkrementálny preklad
+    MEM_TAGS            ///< počet podsystémov
+} mem_tag_T;
+
+/**
+ * Implementácia nemusí podporovať uvoľnenie jednotlivých blokov (napr. aréna). Funkcia usable
+ * vracia veľkosť bloku, ktorá sa započíta do štatistík, a musí byť rovnaká pri alokácii aj uvoľnení.
+ *
+ * @brief Alokátor pamäte, ktorým prechádzajú všetky alokácie prekladača
+*/
+typedef struct allocator {
+    void *(*alloc)(void *ctx, size_t size);                 ///< alokuje blok, NULL pri nedostatku pamäte
+    void *(*resize)(void *ctx, void *ptr, size_t size);     ///< zmení veľkosť bloku ako realloc
+    void (*release)(void *ctx, void *ptr);                  ///< uvoľní blok, ptr môže byť NULL
+    size_t (*usable)(void *ctx, void *ptr);                 ///< veľkosť bloku, pre NULL vracia 0
+    void *ctx;                                              ///< stav alokátora
+} allocator_T;
+
+/**
+ * @brief Štatistiky alokácií jedného podsystému
+*/
+typedef struct mem_stats {
+    long allocs;        ///< počet alokácií (aj zväčšení bloku)
+    long frees;         ///< počet uvoľnení
+    long bytes;         ///< súčet veľkostí alokovaných blokov
+    long live;          ///< práve alokované bajty
+    long peak;          ///< najväčší počet súčasne alokovaných bajtov
+} mem_stats_T;
+
+/** Najväčší blok v bajtoch, ktorý aréna alokuje zo svojich blokov, väčšie alokuje malloc */
+#define MEM_ARENA_SMALL_MAX 1024
+
+/** Veľkosť bloku pamäte arény v bajtoch */
+#define MEM_ARENA_CHUNK_SIZE (64 * 1024)
+
+/** Zarovnanie a granularita blokov arény v bajtoch */
+#define MEM_ARENA_ALIGN 16
+
+/**
+ * Malé bloky sa prideľujú posúvaním ukazateľa vo veľkých blokoch pamäte, uvoľnené sa vracajú do
+ * zoznamu voľných blokov svojej veľkostnej triedy a znovu sa použijú. Bloky väčšie ako
+ * MEM_ARENA_SMALL_MAX alokuje malloc a aréna si ich pamätá. Celá pamäť sa uvoľní naraz
+ * funkciou memArenaDestroy bez ohľadu na to, či boli bloky uvoľnené jednotlivo.
+ *
+ * @brief Aréna pre alokácie počas jedného prekladu
+*/
+typedef struct mem_arena {
+    allocator_T allocator;          ///< alokátor nad touto arénou pre memSetAllocator
+    struct mem_chunk *chunks;       ///< alokované bloky pamäte, posledný ako prvý
+    char *next;                     ///< začiatok voľného miesta v aktuálnom bloku pamäte
+    char *end;                      ///< koniec aktuálneho bloku pamäte
+    struct mem_large *large;        ///< veľké bloky alokované cez malloc
+    void *free_lists[MEM_ARENA_SMALL_MAX / MEM_ARENA_ALIGN + 1]; ///< uvoľnené malé bloky podľa triedy
+} mem_arena_T;
+
+/**
+ * @brief Alokátor nad malloc/realloc/free zo štandardnej knižnice, predvolený
+*/
+extern const allocator_T mem_libc;
+
+/**
+ * @brief Inicializuje prázdnu arénu, pamäť sa alokuje až pri prvej alokácii
+*/
+void memArenaInit(mem_arena_T *arena);
+
+/**
+ * @brief Uvoľní naraz všetku pamäť arény, aréna ostane prázdna a použiteľná
+*/
+void memArenaDestroy(mem_arena_T *arena);
+
+/**
+ * Nastavuje sa pred prekladom, bloky sa musia uvoľňovať tým istým alokátorom.
+ * @brief Nastaví alokátor pre alokácie v tomto vlákne
+ * @param a alokátor, NULL značí mem_libc
+ * @return predchádzajúci alokátor
+*/
+const allocator_T *memSetAllocator(const allocator_T *a);
+
+/**
+ * @brief Alokuje blok pamäte, pri zapnutých štatistikách ho pripíše podsystému tag
+ * @return ukazateľ na blok alebo NULL pri nedostatku pamäte
+*/
+void *memAlloc(mem_tag_T tag, size_t size);
+
+/**
+ * @brief Alokuje vynulované pole count prvkov veľkosti size
+*/
+void *memCalloc(mem_tag_T tag, size_t count, size_t size);
+
+/**
+ * @brief Zmení veľkosť bloku ako realloc, pri zlyhaní ostane pôvodný blok nezmenený
+*/
+void *memRealloc(mem_tag_T tag, void *ptr, size_t size);
+
+/**
+ * @brief Uvoľní blok pamäte, ptr môže byť NULL
+*/
+void memFree(mem_tag_T tag, void *ptr);
+
+/**
+ * Alokátor aj štatistiky patria vláknu, ktoré prekladá, a nie sú súčasťou kontextu prekladu,
+ * aby sa nemuseli predávať každej funkcii, ktorá alokuje. Bez zapnutých štatistík stojí
+ * alokácia len volanie alokátora.
+ * @brief Vynuluje štatistiky alokácií v tomto vlákne, volá sa na začiatku prekladu
+ * @param tracking zbierať štatistiky (--alloc-stats alebo --time-report)
+*/
+void memStatsReset(bool tracking);
+
+/**
+ * @brief Vráti štatistiky podsystému, pre MEM_TAGS súčet všetkých (peak je špička súčtu)
+*/
+mem_stats_T memStats(mem_tag_T tag);
+
+/**
+ * @brief Vypíše tabuľku štatistík alokácií podľa podsystémov
+*/
+void memStatsPrint(FILE *out);
+
+#endif // ifndef _MEMORY_H_
+/* Koniec súboru memory.h */
@@ -0,0 +1,251 @@
+/** Projekt IFJ2023
+ * @file names.c
+ * @brief Krátke názvy premenných a náveští vo vypisovanom cieľovom kóde
+ * @author agent (agent@local)
+ * @date 19.10.2026
+ */
+
+#include <string.h>
+#include "names.h"
+#include "memory.h"
+#include "parser.h"
+
+/** Znaky krátkych názvov, prvých NAMES_FIRST_CHARS (písmená) môže byť aj na začiatku názvu */
+#define NAMES_ALPHABET "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789"
+#define NAMES_FIRST_CHARS 52
+#define NAMES_CHARS 62
+
+/** Maximálna dĺžka krátkeho názvu vrátane '\0' */
+#define NAMES_SHORT_LEN 8
+
+/**
+ * @brief Pôvodný a krátky názov
+*/
+typedef struct name {
+    char *name;                         ///< pôvodný názov, u premenných vrátane rámca (napr. "LF@x$2")
+    char short_name[NAMES_SHORT_LEN];   ///< krátky názov bez rámca
+} name_T;
+
+/**
+ * Porovnávacia funkcia qsort nemá parameter s kontextom, kľúč preto nesie aj pôvodný názov.
+ * @brief Položka zoradeného indexu tabuľky názvov
+*/
+typedef struct name_key {
+    char *name;         ///< pôvodný názov položky (zdieľaný s name_T)
+    int index;          ///< index položky v poradí pridania
+} name_key_T;
+
+/**
+ * @brief Tabuľka názvov v poradí prvého výskytu
+*/
+typedef struct names {
+    name_T *items;      ///< položky v poradí pridania
+    name_key_T *sorted; ///< položky zoradené podľa pôvodného názvu, pri zhode podľa indexu
+    int count;          ///< počet položiek
+    int capacity;       ///< veľkosť alokovaných polí
+} names_T;
+
+/**
+ * @brief Vytvorí n-tý krátky názov
+*/
+static void namesShort(int n, char *out) {
+    *out++ = NAMES_ALPHABET[n % NAMES_FIRST_CHARS];
+    for (n /= NAMES_FIRST_CHARS; n > 0; n /= NAMES_CHARS) *out++ = NAMES_ALPHABET[n % NAMES_CHARS];
+    *out = '\0';
+}
+
+/**
+ * @brief Pridá názov do tabuľky, krátky názov je určený poradím pridania
+*/
+static void namesAdd(names_T *names, char *name) {
+    if (names->count == names->capacity) {
+        names->capacity = names->capacity == 0 ? 32 : 2 * names->capacity;
+        names->items = memRealloc(MEM_OUTPUT, names->items, names->capacity * sizeof(name_T));
+        names->sorted = memRealloc(MEM_OUTPUT, names->sorted, names->capacity * sizeof(name_key_T));
+        if (names->items == NULL || names->sorted == NULL) exit(COMPILER_ERROR);
+    }
+    name_T *item = &(names->items[names->count]);
+    item->name = memAlloc(MEM_OUTPUT, strlen(name) + 1);
+    if (item->name == NULL) exit(COMPILER_ERROR);
+    strcpy(item->name, name);
+    namesShort(names->count, item->short_name);
+    names->sorted[names->count] = (name_key_T){ item->name, names->count };
+    names->count++;
+}
+
+/**
+ * @brief Porovnanie položiek indexu podľa pôvodného názvu pre qsort
+*/
+static int namesCmp(const void *a, const void *b) {
+    const name_key_T *x = a, *y = b;
+    int cmp = strcmp(x->name, y->name);
+    return cmp != 0 ? cmp : x->index - y->index;
+}
+
+/**
+ * @brief Zoradí tabuľku pre vyhľadávanie
+*/
+static void namesSort(names_T *names) {
+    if (names->count == 0) return; // prázdne pole (sorted môže byť NULL) sa do qsort neposiela
+    qsort(names->sorted, names->count, sizeof(name_key_T), namesCmp);
+}
+
+/**
+ * Ak bol názov pridaný viackrát, platí jeho prvý výskyt.
+ * @brief Vyhľadá index položky s daným názvom, ak v tabuľke nie je, vráti -1
+*/
+static int namesFind(names_T *names, char *name) {
+    int low = 0, high = names->count - 1, found = -1;
+    while (low <= high) {
+        int mid = (low + high) / 2;
+        int cmp = strcmp(name, names->sorted[mid].name);
+        if (cmp <= 0) high = mid - 1;
+        else low = mid + 1;
+        if (cmp == 0) found = names->sorted[mid].index;
+    }
+    return found;
+}
+
+/**
+ * @brief Zapíše tabuľku názvov
+ * @param scope rozsah platnosti názvov
+*/
+static void namesPrint(names_T *names, FILE *map, char *scope) {
+    if (map == NULL) return;
+    for (int i = 0; i < names->count; i++) {
+        if (namesFind(names, names->items[i].name) != i) continue; // opakovaný výskyt
+        fprintf(map, "%s %s %s\n", scope, names->items[i].short_name, names->items[i].name);
+    }
+}
+
+/**
+ * @brief Uvoľní zdroje tabuľky názvov
+*/
+static void namesDestroy(names_T *names) {
+    for (int i = 0; i < names->count; i++) memFree(MEM_OUTPUT, names->items[i].name);
+    memFree(MEM_OUTPUT, names->items);
+    memFree(MEM_OUTPUT, names->sorted);
+    names->items = NULL;
+    names->sorted = NULL;
+    names->count = names->capacity = 0;
+}
+
+/**
+ * @brief Zistí, či je prvý operand inštrukcie náveštie
+*/
+static bool namesHasLabel(char *opcode) {
+    return strcmp(opcode, INS_LABEL) == 0 || strcmp(opcode, INS_JUMP) == 0 || strcmp(opcode, INS_CALL) == 0 ||
+        strcmp(opcode, INS_JUMPIFEQ) == 0 || strcmp(opcode, INS_JUMPIFNEQ) == 0 ||
+        strcmp(opcode, INS_JUMPIFEQS) == 0 || strcmp(opcode, INS_JUMPIFNEQS) == 0;
+}
+
+/**
+ * @brief Vráti operand inštrukcie DEFVAR alebo LABEL, pre ostatné inštrukcie NULL
+*/
+static char *namesDefined(char *ins, char *opcode) {
+    size_t len = strlen(opcode);
+    if (strncmp(ins, opcode, len) != 0 || ins[len] != ' ') return NULL;
+    return ins + len + 1;
+}
+
+/**
+ * @brief Pridá do tabuliek premenné a náveštia definované v kóde
+ * @param globals premenné GF, NULL ak sa nezbierajú
+ * @param locals premenné LF a TF, NULL ak sa nezbierajú
+ * @param labels náveštia, NULL ak sa nezbierajú
+*/
+static void namesCollect(DLLstr_T *code, names_T *globals, names_T *locals, names_T *labels) {
+    for (DLLstr_el_ptr el = code->first; el != NULL; el = el->next) {
+        char *name = namesDefined(el->string, INS_DEFVAR);
+        if (name != NULL) {
+            names_T *table = strncmp(name, "GF@", 3) == 0 ? globals : locals;
+            if (table != NULL) namesAdd(table, name);
+            continue;
+        }
+        name = namesDefined(el->string, INS_LABEL);
+        if (name != NULL && labels != NULL) namesAdd(labels, name);
+    }
+}
+
+/**
+ * Operandy inštrukcií neobsahujú medzery, pretože ich reťazcové konštanty sú zakódované (\032).
+ * @brief Nahradí v kóde názvy z tabuliek krátkymi názvami
+*/
+static void namesRename(DLLstr_T *code, names_T *globals, names_T *locals, names_T *labels) {
+    str_T ins;
+    StrInit(&ins);
+    for (DLLstr_el_ptr el = code->first; el != NULL; el = el->next) {
+        char *buffer = memAlloc(MEM_OUTPUT, strlen(el->string) + 1);
+        if (buffer == NULL) exit(COMPILER_ERROR);
+        strcpy(buffer, el->string);
+
+        bool renamed = false, has_label = false;
+        char *next = buffer;
+        for (int i = 0; next != NULL; i++) {
+            char *operand = next;
+            next = strchr(operand, ' ');
+            if (next != NULL) *next++ = '\0';
+
+            if (i == 0) { // operačný kód
+                has_label = namesHasLabel(operand);
+                StrFillWith(&ins, operand);
+                continue;
+            }
+
+            names_T *table = NULL;
+            if (i == 1 && has_label) table = labels;
+            else if (strncmp(operand, "GF@", 3) == 0) table = globals;
+            else if (strncmp(operand, "LF@", 3) == 0 || strncmp(operand, "TF@", 3) == 0) table = locals;
+
+            StrAppend(&ins, ' ');
+            int found = table == NULL ? -1 : namesFind(table, operand);
+            if (found == -1) {
+                StrCatString(&ins, operand);
+                continue;
+            }
+            if (table != labels) {
+                StrAppend(&ins, operand[0]);
+                StrCatString(&ins, "F@");
+            }
+            StrCatString(&ins, table->items[found].short_name);
+            renamed = true;
+        }
+        memFree(MEM_OUTPUT, buffer);
+
+        if (renamed) {
+            char *s = memAlloc(MEM_LIST, strlen(StrRead(&ins)) + 1);
+            if (s == NULL) exit(COMPILER_ERROR);
+            strcpy(s, StrRead(&ins));
+            memFree(MEM_LIST, el->string);
+            el->string = s;
+        }
+    }
+    StrDestroy(&ins);
+}
+
+void shortenNames(gen_T *gen, FILE *map) {
+    names_T globals = { NULL, NULL, 0, 0 }, labels = { NULL, NULL, 0, 0 };
+    for (int i = 0; i < gen->code_fns.count; i++) {
+        namesCollect(&(gen->code_fns.array[i].code), &globals, NULL, &labels);
+    }
+    namesCollect(&gen->code_main, &globals, &globals, &labels); // hlavné telo programu nemá vlastný rámec LF
+    namesSort(&globals);
+    namesSort(&labels);
+
+    for (int i = 0; i < gen->code_fns.count; i++) {
+        names_T locals = { NULL, NULL, 0, 0 };
+        namesCollect(&(gen->code_fns.array[i].code), NULL, &locals, NULL);
+        namesSort(&locals);
+        namesRename(&(gen->code_fns.array[i].code), &globals, &locals, &labels);
+        namesPrint(&locals, map, gen->code_fns.array[i].name);
+        namesDestroy(&locals);
+    }
+    namesRename(&gen->code_main, &globals, &globals, &labels);
+    namesPrint(&globals, map, "GF");
+    namesPrint(&labels, map, "label");
+
+    namesDestroy(&globals);
+    namesDestroy(&labels);
+}
+
+/* Koniec súboru names.c */
@@ -0,0 +1,29 @@
+/** Projekt IFJ2023
+ * @file names.h
+ * @brief Krátke názvy premenných a náveští vo vypisovanom cieľovom kóde
+ * @author agent (agent@local)
+ * @date 19.10.2026
+ */
+
+#ifndef _NAMES_H_
+#define _NAMES_H_
+
+#include <stdio.h>
+#include "generator.h"
+
+/**
+ * Názvy sa tvoria zo znakov [a-zA-Z0-9] (prvý znak je písmeno) v poradí prvého výskytu:
+ * a, b, ..., Z, ab, bb, ... Premenné rámca LF a TF sa číslujú v každej funkcii od začiatku,
+ * premenné GF a náveštia sú spoločné pre celý program. Premenujú sa len premenné definované
+ * pomocou DEFVAR a náveštia definované pomocou LABEL v gen->code_fns a gen->code_main, ostatné (napr.
+ * pomocné premenné GF@!tmp1 alebo náveštie !main z hlavičky) ostávajú nezmenené. Vygenerované
+ * názvy vždy obsahujú niektorý zo znakov $, %, & alebo !, preto s krátkymi názvami nekolidujú.
+ *
+ * @brief Nahradí vygenerované názvy premenných a náveští krátkymi názvami
+ * @param map súbor, do ktorého sa zapíše tabuľka "<rozsah> <krátky názov> <pôvodný názov>",
+ *            rozsah je názov funkcie, "GF" pre globálne premenné alebo "label", môže byť NULL
+*/
+void shortenNames(gen_T *gen, FILE *map);
+
+#endif // ifndef _NAMES_H_
+/* Koniec súboru names.h */
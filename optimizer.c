@@ -0,0 +1,1654 @@
+/** Projekt IFJ2023
+ * @file optimizer.c
+ * @brief Optimalizácie nad vygenerovaným cieľovým kódom
+ * @author agent (agent@local)
+ * @date 19.10.2026
+ */
+
+#include <string.h>
+#include "optimizer.h"
+#include "memory.h"
+#include "parser.h"
+#include "cfg.h"
+
+/** Maximálny počet častí inštrukcie, operačný kód a tri operandy */
+#define INS_MAX_PARTS 4
+
+/** Počet inštrukcií prológu funkcie: LABEL, CREATEFRAME, PUSHFRAME */
+#define FN_PROLOGUE_LEN 3
+
+/**
+ * @brief Inštrukcia rozdelená na operačný kód a operandy
+*/
+typedef struct ins_parts {
+    char *buffer;               ///< kópia inštrukcie, v ktorej sú medzery nahradené znakom '\0'
+    char *part[INS_MAX_PARTS];  ///< part[0] je operačný kód, ďalej nasledujú operandy, nevyužité sú NULL
+    int count;                  ///< počet častí
+} ins_parts_T;
+
+/**
+ * @brief Informácie o funkcii potrebné pri vkladaní jej tela do miesta volania
+*/
+typedef struct inline_info {
+    bool valid;         ///< funkcia začína prológom LABEL, CREATEFRAME, PUSHFRAME
+    bool recursive;     ///< funkcia môže (aj nepriamo) volať samu seba
+    int state;          ///< stav prehľadávania grafu volaní: 0 nenavštívená, 1 rozpracovaná, 2 hotová
+} inline_info_T;
+
+/* ----------- POMOCNÉ FUNKCIE PRE PRÁCU S INŠTRUKCIAMI ----------- */
+
+/**
+ * Operandy inštrukcií neobsahujú medzery, pretože ich reťazcové konštanty sú zakódované (\032).
+ * @brief Rozdelí inštrukciu na operačný kód a operandy
+ * @param ins inštrukcia
+ * @param parts výsledok, treba uvoľniť pomocou insPartsFree
+*/
+static void insSplit(char *ins, ins_parts_T *parts) {
+    parts->buffer = memAlloc(MEM_OPTIMIZER, strlen(ins) + 1);
+    if (parts->buffer == NULL) exit(COMPILER_ERROR);
+    strcpy(parts->buffer, ins);
+
+    parts->count = 0;
+    char *p = parts->buffer;
+    while (p != NULL && *p != '\0' && parts->count < INS_MAX_PARTS) {
+        parts->part[parts->count++] = p;
+        p = strchr(p, ' ');
+        if (p != NULL) *p++ = '\0';
+    }
+    for (int i = parts->count; i < INS_MAX_PARTS; i++) parts->part[i] = NULL;
+}
+
+/**
+ * @brief Uvoľní zdroje rozdelenej inštrukcie
+*/
+static void insPartsFree(ins_parts_T *parts) {
+    memFree(MEM_OPTIMIZER, parts->buffer);
+    parts->buffer = NULL;
+}
+
+/**
+ * @brief Zistí, či má inštrukcia daný operačný kód
+*/
+static bool insIs(char *ins, char *opcode) {
+    size_t len = strlen(opcode);
+    return strncmp(ins, opcode, len) == 0 && (ins[len] == ' ' || ins[len] == '\0');
+}
+
+/**
+ * @brief Zistí, či je prvý operand inštrukcie náveštie v rámci funkcie (nie volanie funkcie)
+*/
+static bool insHasLabel(char *opcode) {
+    return strcmp(opcode, INS_LABEL) == 0 || strcmp(opcode, INS_JUMP) == 0 ||
+        strcmp(opcode, INS_JUMPIFEQ) == 0 || strcmp(opcode, INS_JUMPIFNEQ) == 0 ||
+        strcmp(opcode, INS_JUMPIFEQS) == 0 || strcmp(opcode, INS_JUMPIFNEQS) == 0;
+}
+
+/**
+ * @brief Vráti náveštie, na ktoré skáče inštrukcia skoku, pre ostatné inštrukcie NULL
+ * @param parts rozdelená inštrukcia
+*/
+static char *jumpTarget(ins_parts_T *parts) {
+    if (parts->count < 2 || strcmp(parts->part[0], INS_LABEL) == 0 || !insHasLabel(parts->part[0])) return NULL;
+    return parts->part[1];
+}
+
+/**
+ * @brief Vloží reťazec za daný prvok zoznamu, ak je prvok NULL, vloží ho na začiatok
+ * @return vložený prvok
+*/
+static DLLstr_el_ptr listInsertAfter(DLLstr_T *list, DLLstr_el_ptr el, char *s) {
+    if (el == NULL) {
+        DLLstr_InsertFirst(list, s);
+        return list->first;
+    }
+    list->active = el;
+    DLLstr_InsertAfter(list, s);
+    return el->next;
+}
+
+/**
+ * @brief Odstráni daný prvok zoznamu
+ * @return prvok nasledujúci za odstráneným
+*/
+static DLLstr_el_ptr listDelete(DLLstr_T *list, DLLstr_el_ptr el) {
+    DLLstr_el_ptr next = el->next;
+    if (el->prev == NULL) {
+        DLLstr_DeleteFirst(list);
+    }
+    else {
+        list->active = el->prev;
+        DLLstr_DeleteAfter(list);
+    }
+    return next;
+}
+
+/**
+ * Náveštia sa číslujú v rámci jedného prechodu nad kódom funkcie, nie počítadlom generátora.
+ * Ich názvy tak nezávisia od toho, kedy sa funkcia optimalizuje (pri --stream hneď po definícii).
+ * @brief Vytvorí náveštie optimalizácie jedinečné v rámci kódu funkcie fn
+ * @param count počítadlo náveští prechodu
+ * @param label reťazec, na ktorého koniec sa náveštie pripojí
+*/
+static void optUniqLabel(char *fn, char *sub, int *count, str_T *label) {
+    char number[32];
+    sprintf(number, "%d", ++(*count));
+    StrCatString(label, fn);
+    StrAppend(label, '&');
+    StrCatString(label, sub);
+    StrCatString(label, number);
+}
+
+/* ----------- VKLADANIE TIEL FUNKCIÍ DO MIESTA VOLANIA ----------- */
+
+/**
+ * @brief Overí, či kód funkcie začína prológom "LABEL <fn>", CREATEFRAME, PUSHFRAME
+*/
+static bool hasFnPrologue(gen_fn_T *fn) {
+    DLLstr_el_ptr el = fn->code.first;
+    if (el == NULL || !insIs(el->string, INS_LABEL) || strcmp(el->string + strlen(INS_LABEL) + 1, fn->name) != 0)
+        return false;
+    el = el->next;
+    if (el == NULL || strcmp(el->string, INS_CREATEFRAME) != 0) return false;
+    el = el->next;
+    return el != NULL && strcmp(el->string, INS_PUSHFRAME) == 0;
+}
+
+/**
+ * @brief Zistí, či je z funkcie from dosiahnuteľná funkcia target cez inštrukcie CALL
+ * @param visited pole navštívených funkcií
+*/
+static bool fnReaches(gen_T *gen, int from, int target, bool *visited) {
+    for (DLLstr_el_ptr el = gen->code_fns.array[from].code.first; el != NULL; el = el->next) {
+        if (!insIs(el->string, INS_CALL)) continue;
+        int callee = genFnLookup(gen, el->string + strlen(INS_CALL) + 1);
+        if (callee == target) return true;
+        if (callee != -1 && !visited[callee]) {
+            visited[callee] = true;
+            if (fnReaches(gen, callee, target, visited)) return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * DEFVAR sa nepočíta, pretože pri vložení sa presúva na začiatok volajúcej funkcie.
+ * @brief Vráti počet inštrukcií tela funkcie bez prológu
+*/
+static int fnBodySize(gen_fn_T *fn) {
+    int size = 0, index = 0;
+    for (DLLstr_el_ptr el = fn->code.first; el != NULL; el = el->next, index++) {
+        if (index >= FN_PROLOGUE_LEN && !insIs(el->string, INS_DEFVAR)) size++;
+    }
+    return size;
+}
+
+/**
+ * Premenné LF@x sa premenujú na <frame>@x&<k>, náveštia l na l&<k>, kde k je číslo vloženia.
+ * @brief Prepíše inštrukciu z tela vkladanej funkcie do kontextu volajúceho
+ * @param ins pôvodná inštrukcia
+ * @param frame rámec volajúceho, "LF" alebo "GF" (hlavné telo programu)
+ * @param suffix prípona pre premenné a náveštia vloženého tela
+ * @param out výsledná inštrukcia
+*/
+static void inlineRename(char *ins, char *frame, char *suffix, str_T *out) {
+    ins_parts_T parts;
+    insSplit(ins, &parts);
+
+    StrFillWith(out, parts.part[0]);
+    for (int i = 1; i < parts.count; i++) {
+        StrAppend(out, ' ');
+        if (strncmp(parts.part[i], "LF@", 3) == 0) {
+            StrCatString(out, frame);
+            StrCatString(out, parts.part[i] + 2);
+            StrCatString(out, suffix);
+        }
+        else if (i == 1 && insHasLabel(parts.part[0])) {
+            StrCatString(out, parts.part[i]);
+            StrCatString(out, suffix);
+        }
+        else {
+            StrCatString(out, parts.part[i]);
+        }
+    }
+
+    insPartsFree(&parts);
+}
+
+/**
+ * Sekvencia "CALL <fn>", POPFRAME je nahradená telom funkcie:
+ *      - DEFVAR sa presunú na začiatok volajúceho (za prológ funkcie alebo na začiatok hlavného tela),
+ *        aby sa nevykonali viackrát, ak je volanie v cykle
+ *      - argumenty na zásobníku sa vyberajú pôvodnými inštrukciami POPS z tela funkcie
+ *      - RETURN sa nahradí skokom na koniec vloženého tela, posledný RETURN sa vynechá
+ *
+ * @brief Vloží telo funkcie do miesta volania
+ * @param code kód volajúceho
+ * @param call prvok s inštrukciou CALL
+ * @param callee index volanej funkcie v code_fns
+ * @param frame rámec volajúceho, "LF" alebo "GF"
+ * @return prvok nasledujúci za vloženým telom
+*/
+static DLLstr_el_ptr inlineCall(gen_T *gen, DLLstr_T *code, DLLstr_el_ptr call, int callee, char *frame) {
+    char suffix[32];
+    sprintf(suffix, "&%d", ++gen->inline_count);
+
+    gen_fn_T *fn = &(gen->code_fns.array[callee]);
+    str_T ins, end_label;
+    StrInit(&ins);
+    StrInit(&end_label);
+    genUniqLabel(gen, fn->name, "inlined", &end_label);
+    bool end_label_used = false;
+
+    // miesto pre definície premenných volanej funkcie
+    DLLstr_el_ptr defvars = NULL;
+    if (strcmp(frame, "LF") == 0) {
+        defvars = code->first;
+        for (int i = 1; i < FN_PROLOGUE_LEN; i++) defvars = defvars->next;
+    }
+
+    DLLstr_el_ptr popframe = call->next;
+    DLLstr_el_ptr pos = call; // nové inštrukcie sa vkladajú za pos
+    DLLstr_el_ptr el = fn->code.first;
+    for (int i = 0; i < FN_PROLOGUE_LEN; i++) el = el->next;
+    for (; el != NULL; el = el->next) {
+        if (insIs(el->string, INS_RETURN)) {
+            if (el->next == NULL) continue; // z konca tela sa pokračuje priamo za volaním
+            StrFillWith(&ins, INS_JUMP " ");
+            StrCatString(&ins, StrRead(&end_label));
+            end_label_used = true;
+        }
+        else {
+            inlineRename(el->string, frame, suffix, &ins);
+        }
+
+        if (insIs(el->string, INS_DEFVAR)) {
+            listInsertAfter(code, defvars, StrRead(&ins));
+        }
+        else {
+            pos = listInsertAfter(code, pos, StrRead(&ins));
+        }
+    }
+    if (end_label_used) {
+        StrFillWith(&ins, INS_LABEL " ");
+        StrCatString(&ins, StrRead(&end_label));
+        pos = listInsertAfter(code, pos, StrRead(&ins));
+    }
+
+    // odstránenie CALL a POPFRAME
+    listDelete(code, call);
+    el = listDelete(code, popframe);
+
+    StrDestroy(&ins);
+    StrDestroy(&end_label);
+    return el;
+}
+
+/**
+ * @brief Vloží do kódu volajúceho telá všetkých funkcií, ktoré je možné vložiť
+ * @param code kód volajúceho
+ * @param frame rámec volajúceho, "LF" alebo "GF"
+ * @param info informácie o funkciách v code_fns
+*/
+static void inlineCallsIn(gen_T *gen, DLLstr_T *code, char *frame, inline_info_T *info) {
+    DLLstr_el_ptr el = code->first;
+    while (el != NULL) {
+        if (insIs(el->string, INS_CALL) && el->next != NULL && strcmp(el->next->string, INS_POPFRAME) == 0) {
+            int callee = genFnLookup(gen, el->string + strlen(INS_CALL) + 1);
+            if (callee != -1 && info[callee].valid && !info[callee].recursive &&
+                fnBodySize(&(gen->code_fns.array[callee])) <= gen->options->inline_limit) {
+                el = inlineCall(gen, code, el, callee, frame);
+                continue;
+            }
+        }
+        el = el->next;
+    }
+}
+
+/**
+ * Funkcie sú spracované v poradí od listov grafu volaní, takže vkladané telo je už samo
+ * optimalizované a jeho veľkosť zodpovedá kódu, ktorý sa skutočne vloží.
+ *
+ * @brief Spracuje najprv všetky funkcie volané z funkcie fn, potom samotnú funkciu fn
+*/
+static void inlineFnPostOrder(gen_T *gen, int fn, inline_info_T *info) {
+    info[fn].state = 1;
+    for (DLLstr_el_ptr el = gen->code_fns.array[fn].code.first; el != NULL; el = el->next) {
+        if (!insIs(el->string, INS_CALL)) continue;
+        int callee = genFnLookup(gen, el->string + strlen(INS_CALL) + 1);
+        if (callee != -1 && info[callee].state == 0) inlineFnPostOrder(gen, callee, info);
+    }
+    if (info[fn].valid) inlineCallsIn(gen, &(gen->code_fns.array[fn].code), "LF", info);
+    info[fn].state = 2;
+}
+
+/**
+ * @brief Vloží telá malých nerekurzívnych funkcií do miesta ich volania
+*/
+static void inlineFunctions(gen_T *gen) {
+    gen->inline_count = 0;
+    if (gen->code_fns.count == 0) return;
+
+    inline_info_T *info = memCalloc(MEM_OPTIMIZER, gen->code_fns.count, sizeof(inline_info_T));
+    bool *visited = memAlloc(MEM_OPTIMIZER, gen->code_fns.count * sizeof(bool));
+    if (info == NULL || visited == NULL) exit(COMPILER_ERROR);
+
+    for (int i = 0; i < gen->code_fns.count; i++) {
+        info[i].valid = hasFnPrologue(&(gen->code_fns.array[i]));
+        memset(visited, 0, gen->code_fns.count * sizeof(bool));
+        info[i].recursive = fnReaches(gen, i, i, visited);
+    }
+    for (int i = 0; i < gen->code_fns.count; i++) {
+        if (info[i].state == 0) inlineFnPostOrder(gen, i, info);
+    }
+    inlineCallsIn(gen, &gen->code_main, "GF", info);
+
+    memFree(MEM_OPTIMIZER, info);
+    memFree(MEM_OPTIMIZER, visited);
+}
+
+/* ----------- ODSTRÁNENIE REKURZÍVNEHO VOLANIA NA KONCI FUNKCIE ----------- */
+
+/** Maximálny počet nepodmienených skokov, ktoré sa sledujú pri hľadaní návratu z funkcie */
+#define TAIL_MAX_JUMPS 8
+
+/**
+ * @brief Nájde v kóde inštrukciu "LABEL <label>"
+ * @return prvok s náveštím alebo NULL
+*/
+static DLLstr_el_ptr findLabel(DLLstr_T *code, char *label) {
+    for (DLLstr_el_ptr el = code->first; el != NULL; el = el->next) {
+        if (insIs(el->string, INS_LABEL) && strcmp(el->string + strlen(INS_LABEL) + 1, label) == 0) return el;
+    }
+    return NULL;
+}
+
+/**
+ * Náveštia sa preskočia a nepodmienené skoky sa nasledujú (najviac TAIL_MAX_JUMPS).
+ * @brief Nájde inštrukciu, ktorá sa ako ďalšia skutočne vykoná od prvku el
+ * @return prvok s inštrukciou alebo NULL, ak ju nie je možné jednoznačne určiť
+*/
+static DLLstr_el_ptr nextExecuted(DLLstr_T *code, DLLstr_el_ptr el) {
+    int jumps = 0;
+    while (el != NULL) {
+        if (insIs(el->string, INS_LABEL)) {
+            el = el->next;
+        }
+        else if (insIs(el->string, INS_JUMP)) {
+            if (++jumps > TAIL_MAX_JUMPS) return NULL;
+            el = findLabel(code, el->string + strlen(INS_JUMP) + 1);
+        }
+        else {
+            return el;
+        }
+    }
+    return NULL;
+}
+
+/**
+ * Rekurzívne volanie je na konci funkcie, ak za "CALL <fn>", POPFRAME nasleduje:
+ *      - POPS <var> a následne sa vykoná PUSHS <var>, RETURN (let r = fn(...); return r)
+ *      - CLEARS a následne sa vykoná RETURN (volanie void funkcie ako posledný príkaz)
+ *
+ * @brief Zistí, či je volanie funkcie samej seba posledná vykonaná akcia funkcie
+ * @param code kód funkcie
+ * @param popframe prvok s inštrukciou POPFRAME za volaním
+ * @return true ak je možné volanie nahradiť skokom
+*/
+static bool isTailCall(DLLstr_T *code, DLLstr_el_ptr popframe) {
+    DLLstr_el_ptr after = popframe->next;
+    if (after == NULL) return false;
+
+    if (strcmp(after->string, INS_CLEARS) == 0) {
+        DLLstr_el_ptr ret = nextExecuted(code, after->next);
+        return ret != NULL && strcmp(ret->string, INS_RETURN) == 0;
+    }
+    if (insIs(after->string, INS_POPS)) {
+        char *var = after->string + strlen(INS_POPS) + 1;
+        DLLstr_el_ptr push = nextExecuted(code, after->next);
+        if (push == NULL || !insIs(push->string, INS_PUSHS) ||
+            strcmp(push->string + strlen(INS_PUSHS) + 1, var) != 0) return false;
+        DLLstr_el_ptr ret = nextExecuted(code, push->next);
+        return ret != NULL && strcmp(ret->string, INS_RETURN) == 0;
+    }
+    return false;
+}
+
+/**
+ * Sekvencia "CALL <fn>", POPFRAME, POPS/CLEARS sa nahradí sekvenciou POPFRAME, "JUMP <fn>".
+ * Argumenty zostávajú na zásobníku, POPFRAME zahodí rámec aktuálneho volania a prológ funkcie
+ * vytvorí nový rámec, do ktorého argumenty vyberie. Hĺbka zásobníka rámcov aj zásobníka volaní
+ * sa tak pri rekurzii nemení a návrat z funkcie ide priamo k pôvodnému volajúcemu.
+ *
+ * @brief Nahradí rekurzívne volania na konci funkcie skokom na jej začiatok
+ * @param fn funkcia v code_fns
+*/
+static void eliminateTailCalls(gen_fn_T *fn) {
+    str_T ins;
+    StrInit(&ins);
+    StrFillWith(&ins, INS_JUMP " ");
+    StrCatString(&ins, fn->name);
+
+    DLLstr_el_ptr el = fn->code.first;
+    while (el != NULL) {
+        if (insIs(el->string, INS_CALL) && strcmp(el->string + strlen(INS_CALL) + 1, fn->name) == 0 &&
+            el->next != NULL && strcmp(el->next->string, INS_POPFRAME) == 0 && isTailCall(&(fn->code), el->next)) {
+            DLLstr_el_ptr popframe = el->next;
+            listDelete(&(fn->code), popframe->next); // POPS alebo CLEARS
+            listInsertAfter(&(fn->code), popframe, StrRead(&ins));
+            el = listDelete(&(fn->code), el)->next;
+            continue;
+        }
+        el = el->next;
+    }
+
+    StrDestroy(&ins);
+}
+
+/* ----------- ŠPECIALIZÁCIA VOLANÍ SUBSTRING ----------- */
+
+/** Maximálna dĺžka podreťazca, ktorého kopírovanie sa vloží priamo do miesta volania */
+#define SUBSTR_INLINE_MAX 16
+
+/**
+ * @brief Prečíta celočíselnú konštantu "int@<n>"
+ * @return false ak operand nie je celočíselná konštanta
+*/
+static bool intConstant(char *operand, long long *value) {
+    if (strncmp(operand, "int@", strlen("int@")) != 0) return false;
+    char *end;
+    *value = strtoll(operand + strlen("int@"), &end, 10);
+    return *end == '\0' && end != operand + strlen("int@");
+}
+
+/**
+ * Escape sekvencia \ddd je jeden znak. Reťazce so znakmi mimo ASCII sa nevyhodnocujú,
+ * pretože ich dĺžka v znakoch nie je počas prekladu jednoznačná.
+ *
+ * @brief Rozdelí zakódovanú reťazcovú konštantu na znaky
+ * @param value zakódovaný obsah konštanty (za "string@")
+ * @param starts výsledok, pozície začiatkov znakov, posledná je koniec reťazca, treba uvoľniť
+ * @return počet znakov alebo -1, ak reťazec obsahuje znak mimo ASCII
+*/
+static int stringConstantChars(char *value, int **starts) {
+    size_t len = strlen(value);
+    *starts = memAlloc(MEM_OPTIMIZER, (len + 1) * sizeof(int));
+    if (*starts == NULL) exit(COMPILER_ERROR);
+    int count = 0;
+    for (size_t i = 0; i < len; count++) {
+        (*starts)[count] = (int)i;
+        if (value[i] == '\\') {
+            if (atoi(value + i + 1) > 127) return -1;
+            i += 4;
+        }
+        else {
+            if ((unsigned char)value[i] > 127) return -1;
+            i++;
+        }
+    }
+    (*starts)[count] = (int)len;
+    return count;
+}
+
+/**
+ * Výsledok zodpovedá vstavanej funkcii substring: nil ak i < 0, j < 0, i > j, i >= length(s)
+ * alebo j > length(s), inak znaky s[i] až s[j - 1].
+ *
+ * @brief Vyhodnotí substring s konštantnými argumentmi
+ * @param result výsledná konštanta, "string@..." alebo "nil@nil"
+ * @return false ak výsledok nie je možné určiť počas prekladu
+*/
+static bool foldSubstring(char *s, long long i, long long j, str_T *result) {
+    int *starts;
+    int len = stringConstantChars(s + strlen("string@"), &starts);
+    if (len == -1) {
+        memFree(MEM_OPTIMIZER, starts);
+        return false;
+    }
+    if (i < 0 || j < 0 || i > j || i >= len || j > len) {
+        StrFillWith(result, "nil@nil");
+    }
+    else {
+        StrFillWith(result, "string@");
+        for (int k = starts[i]; k < starts[j]; k++) StrAppend(result, s[strlen("string@") + k]);
+    }
+    memFree(MEM_OPTIMIZER, starts);
+    return true;
+}
+
+/**
+ * Vygenerovaný kód (i, j konštanty, n = j - i):
+ *      STRLEN GF@!tmp1 <s>
+ *      LT GF@!tmp2 GF@!tmp1 int@<max(j, i + 1)>     // i >= length(s) alebo j > length(s)
+ *      JUMPIFEQ <nil> GF@!tmp2 bool@true
+ *      GETCHAR GF@!tmp1 <s> int@<i>                // n-krát, ďalšie znaky cez GF@!tmp2 a CONCAT
+ *      PUSHS GF@!tmp1
+ *      JUMP <koniec>
+ *      LABEL <nil>
+ *      PUSHS nil@nil
+ *      LABEL <koniec>
+ *
+ * @brief Nahradí volanie substring s konštantnými indexmi kódom bez volania a cyklu
+ * @param pos prvok, za ktorý sa kód vkladá
+ * @param fn názov funkcie pre nové náveštia, pre hlavné telo prázdny reťazec
+ * @param label_count počítadlo náveští prechodu
+ * @return posledný vložený prvok
+*/
+static DLLstr_el_ptr inlineSubstring(DLLstr_T *code, DLLstr_el_ptr pos, char *s, long long i, long long j,
+    char *fn, int *label_count) {
+    str_T ins, nil_label, end_label;
+    StrInit(&ins);
+    StrInit(&nil_label);
+    StrInit(&end_label);
+    optUniqLabel(fn, "substr_nil", label_count, &nil_label);
+    optUniqLabel(fn, "substr_end", label_count, &end_label);
+    char number[32];
+
+    StrFillWith(&ins, INS_STRLEN " " VAR_TMP1 " ");
+    StrCatString(&ins, s);
+    pos = listInsertAfter(code, pos, StrRead(&ins));
+    sprintf(number, "%lld", j > i + 1 ? j : i + 1);
+    StrFillWith(&ins, "LT " VAR_TMP2 " " VAR_TMP1 " int@");
+    StrCatString(&ins, number);
+    pos = listInsertAfter(code, pos, StrRead(&ins));
+    StrFillWith(&ins, INS_JUMPIFEQ " ");
+    StrCatString(&ins, StrRead(&nil_label));
+    StrCatString(&ins, " " VAR_TMP2 " bool@true");
+    pos = listInsertAfter(code, pos, StrRead(&ins));
+
+    if (i == j) {
+        pos = listInsertAfter(code, pos, INS_PUSHS " string@");
+    }
+    else {
+        for (long long k = i; k < j; k++) {
+            sprintf(number, "%lld", k);
+            StrFillWith(&ins, "GETCHAR ");
+            StrCatString(&ins, k == i ? VAR_TMP1 : VAR_TMP2);
+            StrAppend(&ins, ' ');
+            StrCatString(&ins, s);
+            StrCatString(&ins, " int@");
+            StrCatString(&ins, number);
+            pos = listInsertAfter(code, pos, StrRead(&ins));
+            if (k > i) pos = listInsertAfter(code, pos, INS_CONCAT " " VAR_TMP1 " " VAR_TMP1 " " VAR_TMP2);
+        }
+        pos = listInsertAfter(code, pos, INS_PUSHS " " VAR_TMP1);
+    }
+
+    StrFillWith(&ins, INS_JUMP " ");
+    StrCatString(&ins, StrRead(&end_label));
+    pos = listInsertAfter(code, pos, StrRead(&ins));
+    StrFillWith(&ins, INS_LABEL " ");
+    StrCatString(&ins, StrRead(&nil_label));
+    pos = listInsertAfter(code, pos, StrRead(&ins));
+    pos = listInsertAfter(code, pos, INS_PUSHS " nil@nil");
+    StrFillWith(&ins, INS_LABEL " ");
+    StrCatString(&ins, StrRead(&end_label));
+    pos = listInsertAfter(code, pos, StrRead(&ins));
+
+    StrDestroy(&ins);
+    StrDestroy(&nil_label);
+    StrDestroy(&end_label);
+    return pos;
+}
+
+/**
+ * Volanie má tvar "PUSHS <j>", "PUSHS <i>", "PUSHS <s>", "CALL substring", POPFRAME. Ak sú
+ * všetky argumenty konštanty, nahradí sa výsledkom. Ak sú konštanty indexy a podreťazec je
+ * krátky, nahradí sa kódom z inlineSubstring, ktorý kontroluje už len dĺžku reťazca.
+ *
+ * @brief Špecializuje volania vstavanej funkcie substring s konštantnými argumentmi
+ * @param code kód funkcie alebo hlavného tela programu
+ * @param fn názov funkcie pre nové náveštia, pre hlavné telo prázdny reťazec
+*/
+static void specializeSubstring(DLLstr_T *code, char *fn) {
+    int label_count = 0;
+    str_T result, ins;
+    StrInit(&result);
+    StrInit(&ins);
+    DLLstr_el_ptr el = code->first;
+    while (el != NULL) {
+        if (!insIs(el->string, INS_CALL) || strcmp(el->string + strlen(INS_CALL) + 1, "substring") != 0 ||
+            el->next == NULL || strcmp(el->next->string, INS_POPFRAME) != 0) {
+            el = el->next;
+            continue;
+        }
+        DLLstr_el_ptr push_s = el->prev;
+        DLLstr_el_ptr push_i = push_s != NULL ? push_s->prev : NULL;
+        DLLstr_el_ptr push_j = push_i != NULL ? push_i->prev : NULL;
+        if (push_j == NULL || !insIs(push_s->string, INS_PUSHS) || !insIs(push_i->string, INS_PUSHS) ||
+            !insIs(push_j->string, INS_PUSHS)) {
+            el = el->next;
+            continue;
+        }
+        char *s = push_s->string + strlen(INS_PUSHS) + 1;
+        long long i, j;
+        if (!intConstant(push_i->string + strlen(INS_PUSHS) + 1, &i) ||
+            !intConstant(push_j->string + strlen(INS_PUSHS) + 1, &j)) {
+            el = el->next;
+            continue;
+        }
+
+        DLLstr_el_ptr pos = push_j->prev;
+        bool invalid = i < 0 || j < 0 || i > j;
+        if (invalid || (strncmp(s, "string@", strlen("string@")) == 0 && foldSubstring(s, i, j, &result))) {
+            if (invalid) StrFillWith(&result, "nil@nil");
+            StrFillWith(&ins, INS_PUSHS " ");
+            StrCatString(&ins, StrRead(&result));
+            pos = listInsertAfter(code, pos, StrRead(&ins));
+        }
+        else if (j - i <= SUBSTR_INLINE_MAX) {
+            pos = inlineSubstring(code, pos, s, i, j, fn, &label_count);
+        }
+        else {
+            el = el->next;
+            continue;
+        }
+
+        // odstránenie pôvodných argumentov, CALL a POPFRAME
+        el = pos->next;
+        for (int k = 0; k < 5; k++) el = listDelete(code, el);
+    }
+    StrDestroy(&result);
+    StrDestroy(&ins);
+}
+
+/* ----------- PRESMEROVANIE SKOKOV ----------- */
+
+/**
+ * Blok len preposiela riadenie, ak obsahuje iba náveštie (za ktorým nasleduje ďalšie
+ * náveštie) alebo náveštie a nepodmienený skok.
+ *
+ * @brief Nájde blok, na ktorý sa riadenie z bloku nakoniec dostane cez preposielajúce bloky
+ * @return index cieľového bloku, pri cykle z preposielajúcich blokov pôvodný blok
+*/
+static int jumpDestination(cfg_T *cfg, int block) {
+    int dest = block;
+    for (int steps = 0; steps <= cfg->count; steps++) {
+        cfg_block_T *b = &(cfg->blocks[dest]);
+        bool forwards = insIs(b->first->string, INS_LABEL) && b->succ_count == 1 &&
+            (b->size == 1 || (b->size == 2 && insIs(b->last->string, INS_JUMP)));
+        if (!forwards) return dest;
+        dest = b->succ[0];
+    }
+    return block;
+}
+
+/**
+ * @brief Vráti náveštie na začiatku bloku
+ * @return názov náveštia alebo NULL, ak blok nezačína inštrukciou LABEL
+*/
+static char *blockLabel(cfg_T *cfg, int block) {
+    char *first = cfg->blocks[block].first->string;
+    return insIs(first, INS_LABEL) ? first + strlen(INS_LABEL) + 1 : NULL;
+}
+
+/**
+ * Skok na náveštie, za ktorým nasleduje ďalšie náveštie alebo nepodmienený skok, sa presmeruje
+ * priamo na cieľ celej reťaze. Susedné náveštia sa tak zlúčia do posledného z nich a pôvodné
+ * náveštia, na ktoré už nič neskáče, odstráni removeUnusedLabels.
+ *
+ * @brief Presmeruje skoky na ich konečný cieľ
+ * @return true ak bol presmerovaný aspoň jeden skok
+*/
+static bool threadJumps(DLLstr_T *code) {
+    cfg_T cfg;
+    cfgBuild(code, &cfg);
+
+    str_T ins;
+    StrInit(&ins);
+    ins_parts_T parts;
+    bool changed = false;
+    for (int i = 0; i < cfg.count; i++) {
+        DLLstr_el_ptr jump = cfg.blocks[i].last;
+        insSplit(jump->string, &parts);
+        char *target = jumpTarget(&parts);
+        // pri podmienenom skoku je cieľ skoku prvý nasledovník, pri JUMP jediný
+        char *succ_label = cfg.blocks[i].succ_count > 0 ? blockLabel(&cfg, cfg.blocks[i].succ[0]) : NULL;
+        if (target != NULL && succ_label != NULL && strcmp(succ_label, target) == 0) {
+            int dest = jumpDestination(&cfg, cfg.blocks[i].succ[0]);
+            char *label = blockLabel(&cfg, dest);
+            if (dest != cfg.blocks[i].succ[0] && label != NULL) {
+                StrFillWith(&ins, parts.part[0]);
+                StrAppend(&ins, ' ');
+                StrCatString(&ins, label);
+                for (int j = 2; j < parts.count; j++) {
+                    StrAppend(&ins, ' ');
+                    StrCatString(&ins, parts.part[j]);
+                }
+                listInsertAfter(code, jump, StrRead(&ins));
+                listDelete(code, jump);
+                changed = true;
+            }
+        }
+        insPartsFree(&parts);
+    }
+
+    StrDestroy(&ins);
+    cfgDestroy(&cfg);
+    return changed;
+}
+
+/* ----------- ODSTRÁNENIE NEDOSIAHNUTEĽNÉHO KÓDU ----------- */
+
+/**
+ * Prechádza graf toku riadenia od vstupného bloku. Bloky, na ktoré sa riadenie nemôže
+ * dostať, sa odstránia celé.
+ *
+ * @brief Odstráni inštrukcie, na ktoré sa riadenie programu nemôže dostať
+ * @return true ak bola odstránená aspoň jedna inštrukcia
+*/
+static bool removeUnreachable(DLLstr_T *code) {
+    cfg_T cfg;
+    cfgBuild(code, &cfg);
+    if (cfg.count == 0) return false;
+
+    bool *reachable = memAlloc(MEM_OPTIMIZER, cfg.count * sizeof(bool));
+    if (reachable == NULL) exit(COMPILER_ERROR);
+    cfgReachable(&cfg, reachable);
+
+    bool removed = false;
+    for (int i = 0; i < cfg.count; i++) {
+        if (reachable[i]) continue;
+        DLLstr_el_ptr el = cfg.blocks[i].first;
+        for (int j = 0; j < cfg.blocks[i].size; j++) el = listDelete(code, el);
+        removed = true;
+    }
+
+    memFree(MEM_OPTIMIZER, reachable);
+    cfgDestroy(&cfg);
+    return removed;
+}
+
+/**
+ * @brief Odstráni skoky na náveštie, ktoré nasleduje hneď za skokom (prípadne za ďalšími náveštiami)
+ * @return true ak bol odstránený aspoň jeden skok
+*/
+static bool removeJumpsToNext(DLLstr_T *code) {
+    bool removed = false;
+    DLLstr_el_ptr el = code->first;
+    while (el != NULL) {
+        if (insIs(el->string, INS_JUMP)) {
+            char *target = el->string + strlen(INS_JUMP) + 1;
+            DLLstr_el_ptr next = el->next;
+            while (next != NULL && insIs(next->string, INS_LABEL) &&
+                strcmp(next->string + strlen(INS_LABEL) + 1, target) != 0) next = next->next;
+            if (next != NULL && insIs(next->string, INS_LABEL)) {
+                el = listDelete(code, el);
+                removed = true;
+                continue;
+            }
+        }
+        el = el->next;
+    }
+    return removed;
+}
+
+/**
+ * Prvé náveštie kódu funkcie je cieľom volaní CALL, preto sa neodstraňuje.
+ * @brief Odstráni náveštia, na ktoré neskáče žiadna inštrukcia
+ * @param keep_first zachovať prvú inštrukciu kódu
+ * @return true ak bolo odstránené aspoň jedno náveštie
+*/
+static bool removeUnusedLabels(DLLstr_T *code, bool keep_first) {
+    DLLstr_T used;
+    DLLstr_Init(&used);
+    ins_parts_T parts;
+    for (DLLstr_el_ptr el = code->first; el != NULL; el = el->next) {
+        insSplit(el->string, &parts);
+        char *target = jumpTarget(&parts);
+        if (target != NULL) DLLstr_InsertLast(&used, target);
+        insPartsFree(&parts);
+    }
+
+    bool removed = false;
+    DLLstr_el_ptr el = keep_first && code->first != NULL ? code->first->next : code->first;
+    while (el != NULL) {
+        if (insIs(el->string, INS_LABEL)) {
+            char *label = el->string + strlen(INS_LABEL) + 1;
+            bool referenced = false;
+            for (DLLstr_el_ptr u = used.first; u != NULL && !referenced; u = u->next) {
+                referenced = strcmp(u->string, label) == 0;
+            }
+            if (!referenced) {
+                el = listDelete(code, el);
+                removed = true;
+                continue;
+            }
+        }
+        el = el->next;
+    }
+
+    DLLstr_Dispose(&used);
+    return removed;
+}
+
+/**
+ * Kroky sa opakujú, kým nastávajú zmeny. Napr. pri podmienke vyhodnotenej počas prekladu
+ * na true zostane z príkazu if len kód vetvy if bez skokov a náveští.
+ *
+ * @brief Presmeruje skoky na konečný cieľ, odstráni nedosiahnuteľný kód, zbytočné skoky a nepoužité náveštia
+ * @param code kód funkcie alebo hlavného tela programu
+ * @param is_fn kód patrí funkcii, jeho prvé náveštie je cieľom volaní
+*/
+static void removeDeadCode(DLLstr_T *code, bool is_fn) {
+    bool changed = true;
+    while (changed) {
+        changed = threadJumps(code);
+        changed |= removeUnreachable(code);
+        changed |= removeJumpsToNext(code);
+        changed |= removeUnusedLabels(code, is_fn);
+    }
+}
+
+/* ----------- PRESUN INVARIANTNÉHO KÓDU PRED CYKLUS ----------- */
+
+/** Maximálny počet zápisov do pomocných premenných v presúvanom príkaze */
+#define LICM_MAX_TMPS 16
+
+/** Maximálna dĺžka názvu pomocnej premennej vrátane '\0' */
+#define LICM_TMP_LEN 16
+
+/**
+ * Inštrukcie nemajú vedľajšie účinky a pri operandoch správneho typu nemôžu skončiť chybou
+ * (delenie sa vynecháva kvôli deleniu nulou).
+*/
+static char *licm_pure[] = {
+    INS_PUSHS, INS_POPS, INS_ADDS, INS_SUBS, INS_MULS, INS_LTS, INS_GTS, INS_EQS, "ANDS", "ORS", INS_NOTS,
+    INS_INT2FLOATS, "ADD", "SUB", "MUL", "LT", "GT", "EQ", "AND", "OR", "NOT", INS_CONCAT, INS_STRLEN, "INT2FLOAT",
+};
+
+/** Zásobníkové inštrukcie, ktoré vyberú dva operandy a vložia jeden výsledok */
+static char *licm_binary_stack[] = {
+    INS_ADDS, INS_SUBS, INS_MULS, INS_LTS, INS_GTS, INS_EQS, "ANDS", "ORS",
+};
+
+/**
+ * @brief Zistí, či je operačný kód v zozname
+*/
+static bool opcodeIn(char *opcode, char **list, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        if (strcmp(opcode, list[i]) == 0) return true;
+    }
+    return false;
+}
+
+/**
+ * @brief Zistí, či je operand premenná
+*/
+static bool isVariable(char *operand) {
+    return strncmp(operand, "GF@", 3) == 0 || strncmp(operand, "LF@", 3) == 0 || strncmp(operand, "TF@", 3) == 0;
+}
+
+/**
+ * @brief Zistí, či je operand pomocná premenná GF@!tmp*, ktorej hodnota sa neprenáša medzi príkazmi
+*/
+static bool isTmpVariable(char *operand) {
+    return strncmp(operand, "GF@!tmp", strlen("GF@!tmp")) == 0;
+}
+
+/**
+ * @brief Vráti premennú, do ktorej inštrukcia zapisuje, inak NULL
+*/
+static char *insWrittenVar(ins_parts_T *parts) {
+    if (parts->count < 2 || !isVariable(parts->part[1])) return NULL;
+    char *opcode = parts->part[0];
+    if (strcmp(opcode, INS_PUSHS) == 0 || strcmp(opcode, INS_WRITE) == 0 || strcmp(opcode, INS_EXIT) == 0) return NULL;
+    return parts->part[1];
+}
+
+/**
+ * Volaná funkcia môže zmeniť ľubovoľnú globálnu premennú, lokálne premenné volajúceho nie.
+ * @brief Spočíta inštrukcie v úseku kódu od first po last (vrátane), ktoré zapisujú do premennej
+ * @param has_call úsek obsahuje volanie funkcie
+ * @return počet zápisov, pri globálnej premennej a volaní funkcie v úseku aspoň 2
+*/
+static int countWrites(DLLstr_el_ptr first, DLLstr_el_ptr last, char *var, bool has_call) {
+    int writes = has_call && strncmp(var, "GF@", 3) == 0 && !isTmpVariable(var) ? 2 : 0;
+    ins_parts_T parts;
+    for (DLLstr_el_ptr el = first; el != NULL; el = el->next) {
+        insSplit(el->string, &parts);
+        char *written = insWrittenVar(&parts);
+        if (written != NULL && strcmp(written, var) == 0) writes++;
+        insPartsFree(&parts);
+        if (el == last) break;
+    }
+    return writes;
+}
+
+/**
+ * @brief Zistí, či sa premenná vyskytuje ako operand v úseku kódu od first po stop (bez stop)
+*/
+static bool isVarUsed(DLLstr_el_ptr first, DLLstr_el_ptr stop, char *var) {
+    ins_parts_T parts;
+    bool used = false;
+    for (DLLstr_el_ptr el = first; el != stop && el != NULL && !used; el = el->next) {
+        insSplit(el->string, &parts);
+        for (int i = 1; i < parts.count && !used; i++) used = strcmp(parts.part[i], var) == 0;
+        insPartsFree(&parts);
+    }
+    return used;
+}
+
+/**
+ * @brief Zistí, či je náveštie v zozname náveští cyklu
+*/
+static bool isLoopLabel(DLLstr_T *labels, char *label) {
+    for (DLLstr_el_ptr el = labels->first; el != NULL; el = el->next) {
+        if (strcmp(el->string, label) == 0) return true;
+    }
+    return false;
+}
+
+/**
+ * Príkaz "let v = výraz" má tvar postupnosti čistých inštrukcií, ktorá končí POPS v pri prázdnom
+ * zásobníku. Je invariantný, ak sa do v zapisuje v cykle len v tomto príkaze, v sa pred ním
+ * v cykle nečíta a ostatné premenné príkazu sa v cykle nemenia. Pomocné premenné GF@!tmp*
+ * musia byť zapísané skôr v tom istom príkaze.
+ *
+ * @brief Zistí, či je možné príkaz first..last presunúť pred cyklus
+ * @param label prvok s náveštím začiatku cyklu
+ * @param back prvok so skokom na začiatok cyklu
+ * @param has_call cyklus obsahuje volanie funkcie
+*/
+static bool isLoopInvariant(DLLstr_el_ptr first, DLLstr_el_ptr last, DLLstr_el_ptr label, DLLstr_el_ptr back,
+    bool has_call) {
+    char *target = last->string + strlen(INS_POPS) + 1;
+    if (countWrites(label, back, target, has_call) != 1 || isVarUsed(label, first, target)) return false;
+
+    char tmps[LICM_MAX_TMPS][LICM_TMP_LEN]; // pomocné premenné zapísané v príkaze
+    int tmp_count = 0;
+    bool invariant = true;
+    ins_parts_T parts;
+    for (DLLstr_el_ptr el = first; el != last && invariant; el = el->next) {
+        insSplit(el->string, &parts);
+        char *written = insWrittenVar(&parts);
+        for (int i = 1; i < parts.count && invariant; i++) {
+            char *operand = parts.part[i];
+            if (operand == written || !isVariable(operand)) continue;
+            if (isTmpVariable(operand)) {
+                invariant = false;
+                for (int j = 0; j < tmp_count && !invariant; j++) invariant = strcmp(tmps[j], operand) == 0;
+            }
+            else {
+                invariant = countWrites(label, back, operand, has_call) == 0;
+            }
+        }
+        if (written != NULL && isTmpVariable(written) && tmp_count < LICM_MAX_TMPS && strlen(written) < LICM_TMP_LEN) {
+            strcpy(tmps[tmp_count++], written);
+        }
+        else if (written != NULL) {
+            invariant = false;
+        }
+        insPartsFree(&parts);
+    }
+    return invariant;
+}
+
+/**
+ * Presúvajú sa len príkazy zo začiatku tela cyklu, ktoré sa vykonajú v každej iterácii skôr
+ * ako akákoľvek inštrukcia s vedľajším účinkom. Ak cyklus začína podmienkou, pred cyklus sa
+ * vloží jej kópia, aby sa presunuté príkazy nevykonali, keď sa telo cyklu nevykoná ani raz:
+ *
+ *      <podmienka>, JUMPIF* <koniec>       <podmienka>, JUMPIF* <koniec>
+ *      LABEL <cyklus>                      <invariantné príkazy>
+ *      <podmienka>, JUMPIF* <koniec>   =>  JUMP <telo>
+ *      <invariantné príkazy>               LABEL <cyklus>
+ *      <zvyšok tela>                       <podmienka>, JUMPIF* <koniec>
+ *      JUMP <cyklus>                       LABEL <telo>
+ *                                          <zvyšok tela>
+ *                                          JUMP <cyklus>
+ *
+ * @brief Presunie invariantné príkazy cyklu pred cyklus
+ * @param code kód funkcie alebo hlavného tela programu
+ * @param label prvok s náveštím začiatku cyklu
+ * @param back prvok so skokom na začiatok cyklu
+ * @param fn názov funkcie pre nové náveštie, pre hlavné telo prázdny reťazec
+ * @param label_count počítadlo náveští prechodu
+*/
+static void hoistFromLoop(DLLstr_T *code, DLLstr_el_ptr label, DLLstr_el_ptr back, char *fn, int *label_count) {
+    // náveštia v cykle a volania funkcií
+    DLLstr_T labels;
+    DLLstr_Init(&labels);
+    bool has_call = false;
+    ins_parts_T parts;
+    for (DLLstr_el_ptr el = label; el != back; el = el->next) {
+        if (insIs(el->string, INS_LABEL)) DLLstr_InsertLast(&labels, el->string + strlen(INS_LABEL) + 1);
+        if (insIs(el->string, INS_CALL)) has_call = true;
+    }
+
+    // do cyklu sa musí dať vstúpiť len cez jeho začiatok
+    bool single_entry = true;
+    for (DLLstr_el_ptr el = code->first; el != NULL && single_entry; el = el->next) {
+        if (el == label) {
+            el = back; // skoky v cykle
+            continue;
+        }
+        insSplit(el->string, &parts);
+        char *target = jumpTarget(&parts);
+        single_entry = target == NULL || !isLoopLabel(&labels, target);
+        insPartsFree(&parts);
+    }
+
+    // podmienka cyklu, čisté inštrukcie ukončené podmieneným skokom von z cyklu
+    DLLstr_el_ptr exit_jump = NULL;
+    for (DLLstr_el_ptr el = label->next; el != back && single_entry; el = el->next) {
+        insSplit(el->string, &parts);
+        char *target = jumpTarget(&parts);
+        bool pure = opcodeIn(parts.part[0], licm_pure, sizeof(licm_pure) / sizeof(char *));
+        if (target != NULL && !insIs(el->string, INS_JUMP) && !isLoopLabel(&labels, target)) exit_jump = el;
+        insPartsFree(&parts);
+        if (!pure) break;
+    }
+
+    // invariantné príkazy zo začiatku tela
+    DLLstr_T hoisted;
+    DLLstr_Init(&hoisted);
+    DLLstr_el_ptr el = exit_jump != NULL ? exit_jump->next : label->next;
+    DLLstr_el_ptr stmt = el;
+    int depth = 0;
+    while (el != back && single_entry) {
+        insSplit(el->string, &parts);
+        char *opcode = parts.part[0];
+        bool pure = opcodeIn(opcode, licm_pure, sizeof(licm_pure) / sizeof(char *));
+        if (strcmp(opcode, INS_PUSHS) == 0) depth++;
+        else if (strcmp(opcode, INS_POPS) == 0 ||
+            opcodeIn(opcode, licm_binary_stack, sizeof(licm_binary_stack) / sizeof(char *))) depth--;
+        bool stmt_end = strcmp(opcode, INS_POPS) == 0 && depth == 0 && !isTmpVariable(parts.part[1]);
+        insPartsFree(&parts);
+        if (!pure || depth < 0) break;
+
+        DLLstr_el_ptr next = el->next;
+        if (stmt_end) {
+            if (isLoopInvariant(stmt, el, label, back, has_call)) {
+                while (stmt != next) {
+                    DLLstr_InsertLast(&hoisted, stmt->string);
+                    stmt = listDelete(code, stmt);
+                }
+            }
+            stmt = next;
+        }
+        el = next;
+    }
+
+    if (hoisted.first != NULL) {
+        DLLstr_el_ptr pos = label->prev;
+        if (exit_jump != NULL) {
+            str_T body_label, ins;
+            StrInit(&body_label);
+            StrInit(&ins);
+            optUniqLabel(fn, "licm", label_count, &body_label);
+
+            for (DLLstr_el_ptr h = label->next; h != exit_jump->next; h = h->next) {
+                pos = listInsertAfter(code, pos, h->string);
+            }
+            for (DLLstr_el_ptr h = hoisted.first; h != NULL; h = h->next) pos = listInsertAfter(code, pos, h->string);
+            StrFillWith(&ins, INS_JUMP " ");
+            StrCatString(&ins, StrRead(&body_label));
+            listInsertAfter(code, pos, StrRead(&ins));
+            StrFillWith(&ins, INS_LABEL " ");
+            StrCatString(&ins, StrRead(&body_label));
+            listInsertAfter(code, exit_jump, StrRead(&ins));
+
+            StrDestroy(&body_label);
+            StrDestroy(&ins);
+        }
+        else {
+            for (DLLstr_el_ptr h = hoisted.first; h != NULL; h = h->next) pos = listInsertAfter(code, pos, h->string);
+        }
+    }
+
+    DLLstr_Dispose(&hoisted);
+    DLLstr_Dispose(&labels);
+}
+
+/**
+ * Cyklus je úsek kódu od "LABEL <l>" po "JUMP <l>", do ktorého sa vstupuje pokračovaním
+ * z predchádzajúcej inštrukcie. Vnorené cykly sa spracujú skôr ako vonkajšie, invariantný
+ * príkaz sa tak môže presunúť aj pred viacero cyklov.
+ *
+ * @brief Presunie invariantné príkazy pred všetky cykly v kóde
+ * @param code kód funkcie alebo hlavného tela programu
+ * @param fn názov funkcie pre nové náveštia, pre hlavné telo prázdny reťazec
+*/
+static void hoistLoopInvariants(DLLstr_T *code, char *fn) {
+    int label_count = 0;
+    for (DLLstr_el_ptr back = code->first; back != NULL; back = back->next) {
+        if (!insIs(back->string, INS_JUMP)) continue;
+        DLLstr_el_ptr label = findLabel(code, back->string + strlen(INS_JUMP) + 1);
+        if (label == NULL || label->prev == NULL || insIs(label->prev->string, INS_JUMP) ||
+            insIs(label->prev->string, INS_RETURN) || insIs(label->prev->string, INS_EXIT)) continue;
+        DLLstr_el_ptr el = label;
+        while (el != NULL && el != back) el = el->next;
+        if (el == back) hoistFromLoop(code, label, back, fn, &label_count);
+    }
+}
+
+/* ----------- ZDIEĽANIE PREMENNÝCH RÁMCA PODĽA ŽIVOTNOSTI ----------- */
+
+/**
+ * Porovnávacia funkcia qsort nemá parameter s kontextom, kľúč preto nesie aj názov premennej.
+ * @brief Položka zoradeného indexu lokálnych premenných
+*/
+typedef struct frame_var_key {
+    char *name;     ///< názov premennej (zdieľaný s frame_vars_T)
+    int index;      ///< index premennej v poradí DEFVAR
+} frame_var_key_T;
+
+/**
+ * @brief Lokálne premenné funkcie a ich vyhľadávanie podľa názvu
+*/
+typedef struct frame_vars {
+    char **names;               ///< názvy premenných v poradí ich DEFVAR
+    frame_var_key_T *sorted;    ///< premenné zoradené podľa názvu
+    int count;                  ///< počet premenných
+} frame_vars_T;
+
+/**
+ * @brief Porovnanie premenných podľa názvu pre qsort
+*/
+static int frameVarCmp(const void *a, const void *b) {
+    return strcmp(((const frame_var_key_T *)a)->name, ((const frame_var_key_T *)b)->name);
+}
+
+/**
+ * @brief Vráti index lokálnej premennej alebo -1, ak operand nie je lokálna premenná funkcie
+*/
+static int frameVarIndex(frame_vars_T *vars, char *operand) {
+    if (strncmp(operand, "LF@", 3) != 0) return -1;
+    int low = 0, high = vars->count - 1;
+    while (low <= high) {
+        int mid = (low + high) / 2;
+        int cmp = strcmp(operand, vars->sorted[mid].name);
+        if (cmp == 0) return vars->sorted[mid].index;
+        if (cmp < 0) high = mid - 1;
+        else low = mid + 1;
+    }
+    return -1;
+}
+
+/**
+ * @brief Určí lokálnu premennú zapísanú inštrukciou a lokálne premenné, ktoré inštrukcia číta
+ * @param written index zapísanej premennej alebo -1
+ * @param read indexy čítaných premenných, -1 pre ostatné operandy
+ * @return počet prvkov v read
+*/
+static int frameVarAccess(frame_vars_T *vars, ins_parts_T *parts, int *written, int *read) {
+    char *w = insWrittenVar(parts);
+    *written = w == NULL ? -1 : frameVarIndex(vars, w);
+    int count = 0;
+    for (int i = 1; i < parts->count; i++) {
+        if (parts->part[i] == w && strcmp(parts->part[0], "SETCHAR") != 0) continue; // SETCHAR aj číta
+        read[count++] = frameVarIndex(vars, parts->part[i]);
+    }
+    return count;
+}
+
+/**
+ * Premenné, ktoré nie sú súčasne živé, zdieľajú jednu premennú rámca. Živosť sa počíta nad
+ * grafom toku riadenia funkcie, premenná zapísaná inštrukciou koliduje so všetkými premennými
+ * živými za inštrukciou. Premenné sa v poradí ich DEFVAR priradia prvej voľnej premennej rámca,
+ * ktorá nesie názov prvej priradenej premennej. Všetky DEFVAR sa presunú za prológ funkcie.
+ *
+ * @brief Zníži počet premenných rámca funkcie zdieľaním premenných s neprekrývajúcou sa životnosťou
+ * @param code kód funkcie začínajúci prológom
+*/
+static void shareFrameVars(DLLstr_T *code) {
+    frame_vars_T vars = { NULL, NULL, 0 };
+    int capacity = 0;
+    for (DLLstr_el_ptr el = code->first; el != NULL; el = el->next) {
+        if (insIs(el->string, INS_DEFVAR) && strncmp(el->string + strlen(INS_DEFVAR) + 1, "LF@", 3) == 0) capacity++;
+    }
+    if (capacity < 2) return;
+    vars.names = memAlloc(MEM_OPTIMIZER, capacity * sizeof(char *));
+    vars.sorted = memAlloc(MEM_OPTIMIZER, capacity * sizeof(frame_var_key_T));
+    if (vars.names == NULL || vars.sorted == NULL) exit(COMPILER_ERROR);
+    for (DLLstr_el_ptr el = code->first; el != NULL; el = el->next) {
+        if (insIs(el->string, INS_DEFVAR) && strncmp(el->string + strlen(INS_DEFVAR) + 1, "LF@", 3) == 0) {
+            char *name = el->string + strlen(INS_DEFVAR) + 1;
+            vars.names[vars.count] = memAlloc(MEM_OPTIMIZER, strlen(name) + 1);
+            if (vars.names[vars.count] == NULL) exit(COMPILER_ERROR);
+            strcpy(vars.names[vars.count], name);
+            vars.sorted[vars.count] = (frame_var_key_T){ vars.names[vars.count], vars.count };
+            vars.count++;
+        }
+    }
+    qsort(vars.sorted, vars.count, sizeof(frame_var_key_T), frameVarCmp);
+
+    cfg_T cfg;
+    cfgBuild(code, &cfg);
+    int n = vars.count;
+    bool *use = memCalloc(MEM_OPTIMIZER, cfg.count * n, sizeof(bool));      // čítané pred zápisom v bloku
+    bool *def = memCalloc(MEM_OPTIMIZER, cfg.count * n, sizeof(bool));      // zapísané v bloku
+    bool *live_in = memCalloc(MEM_OPTIMIZER, cfg.count * n, sizeof(bool));
+    bool *live = memAlloc(MEM_OPTIMIZER, n * sizeof(bool));
+    bool *conflict = memCalloc(MEM_OPTIMIZER, n * n, sizeof(bool));
+    int *slot = memAlloc(MEM_OPTIMIZER, n * sizeof(int));        // premenná rámca priradená premennej
+    int *slot_first = memAlloc(MEM_OPTIMIZER, n * sizeof(int));  // prvá premenná priradená premennej rámca, určuje jej názov
+    if (use == NULL || def == NULL || live_in == NULL || live == NULL || conflict == NULL || slot == NULL ||
+        slot_first == NULL)
+        exit(COMPILER_ERROR);
+
+    ins_parts_T parts;
+    int read[INS_MAX_PARTS], written, read_count;
+    for (int b = 0; b < cfg.count; b++) {
+        DLLstr_el_ptr el = cfg.blocks[b].first;
+        for (int i = 0; i < cfg.blocks[b].size; i++, el = el->next) {
+            insSplit(el->string, &parts);
+            read_count = frameVarAccess(&vars, &parts, &written, read);
+            for (int r = 0; r < read_count; r++) {
+                if (read[r] != -1 && !def[b * n + read[r]]) use[b * n + read[r]] = true;
+            }
+            if (written != -1) def[b * n + written] = true;
+            insPartsFree(&parts);
+        }
+    }
+
+    // živé premenné na začiatku blokov, opakuje sa do ustálenia
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        for (int b = cfg.count - 1; b >= 0; b--) {
+            for (int v = 0; v < n; v++) {
+                bool out = false;
+                for (int s = 0; s < cfg.blocks[b].succ_count && !out; s++) out = live_in[cfg.blocks[b].succ[s] * n + v];
+                bool in = use[b * n + v] || (out && !def[b * n + v]);
+                if (in != live_in[b * n + v]) {
+                    live_in[b * n + v] = in;
+                    changed = true;
+                }
+            }
+        }
+    }
+
+    // kolízie, prechod blokom od konca
+    for (int b = 0; b < cfg.count; b++) {
+        for (int v = 0; v < n; v++) {
+            live[v] = false;
+            for (int s = 0; s < cfg.blocks[b].succ_count; s++) live[v] |= live_in[cfg.blocks[b].succ[s] * n + v];
+        }
+        for (DLLstr_el_ptr el = cfg.blocks[b].last; ; el = el->prev) {
+            insSplit(el->string, &parts);
+            read_count = frameVarAccess(&vars, &parts, &written, read);
+            if (written != -1) {
+                for (int v = 0; v < n; v++) {
+                    if (live[v] && v != written) conflict[written * n + v] = conflict[v * n + written] = true;
+                }
+                live[written] = false;
+            }
+            for (int r = 0; r < read_count; r++) {
+                if (read[r] != -1) live[read[r]] = true;
+            }
+            insPartsFree(&parts);
+            if (el == cfg.blocks[b].first) break;
+        }
+    }
+
+    // priradenie premenných rámca
+    int slots = 0;
+    for (int v = 0; v < n; v++) {
+        slot[v] = -1;
+        for (int s = 0; s < slots && slot[v] == -1; s++) {
+            bool is_free = true;
+            for (int u = 0; u < v && is_free; u++) is_free = slot[u] != s || !conflict[v * n + u];
+            if (is_free) slot[v] = s;
+        }
+        if (slot[v] == -1) {
+            slot_first[slots] = v;
+            slot[v] = slots++;
+        }
+    }
+
+    if (slots < n) {
+        str_T ins;
+        StrInit(&ins);
+        DLLstr_el_ptr prologue_end = code->first;
+        for (int i = 1; i < FN_PROLOGUE_LEN; i++) prologue_end = prologue_end->next;
+        DLLstr_el_ptr el = prologue_end->next;
+        while (el != NULL) {
+            insSplit(el->string, &parts);
+            if (strcmp(parts.part[0], INS_DEFVAR) == 0 && frameVarIndex(&vars, parts.part[1]) != -1) {
+                insPartsFree(&parts);
+                el = listDelete(code, el);
+                continue;
+            }
+            bool renamed = false;
+            StrFillWith(&ins, parts.part[0]);
+            for (int i = 1; i < parts.count; i++) {
+                int v = frameVarIndex(&vars, parts.part[i]);
+                StrAppend(&ins, ' ');
+                StrCatString(&ins, v == -1 ? parts.part[i] : vars.names[slot_first[slot[v]]]);
+                renamed |= v != -1 && slot_first[slot[v]] != v;
+            }
+            insPartsFree(&parts);
+            if (renamed) {
+                listInsertAfter(code, el, StrRead(&ins));
+                el = listDelete(code, el);
+            }
+            el = el->next;
+        }
+
+        DLLstr_el_ptr pos = prologue_end;
+        for (int s = 0; s < slots; s++) {
+            StrFillWith(&ins, INS_DEFVAR " ");
+            StrCatString(&ins, vars.names[slot_first[s]]);
+            pos = listInsertAfter(code, pos, StrRead(&ins));
+        }
+        StrDestroy(&ins);
+    }
+
+    memFree(MEM_OPTIMIZER, use);
+    memFree(MEM_OPTIMIZER, def);
+    memFree(MEM_OPTIMIZER, live_in);
+    memFree(MEM_OPTIMIZER, live);
+    memFree(MEM_OPTIMIZER, conflict);
+    memFree(MEM_OPTIMIZER, slot);
+    memFree(MEM_OPTIMIZER, slot_first);
+    cfgDestroy(&cfg);
+    for (int v = 0; v < n; v++) memFree(MEM_OPTIMIZER, vars.names[v]);
+    memFree(MEM_OPTIMIZER, vars.names);
+    memFree(MEM_OPTIMIZER, vars.sorted);
+}
+
+/* ----------- ODSTRÁNENIE ZBYTOČNÝCH CLEARS A POPFRAME ----------- */
+
+/** Hĺbka zásobníka nie je známa */
+#define STACK_UNKNOWN -1
+
+/** Blok ešte nebol spracovaný */
+#define STACK_UNVISITED -2
+
+/** Zásobníkové inštrukcie, ktoré vyberú dva operandy a vložia jeden výsledok */
+static char *stack_binary[] = {
+    INS_ADDS, INS_SUBS, INS_MULS, INS_DIVS, INS_IDIVS, INS_LTS, INS_GTS, INS_EQS, "ANDS", "ORS", "STRI2INTS",
+};
+
+/**
+ * @brief Vráti hĺbku dátového zásobníka po vykonaní inštrukcie
+ * @param depth hĺbka pred vykonaním inštrukcie alebo STACK_UNKNOWN
+*/
+static int stackDepthAfter(gen_T *gen, char *ins, int depth) {
+    if (insIs(ins, INS_CLEARS)) return 0;
+    if (depth == STACK_UNKNOWN) return STACK_UNKNOWN;
+
+    int after = depth;
+    if (insIs(ins, INS_PUSHS)) after++;
+    else if (insIs(ins, INS_POPS)) after--;
+    else if (insIs(ins, INS_JUMPIFEQS) || insIs(ins, INS_JUMPIFNEQS)) after -= 2;
+    else if (insIs(ins, INS_CALL)) {
+        int callee = genFnLookup(gen, ins + strlen(INS_CALL) + 1);
+        if (callee == -1 || gen->code_fns.array[callee].param_count < 0) return STACK_UNKNOWN;
+        after += (gen->code_fns.array[callee].returns_value ? 1 : 0) - gen->code_fns.array[callee].param_count;
+    }
+    else {
+        for (size_t i = 0; i < sizeof(stack_binary) / sizeof(char *); i++) {
+            if (insIs(ins, stack_binary[i])) after--;
+        }
+    }
+    return after < 0 ? STACK_UNKNOWN : after;
+}
+
+/**
+ * Hĺbka dátového zásobníka sa šíri grafom toku riadenia od vstupu do kódu. Volanie funkcie
+ * vyberie jej argumenty a void funkcia nezanechá na zásobníku nič, takže CLEARS za príkazom
+ * volania void funkcie alebo write sa vykonáva nad prázdnym zásobníkom.
+ *
+ * @brief Odstráni inštrukcie CLEARS, pred ktorými je dátový zásobník vždy prázdny
+ * @param code kód funkcie alebo hlavného tela programu
+ * @param entry_depth hĺbka zásobníka pri vstupe, pre funkciu počet jej argumentov
+*/
+static void removeRedundantClears(gen_T *gen, DLLstr_T *code, int entry_depth) {
+    cfg_T cfg;
+    cfgBuild(code, &cfg);
+    if (cfg.count == 0) return;
+
+    int *depth = memAlloc(MEM_OPTIMIZER, cfg.count * sizeof(int));
+    int *worklist = memAlloc(MEM_OPTIMIZER, cfg.count * sizeof(int));
+    bool *queued = memCalloc(MEM_OPTIMIZER, cfg.count, sizeof(bool));
+    if (depth == NULL || worklist == NULL || queued == NULL) exit(COMPILER_ERROR);
+    for (int b = 0; b < cfg.count; b++) depth[b] = STACK_UNVISITED;
+
+    // hĺbka zásobníka na začiatku blokov, pri rôznych hĺbkach z predchodcov nie je známa
+    int top = 0;
+    depth[0] = entry_depth;
+    worklist[top++] = 0;
+    queued[0] = true;
+    while (top > 0) {
+        int b = worklist[--top];
+        queued[b] = false;
+        int d = depth[b];
+        DLLstr_el_ptr el = cfg.blocks[b].first;
+        for (int i = 0; i < cfg.blocks[b].size; i++, el = el->next) d = stackDepthAfter(gen, el->string, d);
+        for (int s = 0; s < cfg.blocks[b].succ_count; s++) {
+            int succ = cfg.blocks[b].succ[s];
+            int merged = depth[succ] == STACK_UNVISITED || depth[succ] == d ? d : STACK_UNKNOWN;
+            if (merged == depth[succ]) continue;
+            depth[succ] = merged;
+            if (!queued[succ]) {
+                worklist[top++] = succ;
+                queued[succ] = true;
+            }
+        }
+    }
+
+    for (int b = 0; b < cfg.count; b++) {
+        int d = depth[b];
+        DLLstr_el_ptr el = cfg.blocks[b].first;
+        for (int i = 0; i < cfg.blocks[b].size; i++) {
+            DLLstr_el_ptr next = el->next;
+            if (d == 0 && strcmp(el->string, INS_CLEARS) == 0) listDelete(code, el);
+            else d = stackDepthAfter(gen, el->string, d);
+            el = next;
+        }
+    }
+
+    memFree(MEM_OPTIMIZER, depth);
+    memFree(MEM_OPTIMIZER, worklist);
+    memFree(MEM_OPTIMIZER, queued);
+    cfgDestroy(&cfg);
+}
+
+/**
+ * @brief Odstráni POPFRAME za každým volaním funkcie fn v kóde
+*/
+static void removeCallPopframes(DLLstr_T *code, char *fn) {
+    for (DLLstr_el_ptr el = code->first; el != NULL; el = el->next) {
+        if (insIs(el->string, INS_CALL) && strcmp(el->string + strlen(INS_CALL) + 1, fn) == 0 &&
+            el->next != NULL && strcmp(el->next->string, INS_POPFRAME) == 0) listDelete(code, el->next);
+    }
+}
+
+/**
+ * Funkcia bez parametrov, ktorá nepoužíva lokálny rámec, nemusí rámec vytvárať. Z jej prológu
+ * sa odstráni CREATEFRAME a PUSHFRAME, volajúci za ňou nevykonáva POPFRAME a rovnako ani
+ * skok na začiatok funkcie, ktorý nahradil rekurzívne volanie.
+ *
+ * @brief Odstráni vytváranie lokálneho rámca funkcie, ktorá ho nepotrebuje
+ * @param fn index funkcie v code_fns
+*/
+static void removeUnusedFrame(gen_T *gen, int fn) {
+    gen_fn_T *f = &(gen->code_fns.array[fn]);
+    if (f->param_count != 0 || !hasFnPrologue(f)) return;
+    for (DLLstr_el_ptr el = f->code.first; el != NULL; el = el->next) {
+        if (strstr(el->string, "LF@") != NULL) return;
+    }
+
+    listDelete(&(f->code), f->code.first->next); // CREATEFRAME
+    listDelete(&(f->code), f->code.first->next); // PUSHFRAME
+    for (DLLstr_el_ptr el = f->code.first; el != NULL; el = el->next) {
+        if (strcmp(el->string, INS_POPFRAME) == 0 && el->next != NULL && insIs(el->next->string, INS_JUMP) &&
+            strcmp(el->next->string + strlen(INS_JUMP) + 1, f->name) == 0) el = listDelete(&(f->code), el);
+    }
+    for (int i = 0; i < gen->code_fns.count; i++) removeCallPopframes(&(gen->code_fns.array[i].code), f->name);
+    removeCallPopframes(&gen->code_fn, f->name);
+    removeCallPopframes(&gen->code_main, f->name);
+}
+
+/* ----------- ZLUČOVANIE VÝPISOV ----------- */
+
+/**
+ * Reťazcová konštanta je už zakódovaná, celé číslo sa vypíše v desiatkovej sústave, bool ako
+ * true/false a nil ako prázdny reťazec. Desatinné čísla sa vypisujú formátom %a interpretu,
+ * preto sa nezlučujú.
+ *
+ * @brief Pripojí text, ktorý by vypísala inštrukcia "WRITE <operand>", k zakódovanému reťazcu
+ * @return false ak operand nie je konštanta, ktorej výpis je známy počas prekladu
+*/
+static bool appendWrittenText(char *operand, str_T *text) {
+    if (strncmp(operand, "string@", strlen("string@")) == 0) {
+        StrCatString(text, operand + strlen("string@"));
+    }
+    else if (strncmp(operand, "int@", strlen("int@")) == 0) {
+        char *end, number[32];
+        long long value = strtoll(operand + strlen("int@"), &end, 10);
+        if (*end != '\0') return false;
+        sprintf(number, "%lld", value);
+        StrCatString(text, number);
+    }
+    else if (strcmp(operand, "bool@true") == 0 || strcmp(operand, "bool@false") == 0) {
+        StrCatString(text, operand + strlen("bool@"));
+    }
+    else if (strcmp(operand, "nil@nil") != 0) {
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Susedné inštrukcie WRITE s konštantami (aj z rôznych príkazov write) sa nahradia jednou
+ * inštrukciou WRITE s reťazcovou konštantou. Medzi nimi nie je náveštie, vykonajú sa preto vždy spolu.
+ *
+ * @brief Zlúči susedné výpisy konštánt do jedného výpisu
+ * @param code kód funkcie alebo hlavného tela programu
+*/
+static void mergeWrites(DLLstr_T *code) {
+    str_T text, ins;
+    StrInit(&text);
+    StrInit(&ins);
+
+    DLLstr_el_ptr el = code->first;
+    while (el != NULL) {
+        DLLstr_el_ptr last = el;
+        StrFillWith(&text, "");
+        int merged = 0;
+        while (last != NULL && insIs(last->string, INS_WRITE) &&
+            appendWrittenText(last->string + strlen(INS_WRITE) + 1, &text)) {
+            merged++;
+            last = last->next;
+        }
+        if (merged < 2) {
+            el = el->next;
+            continue;
+        }
+
+        StrFillWith(&ins, INS_WRITE " string@");
+        StrCatString(&ins, StrRead(&text));
+        listInsertAfter(code, el->prev, StrRead(&ins));
+        for (int i = 0; i < merged; i++) el = listDelete(code, el);
+    }
+
+    StrDestroy(&text);
+    StrDestroy(&ins);
+}
+
+/* ----------- ODSTRÁNENIE NEVOLANÝCH FUNKCIÍ ----------- */
+
+/**
+ * @brief Označí všetky funkcie dosiahnuteľné inštrukciami CALL z daného kódu
+ * @param code prehľadávaný kód
+ * @param reachable pole dosiahnuteľných funkcií v code_fns
+*/
+static void markReachable(gen_T *gen, DLLstr_T *code, bool *reachable) {
+    for (DLLstr_el_ptr el = code->first; el != NULL; el = el->next) {
+        if (!insIs(el->string, INS_CALL)) continue;
+        int callee = genFnLookup(gen, el->string + strlen(INS_CALL) + 1);
+        if (callee != -1 && !reachable[callee]) {
+            reachable[callee] = true;
+            markReachable(gen, &(gen->code_fns.array[callee].code), reachable);
+        }
+    }
+}
+
+/**
+ * Graf volaní je daný inštrukciami CALL v kóde jednotlivých funkcií, preto zodpovedá kódu
+ * po ostatných optimalizáciách. Funkcie, ktorých všetky volania boli nahradené vloženým
+ * telom, sa tak tiež odstránia.
+ *
+ * @brief Odstráni kód funkcií, ktoré nie sú dosiahnuteľné z hlavného tela programu
+*/
+static void removeDeadFunctions(gen_T *gen) {
+    if (gen->code_fns.count == 0) return;
+
+    bool *reachable = memCalloc(MEM_OPTIMIZER, gen->code_fns.count, sizeof(bool));
+    if (reachable == NULL) exit(COMPILER_ERROR);
+
+    markReachable(gen, &gen->code_main, reachable);
+    markReachable(gen, &gen->code_fn, reachable);
+    for (int i = 0; i < gen->code_fns.count; i++) {
+        if (!reachable[i]) DLLstr_Dispose(&(gen->code_fns.array[i].code));
+    }
+
+    memFree(MEM_OPTIMIZER, reachable);
+}
+
+/* ----------- VEREJNÉ FUNKCIE ----------- */
+
+void optimizeFunction(gen_T *gen, int fn) {
+    gen_fn_T *f = &(gen->code_fns.array[fn]);
+    if (!hasFnPrologue(f)) return;
+    if (gen->options->tail_calls) eliminateTailCalls(f);
+    if (gen->options->substr_consts) specializeSubstring(&(f->code), f->name);
+    removeDeadCode(&(f->code), true);
+    if (gen->options->licm) hoistLoopInvariants(&(f->code), f->name);
+    if (gen->options->share_vars) shareFrameVars(&(f->code));
+    if (gen->options->call_cleanup && f->param_count >= 0) removeRedundantClears(gen, &(f->code), f->param_count);
+    if (gen->options->merge_writes) mergeWrites(&(f->code));
+}
+
+void optimizeCode(gen_T *gen) {
+    if (gen->options->inline_fns && gen->options->inline_limit > 0) inlineFunctions(gen);
+    if (gen->options->tail_calls) {
+        // až po vkladaní funkcií, skok na začiatok funkcie nie je možné vložiť do iného kódu
+        for (int i = 0; i < gen->code_fns.count; i++) {
+            if (hasFnPrologue(&(gen->code_fns.array[i]))) eliminateTailCalls(&(gen->code_fns.array[i]));
+        }
+    }
+    if (gen->options->substr_consts) {
+        for (int i = 0; i < gen->code_fns.count; i++) specializeSubstring(&(gen->code_fns.array[i].code), gen->code_fns.array[i].name);
+        specializeSubstring(&gen->code_main, "");
+    }
+    for (int i = 0; i < gen->code_fns.count; i++) {
+        if (hasFnPrologue(&(gen->code_fns.array[i]))) removeDeadCode(&(gen->code_fns.array[i].code), true);
+    }
+    removeDeadCode(&gen->code_main, false);
+    if (gen->options->licm) {
+        for (int i = 0; i < gen->code_fns.count; i++) {
+            if (hasFnPrologue(&(gen->code_fns.array[i]))) hoistLoopInvariants(&(gen->code_fns.array[i].code), gen->code_fns.array[i].name);
+        }
+        hoistLoopInvariants(&gen->code_main, "");
+    }
+    // volania z už vypísaných funkcií nie sú známe, všetky zostávajúce funkcie sa preto ponechajú
+    if (gen->options->dead_fns && !gen->options->stream) removeDeadFunctions(gen);
+    if (gen->options->share_vars) {
+        // až po odstránení nevolaných funkcií, ich kód je už prázdny
+        for (int i = 0; i < gen->code_fns.count; i++) {
+            if (hasFnPrologue(&(gen->code_fns.array[i]))) shareFrameVars(&(gen->code_fns.array[i].code));
+        }
+    }
+    if (gen->options->call_cleanup) {
+        // až na koniec, funkcia bez vytvárania rámca už nemá prológ, s ktorým počítajú ostatné kroky
+        for (int i = 0; i < gen->code_fns.count; i++) {
+            if (gen->code_fns.array[i].param_count >= 0) removeRedundantClears(gen, &(gen->code_fns.array[i].code), gen->code_fns.array[i].param_count);
+        }
+        removeRedundantClears(gen, &gen->code_main, 0);
+        // POPFRAME za volaniami v už vypísaných funkciách nie je možné odstrániť
+        if (!gen->options->stream) {
+            for (int i = 0; i < gen->code_fns.count; i++) removeUnusedFrame(gen, i);
+        }
+    }
+    if (gen->options->merge_writes) {
+        // až po odstránení CLEARS, výpisy susedných príkazov write sú potom za sebou
+        for (int i = 0; i < gen->code_fns.count; i++) mergeWrites(&(gen->code_fns.array[i].code));
+        mergeWrites(&gen->code_main);
+    }
+}
+
+/* Koniec súboru optimizer.c */
@@ -0,0 +1,45 @@
+/** Projekt IFJ2023
+ * @file optimizer.h
+ * @brief Optimalizácie nad vygenerovaným cieľovým kódom
+ * @author agent (agent@local)
+ * @date 19.10.2026
+ */
+
+#ifndef _OPTIMIZER_H_
+#define _OPTIMIZER_H_
+
+#include "generator.h"
+
+/**
+ * Optimalizácie pracujú nad kódom funkcií v gen->code_fns a hlavného tela programu v gen->code_main,
+ * preto sa volá až po spracovaní celého zdrojového programu. Ktoré optimalizácie sa
+ * vykonajú, určujú nastavenia gen->options (súbor options.h).
+ *
+ * Vykonávané optimalizácie:
+ *  - vkladanie tiel malých nerekurzívnych funkcií do miesta volania
+ *  - nahradenie rekurzívneho volania na konci funkcie skokom na jej začiatok
+ *  - vyhodnotenie alebo vloženie volaní substring s konštantnými argumentmi
+ *  - presmerovanie skokov na skoky a susedné náveštia priamo na konečný cieľ
+ *  - odstránenie nedosiahnuteľného kódu, zbytočných skokov a nepoužitých náveští
+ *  - presun invariantných príkazov cyklu pred cyklus
+ *  - odstránenie funkcií, ktoré nie sú volané z hlavného tela programu
+ *  - zdieľanie premenných rámca funkcie medzi premennými, ktoré nie sú súčasne živé
+ *  - odstránenie CLEARS nad prázdnym zásobníkom a rámca funkcií, ktoré ho nepoužívajú
+ *  - zlúčenie susedných výpisov konštánt do jednej inštrukcie WRITE
+ *
+ * @brief Vykoná optimalizácie nad celým vygenerovaným kódom
+*/
+void optimizeCode(gen_T *gen);
+
+/**
+ * Používa sa pri postupnom výpise (gen->options->stream), keď sa kód funkcie vypíše hneď po skončení
+ * jej definície. Vykonajú sa len optimalizácie, ktoré menia iba kód samotnej funkcie, vkladanie
+ * funkcií, odstraňovanie nevolaných funkcií a nepoužitých rámcov sa nevykoná.
+ *
+ * @brief Vykoná optimalizácie nad kódom jednej dokončenej funkcie
+ * @param fn index funkcie v gen->code_fns
+*/
+void optimizeFunction(gen_T *gen, int fn);
+
+#endif // ifndef _OPTIMIZER_H_
+/* Koniec súboru optimizer.h */
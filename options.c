@@ -0,0 +1,173 @@
+/** Projekt IFJ2023
+ * @file options.c
+ * @brief Prepínače prekladača zadané na príkazovom riadku
+ * @author agent (agent@local)
+ * @date 19.10.2026
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "options.h"
+
+const options_T options_default = {
+    .inline_fns = true,
+    .inline_limit = OPT_DEFAULT_INLINE_LIMIT,
+    .tail_calls = true,
+    .substr_consts = true,
+    .substr_doubling_min = OPT_DEFAULT_SUBSTR_DOUBLING_MIN,
+    .licm = true,
+    .dead_fns = true,
+    .share_vars = true,
+    .call_cleanup = true,
+    .merge_writes = true,
+    .short_names = false,
+    .name_map = NULL,
+    .stream = false,
+    .dump_cfg = false,
+    .batch = NULL,
+    .server = NULL,
+    .cache = NULL,
+    .cache_limit = OPT_DEFAULT_CACHE_LIMIT,
+    .cache_stats = false,
+    .incremental = false,
+    .time_report = 0,
+    .alloc_stats = false,
+    .no_arena = false,
+    .jobs = 0,
+};
+
+/**
+ * @brief Prečíta nezáporné celé číslo z hodnoty prepínača
+ * @return true ak je hodnota platné číslo, inak false
+*/
+static bool parseOptionNumber(char *value, int *result) {
+    char *end;
+    long number = strtol(value, &end, 10);
+    if (*value == '\0' || *end != '\0' || number < 0 || number > 1000000) return false;
+    *result = (int)number;
+    return true;
+}
+
+bool parseOptions(int argc, char **argv, options_T *options) {
+    for (int i = 1; i < argc; i++) {
+        char *arg = argv[i];
+        if (strcmp(arg, "--no-inline") == 0) {
+            options->inline_fns = false;
+        }
+        else if (strcmp(arg, "--no-tail-calls") == 0) {
+            options->tail_calls = false;
+        }
+        else if (strcmp(arg, "--no-substr-consts") == 0) {
+            options->substr_consts = false;
+        }
+        else if (strcmp(arg, "--no-licm") == 0) {
+            options->licm = false;
+        }
+        else if (strcmp(arg, "--no-dead-fns") == 0) {
+            options->dead_fns = false;
+        }
+        else if (strcmp(arg, "--no-share-vars") == 0) {
+            options->share_vars = false;
+        }
+        else if (strcmp(arg, "--no-call-cleanup") == 0) {
+            options->call_cleanup = false;
+        }
+        else if (strcmp(arg, "--no-merge-writes") == 0) {
+            options->merge_writes = false;
+        }
+        else if (strcmp(arg, "--short-names") == 0) {
+            options->short_names = true;
+        }
+        else if (strncmp(arg, "--name-map=", strlen("--name-map=")) == 0 && arg[strlen("--name-map=")] != '\0') {
+            options->short_names = true;
+            options->name_map = arg + strlen("--name-map=");
+        }
+        else if (strcmp(arg, "--stream") == 0) {
+            options->stream = true;
+        }
+        else if (strcmp(arg, "--dump-cfg") == 0) {
+            options->dump_cfg = true;
+        }
+        else if (strncmp(arg, "--batch=", strlen("--batch=")) == 0 && arg[strlen("--batch=")] != '\0') {
+            options->batch = arg + strlen("--batch=");
+        }
+        else if (strncmp(arg, "--server=", strlen("--server=")) == 0 && arg[strlen("--server=")] != '\0') {
+            options->server = arg + strlen("--server=");
+        }
+        else if (strncmp(arg, "--cache=", strlen("--cache=")) == 0 && arg[strlen("--cache=")] != '\0') {
+            options->cache = arg + strlen("--cache=");
+        }
+        else if (strcmp(arg, "--cache-stats") == 0) {
+            options->cache_stats = true;
+        }
+        else if (strcmp(arg, "--incremental") == 0) {
+            options->incremental = true;
+        }
+        else if (strcmp(arg, "--time-report") == 0) {
+            options->time_report = OPT_TIME_REPORT_TEXT;
+        }
+        else if (strcmp(arg, "--time-report=json") == 0) {
+            options->time_report = OPT_TIME_REPORT_JSON;
+        }
+        else if (strcmp(arg, "--alloc-stats") == 0) {
+            options->alloc_stats = true;
+        }
+        else if (strcmp(arg, "--no-arena") == 0) {
+            options->no_arena = true;
+        }
+        else if (strncmp(arg, "--inline-limit=", strlen("--inline-limit=")) == 0) {
+            if (!parseOptionNumber(arg + strlen("--inline-limit="), &options->inline_limit)) {
+                fprintf(stderr, "invalid value of option: %s\n", arg);
+                return false;
+            }
+        }
+        else if (strncmp(arg, "--substr-doubling-min=", strlen("--substr-doubling-min=")) == 0) {
+            if (!parseOptionNumber(arg + strlen("--substr-doubling-min="), &options->substr_doubling_min)) {
+                fprintf(stderr, "invalid value of option: %s\n", arg);
+                return false;
+            }
+        }
+        else if (strncmp(arg, "--cache-limit=", strlen("--cache-limit=")) == 0) {
+            if (!parseOptionNumber(arg + strlen("--cache-limit="), &options->cache_limit)) {
+                fprintf(stderr, "invalid value of option: %s\n", arg);
+                return false;
+            }
+        }
+        else if (strncmp(arg, "--jobs=", strlen("--jobs=")) == 0) {
+            if (!parseOptionNumber(arg + strlen("--jobs="), &options->jobs)) {
+                fprintf(stderr, "invalid value of option: %s\n", arg);
+                return false;
+            }
+        }
+        else {
+            fprintf(stderr, "unknown option: %s\n", arg);
+            return false;
+        }
+    }
+    if (options->stream && (options->short_names || options->dump_cfg)) {
+        // oba potrebujú kód celého programu naraz
+        fprintf(stderr, "option --stream cannot be combined with --short-names, --name-map or --dump-cfg\n");
+        return false;
+    }
+    if (options->batch != NULL && options->name_map != NULL) {
+        // všetky preklady by zapisovali do jedného súboru
+        fprintf(stderr, "option --batch cannot be combined with --name-map\n");
+        return false;
+    }
+    if (options->cache_stats && options->cache == NULL) {
+        fprintf(stderr, "option --cache-stats requires --cache\n");
+        return false;
+    }
+    if (options->incremental && options->cache == NULL) {
+        fprintf(stderr, "option --incremental requires --cache\n");
+        return false;
+    }
+    if (options->server != NULL && (options->batch != NULL || options->name_map != NULL)) {
+        fprintf(stderr, "option --server cannot be combined with --batch or --name-map\n");
+        return false;
+    }
+    return true;
+}
+
+/* Koniec súboru options.c */
@@ -0,0 +1,105 @@
+/** Projekt IFJ2023
+ * @file options.h
+ * @brief Prepínače prekladača zadané na príkazovom riadku
+ * @author agent (agent@local)
+ * @date 19.10.2026
+ */
+
+#ifndef _OPTIONS_H_
+#define _OPTIONS_H_
+
+#include <stdbool.h>
+
+/** Predvolená maximálna veľkosť tela funkcie (počet inštrukcií), ktorú je možné vložiť do miesta volania */
+#define OPT_DEFAULT_INLINE_LIMIT 20
+
+/** Predvolená dĺžka podreťazca, od ktorej ho substring skladá zdvojovaním (v ic23int sa vyplatí až pri ~10^5 znakoch) */
+#define OPT_DEFAULT_SUBSTR_DOUBLING_MIN 131072
+
+/** Predvolená maximálna veľkosť prekladovej cache v KiB */
+#define OPT_DEFAULT_CACHE_LIMIT 65536
+
+/** Formáty výpisu času fáz prekladu (--time-report) */
+#define OPT_TIME_REPORT_TEXT 1
+#define OPT_TIME_REPORT_JSON 2
+
+/**
+ * @brief Nastavenia prekladača
+*/
+typedef struct options {
+    bool inline_fns;    ///< vkladať telá malých funkcií do miesta volania (--no-inline vypína)
+    int inline_limit;   ///< maximálny počet inštrukcií tela vkladanej funkcie (--inline-limit=N)
+    bool tail_calls;    ///< nahrádzať rekurzívne volania na konci funkcie skokom (--no-tail-calls vypína)
+    bool substr_consts; ///< špecializovať volania substring s konštantnými indexmi (--no-substr-consts vypína)
+    int substr_doubling_min; ///< od tejto dĺžky skladať podreťazec v substring zdvojovaním (--substr-doubling-min=N)
+    bool licm;          ///< presúvať invariantné príkazy pred cyklus (--no-licm vypína)
+    bool dead_fns;      ///< odstraňovať funkcie nevolané z hlavného tela programu (--no-dead-fns vypína)
+    bool share_vars;    ///< zdieľať premenné rámca medzi premennými s neprekrývajúcou sa životnosťou (--no-share-vars vypína)
+    bool call_cleanup;  ///< odstraňovať zbytočné CLEARS a POPFRAME za volaniami (--no-call-cleanup vypína)
+    bool merge_writes;  ///< zlučovať susedné výpisy konštánt (--no-merge-writes vypína)
+    bool short_names;   ///< vypisovať krátke názvy premenných a náveští (--short-names)
+    char *name_map;     ///< súbor s tabuľkou krátkych a pôvodných názvov alebo NULL (--name-map=FILE)
+    bool stream;        ///< vypisovať kód funkcie hneď po skončení jej definície (--stream)
+    bool dump_cfg;      ///< namiesto kódu vypísať graf toku riadenia vo formáte Graphviz (--dump-cfg)
+    char *batch;        ///< súbor so zoznamom programov pre dávkový preklad alebo NULL (--batch=LIST)
+    char *server;       ///< cesta k UNIX socketu prekladového servera alebo NULL (--server=SOCKET)
+    char *cache;        ///< adresár prekladovej cache alebo NULL (--cache=DIR)
+    int cache_limit;    ///< maximálna veľkosť cache v KiB (--cache-limit=N)
+    bool cache_stats;   ///< po preklade vypísať úspešnosť cache na stderr (--cache-stats)
+    bool incremental;   ///< ukladať do cache aj kód jednotlivých funkcií (--incremental)
+    int time_report;    ///< po preklade vypísať čas fáz, 0 alebo OPT_TIME_REPORT_XXX (--time-report[=json])
+    bool alloc_stats;   ///< po preklade vypísať alokácie pamäte podľa podsystémov (--alloc-stats)
+    bool no_arena;      ///< alokovať priamo cez malloc namiesto arény prekladu (--no-arena)
+    int jobs;           ///< počet vlákien dávkového prekladu alebo servera, 0 je počet procesorov (--jobs=N)
+} options_T;
+
+/**
+ * @brief Predvolené nastavenia prekladača
+*/
+extern const options_T options_default;
+
+/**
+ * Podporované prepínače:
+ *      --no-inline         nevkladať telá funkcií do miesta volania
+ *      --inline-limit=N    vkladať len funkcie, ktorých telo má najviac N inštrukcií
+ *      --no-tail-calls     ponechať rekurzívne volania na konci funkcie
+ *      --no-substr-consts  ponechať volanie funkcie substring aj pri konštantných argumentoch
+ *      --substr-doubling-min=N  skladať podreťazce dlhšie ako N znakov zdvojovaním
+ *      --no-licm           nepresúvať invariantné príkazy pred cyklus
+ *      --no-dead-fns       ponechať aj funkcie, ktoré nie sú volané z hlavného tela programu
+ *      --no-share-vars     ponechať každej lokálnej premennej vlastnú premennú rámca
+ *      --no-call-cleanup   ponechať CLEARS a POPFRAME za každým volaním funkcie
+ *      --no-merge-writes   vypisovať každý argument write samostatnou inštrukciou
+ *      --short-names       vypisovať krátke názvy premenných a náveští
+ *      --name-map=FILE     zapísať do FILE tabuľku krátkych a pôvodných názvov (zapína --short-names)
+ *      --stream            vypisovať kód funkcie hneď po skončení jej definície, nedá sa
+ *                          kombinovať s --short-names, --name-map ani --dump-cfg
+ *      --dump-cfg          namiesto cieľového kódu vypísať graf toku riadenia (Graphviz)
+ *      --batch=LIST        preložiť programy zo zoznamu LIST (riadky "<vstup> <výstup>", "-" je stdin)
+ *                          namiesto stdin, nedá sa kombinovať s --name-map
+ *      --server=SOCKET     spustiť prekladový server na UNIX sockete SOCKET, ostatné prepínače
+ *                          sú predvolené pre požiadavky, nedá sa kombinovať s --batch ani --name-map
+ *      --cache=DIR         opakovane neprekladať rovnaký program s rovnakými prepínačmi, výsledky
+ *                          ukladať do adresára DIR, nepoužije sa s --stream ani --name-map
+ *      --cache-limit=N     pri prekročení N KiB odstrániť najdlhšie nepoužité výsledky z cache
+ *      --cache-stats       po preklade vypísať na stderr počet zásahov cache (vyžaduje --cache)
+ *      --incremental       ukladať do cache aj kód funkcií, pri zmene programu sa preložia len zmenené
+ *                          funkcie a funkcie, ktoré od nich závisia (vyžaduje --cache)
+ *      --time-report       po preklade vypísať s hláseniami chýb čas fáz prekladu a počítadlá
+ *      --time-report=json  to isté v jednom riadku vo formáte JSON
+ *      --alloc-stats       po preklade vypísať s hláseniami chýb počet, veľkosť a špičku alokácií
+ *                          pamäte podľa podsystémov prekladača
+ *      --no-arena          alokovať a uvoľňovať každý blok cez malloc a free namiesto arény prekladu,
+ *                          napr. pre kontrolu pamäte nástrojmi valgrind a sanitizer
+ *      --jobs=N            dávkový preklad alebo server v N vláknach, predvolene podľa počtu procesorov
+ *
+ * @brief Spracuje argumenty príkazového riadku a zapíše ich do options
+ * @param argc počet argumentov
+ * @param argv argumenty, argv[0] je názov programu
+ * @param options nastavenia, ktoré argumenty menia (napr. kópia options_default)
+ * @return true v prípade úspechu, inak false (chyba je vypísaná na stderr)
+*/
+bool parseOptions(int argc, char **argv, options_T *options);
+
+#endif // ifndef _OPTIONS_H_
+/* Koniec súboru options.h */
@@ -5,48 +5,65 @@
  * @date 22.11.2023
  */
 
+#define _POSIX_C_SOURCE 200809L // fdopen
+
 #include "parser.h"
 #include "logErr.h"
 #include "exp.h"
 #include "generator.h"
+#include "optimizer.h"
+#include "options.h"
+#include "cfg.h"
+#include "names.h"
+#include "writer.h"
+#include "incremental.h"
+#include "report.h"
+#include "memory.h"
+#include <unistd.h>
+
+/** Veľkosť bloku TS v bajtoch (hlavička a pole symbolov) */
+#define SYMT_BLOCK_SIZE (sizeof(TSBlock_T) + sizeof(TSData_T*) * SYMTABLE_MAX_SIZE)
 
-token_T* tkn = NULL;
-
-SymTab_T symt;
-
-bool parser_inside_fn_def = false;
-
-/**
- * @brief Názov funkcie, ktorej definícia je práve spracovávaná
-*/
-static str_T fn_name;
+/* ----------- PRIVATE FUNKCIE ----------- */
 
 /**
- * @brief Zoznam mien funkcií, pri ktorých treba na konci sémantickej analýzy skontrovať, či boli definované.
+ * @brief Vypíše povinnú hlavičku cieľového kódu, pokiaľ ešte nebola vypísaná
 */
-static DLLstr_T check_def_fns;
+static void printHeader(ctx_T *ctx) {
+    if (ctx->header_printed) return;
+    ctx->header_printed = true;
+    writerInit(&ctx->out, ctx->output_fd);
 
-/**
- * @brief Indikuje, či sa parser nachádza vo vnútri cykla.
-*/
-static bool parser_inside_loop = false;
+    writerLine(&ctx->out, ".IFJcode23"); // povinná hlavička
 
-/**
- * @brief Meno náveštia na najvrchnejší cyklus
-*/
-static str_T first_loop_label;
+    // pomocné premenné
+    writerLine(&ctx->out, "DEFVAR " VAR_TMP1);
+    writerLine(&ctx->out, "DEFVAR " VAR_TMP2);
+    writerLine(&ctx->out, "DEFVAR " VAR_TMP3);
 
-/**
- * @brief Zoznam premenných,, ktoré musia byť dekalrované pred prvým nespracovaným cyklom
-*/
-static DLLstr_T variables_declared_inside_loop;
+    writerLine(&ctx->out, "JUMP !main"); // skok do hlavného tela programu
+}
 
 /**
- * @brief Bola volaná vstavaná funkcia "substring".
+ * Kód dokončených funkcií sa už nemení, po optimalizácii sa preto vypíše a uvoľní. Vo výsledku
+ * ostane prázdny zoznam ako pri odstránenej funkcii. Funkcie sa vypisujú v poradí code_fns,
+ * rovnako ako pri výpise celého programu.
+ *
+ * @brief Vypíše kód ešte nevypísaných funkcií pri postupnom výpise
 */
-static bool bifn_substring_called = false;
-
-/* ----------- PRIVATE FUNKCIE ----------- */
+static void streamFunctions(ctx_T *ctx) {
+    for (int fn = ctx->streamed_fns; fn < ctx->gen.code_fns.count; fn++) {
+        REPORT_ENTER(REPORT_OPTIMIZER);
+        optimizeFunction(&ctx->gen, fn);
+        REPORT_LEAVE();
+        REPORT_ENTER(REPORT_OUTPUT);
+        printHeader(ctx);
+        writerList(&ctx->out, &(ctx->gen.code_fns.array[fn].code));
+        DLLstr_Dispose(&(ctx->gen.code_fns.array[fn].code));
+        REPORT_LEAVE();
+    }
+    ctx->streamed_fns = ctx->gen.code_fns.count;
+}
 
 /**
  * @brief Prekonvertuje dátový typ zahrňujúci nil na dátový typ nezahrňujúci nil.
@@ -152,7 +169,7 @@ bool shouldPopFrame(char* function_name) {
  * @param par_names Pole názvov parametrov
  * @param par_types Reťazec označujúci dátové typy parametrov
 */
-void loadSingleBIFnSig(char* name, size_t count_par, char ret_type,
+void loadSingleBIFnSig(ctx_T *ctx, char* name, size_t count_par, char ret_type,
     char* par_names[], char* par_types) {
 
     TSData_T* fn = SymTabCreateElement(name);
@@ -167,29 +184,29 @@ void loadSingleBIFnSig(char* name, size_t count_par, char ret_type,
     }
     StrFillWith(&(fn->sig->par_types), par_types);
 
-    SymTabInsertGlobal(&symt, fn);
+    SymTabInsertGlobal(&ctx->symt, fn);
 }
 
 
 /**
  * @brief Načíta signatúry vstavaných funkcií do TS
 */
-void loadBuiltInFunctionSignatures() {
-    loadSingleBIFnSig("readString", 0, SYM_TYPE_STRING_NIL, NULL, "");
-    loadSingleBIFnSig("readInt", 0, SYM_TYPE_INT_NIL, NULL, "");
-    loadSingleBIFnSig("readDouble", 0, SYM_TYPE_DOUBLE_NIL, NULL, "");
+void loadBuiltInFunctionSignatures(ctx_T *ctx) {
+    loadSingleBIFnSig(ctx, "readString", 0, SYM_TYPE_STRING_NIL, NULL, "");
+    loadSingleBIFnSig(ctx, "readInt", 0, SYM_TYPE_INT_NIL, NULL, "");
+    loadSingleBIFnSig(ctx, "readDouble", 0, SYM_TYPE_DOUBLE_NIL, NULL, "");
 
-    loadSingleBIFnSig("write", 0, SYM_TYPE_VOID, NULL, "");
+    loadSingleBIFnSig(ctx, "write", 0, SYM_TYPE_VOID, NULL, "");
 
     char* empty_param[] = { "_" };
-    loadSingleBIFnSig("Int2Double", 1, SYM_TYPE_DOUBLE, empty_param, "i");
-    loadSingleBIFnSig("Double2Int", 1, SYM_TYPE_INT, empty_param, "d");
-    loadSingleBIFnSig("length", 1, SYM_TYPE_INT, empty_param, "s");
-    loadSingleBIFnSig("ord", 1, SYM_TYPE_INT, empty_param, "s");
-    loadSingleBIFnSig("chr", 1, SYM_TYPE_STRING, empty_param, "i");
+    loadSingleBIFnSig(ctx, "Int2Double", 1, SYM_TYPE_DOUBLE, empty_param, "i");
+    loadSingleBIFnSig(ctx, "Double2Int", 1, SYM_TYPE_INT, empty_param, "d");
+    loadSingleBIFnSig(ctx, "length", 1, SYM_TYPE_INT, empty_param, "s");
+    loadSingleBIFnSig(ctx, "ord", 1, SYM_TYPE_INT, empty_param, "s");
+    loadSingleBIFnSig(ctx, "chr", 1, SYM_TYPE_STRING, empty_param, "i");
 
     char* substring_par_names[] = { "of", "startingAt", "endingBefore" };
-    loadSingleBIFnSig("substring", 3, SYM_TYPE_STRING_NIL, substring_par_names, "sii");
+    loadSingleBIFnSig(ctx, "substring", 3, SYM_TYPE_STRING_NIL, substring_par_names, "sii");
 }
 
 /**
@@ -203,12 +220,12 @@ void loadBuiltInFunctionSignatures() {
  *          {"write", "Int2Double", "Double2Int", "length", "ord", "chr"},
  *          inak false
 */
-bool biFnGenInstruction(char* bif_name, char* arg_codename) {
+bool biFnGenInstruction(ctx_T *ctx, char* bif_name, char* arg_codename) {
     if (strcmp(bif_name, "write") == 0) {
         /*
             WRITE <arg>
         */
-        genCode(INS_WRITE, arg_codename, NULL, NULL);
+        genCode(&ctx->gen, INS_WRITE, arg_codename, NULL, NULL);
         return true;
     }
     else if (strcmp(bif_name, "Int2Double") == 0) {
@@ -216,8 +233,8 @@ bool biFnGenInstruction(char* bif_name, char* arg_codename) {
             PUSHS <arg>
             INT2FLOATS
         */
-        genCode(INS_PUSHS, arg_codename, NULL, NULL);
-        genCode(INS_INT2FLOATS, NULL, NULL, NULL);
+        genCode(&ctx->gen, INS_PUSHS, arg_codename, NULL, NULL);
+        genCode(&ctx->gen, INS_INT2FLOATS, NULL, NULL, NULL);
         return true;
     }
     else if (strcmp(bif_name, "Double2Int") == 0) {
@@ -225,8 +242,8 @@ bool biFnGenInstruction(char* bif_name, char* arg_codename) {
             PUSHS <arg>
             FLOAT2INTS
         */
-        genCode(INS_PUSHS, arg_codename, NULL, NULL);
-        genCode(INS_FLOAT2INTS, NULL, NULL, NULL);
+        genCode(&ctx->gen, INS_PUSHS, arg_codename, NULL, NULL);
+        genCode(&ctx->gen, INS_FLOAT2INTS, NULL, NULL, NULL);
         return true;
     }
     else if (strcmp(bif_name, "length") == 0) {
@@ -234,8 +251,8 @@ bool biFnGenInstruction(char* bif_name, char* arg_codename) {
             STRLEN GF@!tmp1 <arg>
             PUSHS GF@!tmp1
         */
-        genCode(INS_STRLEN, VAR_TMP1, arg_codename, NULL);
-        genCode(INS_PUSHS, VAR_TMP1, NULL, NULL);
+        genCode(&ctx->gen, INS_STRLEN, VAR_TMP1, arg_codename, NULL);
+        genCode(&ctx->gen, INS_PUSHS, VAR_TMP1, NULL, NULL);
         return true;
     }
     else if (strcmp(bif_name, "ord") == 0) {
@@ -249,14 +266,14 @@ bool biFnGenInstruction(char* bif_name, char* arg_codename) {
         */
         str_T label_empty_string;
         StrInit(&label_empty_string);
-        genUniqLabel(StrRead(&fn_name), "ord", &label_empty_string);
-
-        genCode(INS_MOVE, VAR_TMP1, "int@0", NULL);
-        genCode(INS_STRLEN, VAR_TMP2, arg_codename, NULL);
-        genCode("JUMPIFEQ", StrRead(&label_empty_string), VAR_TMP2, "int@0");
-        genCode("STRI2INT", VAR_TMP1, arg_codename, "int@0");
-        genCode(INS_LABEL, StrRead(&label_empty_string), NULL, NULL);
-        genCode(INS_PUSHS, VAR_TMP1, NULL, NULL);
+        genUniqLabel(&ctx->gen, StrRead(&ctx->fn_name), "ord", &label_empty_string);
+
+        genCode(&ctx->gen, INS_MOVE, VAR_TMP1, "int@0", NULL);
+        genCode(&ctx->gen, INS_STRLEN, VAR_TMP2, arg_codename, NULL);
+        genCode(&ctx->gen, "JUMPIFEQ", StrRead(&label_empty_string), VAR_TMP2, "int@0");
+        genCode(&ctx->gen, "STRI2INT", VAR_TMP1, arg_codename, "int@0");
+        genCode(&ctx->gen, INS_LABEL, StrRead(&label_empty_string), NULL, NULL);
+        genCode(&ctx->gen, INS_PUSHS, VAR_TMP1, NULL, NULL);
         StrDestroy(&label_empty_string);
         return true;
     }
@@ -265,8 +282,8 @@ bool biFnGenInstruction(char* bif_name, char* arg_codename) {
             PUSHS <arg>
             INT2CHARS
         */
-        genCode(INS_PUSHS, arg_codename, NULL, NULL);
-        genCode("INT2CHARS", NULL, NULL, NULL);
+        genCode(&ctx->gen, INS_PUSHS, arg_codename, NULL, NULL);
+        genCode(&ctx->gen, "INT2CHARS", NULL, NULL, NULL);
         return true;
     }
     return false;
@@ -280,14 +297,14 @@ bool biFnGenInstruction(char* bif_name, char* arg_codename) {
  * @brief Pravidlo pre spracovanie dátového typu, zapíše do data_type spracovaný typ
  * @return 0 v prípade úspechu, inak číslo chyby
 */
-int parseDataType(char* data_type) {
+int parseDataType(ctx_T *ctx, char* data_type) {
     /*
         39. <TYPE> -> Integer <QUESTMARK>
         40. <TYPE> -> Double <QUESTMARK>
         41. <TYPE> -> String <QUESTMARK>
     */
-    TRY_OR_EXIT(nextToken());
-    switch (tkn->type)
+    TRY_OR_EXIT(nextToken(ctx));
+    switch (ctx->tkn->type)
     {
     case INT_TYPE:
         *data_type = SYM_TYPE_INT;
@@ -299,7 +316,7 @@ int parseDataType(char* data_type) {
         *data_type = SYM_TYPE_STRING;
         break;
     default:
-        logErrSyntax(tkn, "data type");
+        logErrSyntax(&ctx->log, ctx->tkn, "data type");
         return SYN_ERR;
         break;
     }
@@ -307,8 +324,8 @@ int parseDataType(char* data_type) {
         42. <QUESTMARK> -> ?
         43. <QUESTMARK> -> €
     */
-    TRY_OR_EXIT(nextToken());
-    if (tkn->type == QUEST_MARK) { // dátový typ zahrnǔjúci nil: <TYP>?
+    TRY_OR_EXIT(nextToken(ctx));
+    if (ctx->tkn->type == QUEST_MARK) { // dátový typ zahrnǔjúci nil: <TYP>?
         switch (*data_type)
         {
         case SYM_TYPE_INT:
@@ -325,7 +342,7 @@ int parseDataType(char* data_type) {
         }
     }
     else { // za dátovým typom nebol token '?', token je vrátený naspäť
-        saveToken();
+        saveToken(ctx);
     }
     return COMPILATION_OK;
 }
@@ -340,24 +357,24 @@ int parseDataType(char* data_type) {
  * @param term_codename Tvar termu v cieľovom kóde
  * @return 0 v prípade úspechu, inak číslo chyby
 */
-int parseTerm(char* term_type, str_T* term_codename) {
-    switch (tkn->type)
+int parseTerm(ctx_T *ctx, char* term_type, str_T* term_codename) {
+    switch (ctx->tkn->type)
     {
     case ID:; // premenná
-        TSData_T* variable = SymTabLookup(&symt, StrRead(&(tkn->atr)));
+        TSData_T* variable = SymTabLookup(&ctx->symt, StrRead(&(ctx->tkn->atr)));
         if (variable == NULL) {
             // v TS nie je záznam s daným identifikátorom => nedeklarovaná premenná
-            logErrSemantic(tkn, "%s was undeclared", StrRead(&(tkn->atr)));
+            logErrSemantic(&ctx->log, ctx->tkn, "%s was undeclared", StrRead(&(ctx->tkn->atr)));
             return SEM_ERR_UNDEF;
         }
         if (variable->type == SYM_TYPE_FUNC) {
             // identifikátor označuje funkciu
-            logErrSemantic(tkn, "%s is a function", StrRead(&(tkn->atr)));
+            logErrSemantic(&ctx->log, ctx->tkn, "%s is a function", StrRead(&(ctx->tkn->atr)));
             return SEM_ERR_RETURN;
         }
         if (!(variable->init)) {
             // premenná nebola inicializovaná
-            logErrSemantic(tkn, "%s was uninitialized", StrRead(&(tkn->atr)));
+            logErrSemantic(&ctx->log, ctx->tkn, "%s was uninitialized", StrRead(&(ctx->tkn->atr)));
             return SEM_ERR_UNDEF;
         }
         *term_type = variable->type;
@@ -365,15 +382,15 @@ int parseTerm(char* term_type, str_T* term_codename) {
         break;
     case INT_CONST: // konštanty
         *term_type = SYM_TYPE_INT;
-        genConstVal(INT_CONST, StrRead(&(tkn->atr)), term_codename);
+        genConstVal(INT_CONST, StrRead(&(ctx->tkn->atr)), term_codename);
         break;
     case DOUBLE_CONST:
         *term_type = SYM_TYPE_DOUBLE;
-        genConstVal(DOUBLE_CONST, StrRead(&(tkn->atr)), term_codename);
+        genConstVal(DOUBLE_CONST, StrRead(&(ctx->tkn->atr)), term_codename);
         break;
     case STRING_CONST:
         *term_type = SYM_TYPE_STRING;
-        genConstVal(STRING_CONST, StrRead(&(tkn->atr)), term_codename);
+        genConstVal(STRING_CONST, StrRead(&(ctx->tkn->atr)), term_codename);
         break;
     case NIL:
         *term_type = SYM_TYPE_NIL;
@@ -381,7 +398,7 @@ int parseTerm(char* term_type, str_T* term_codename) {
         break;
     default:
         // nie je to term
-        logErrSyntax(tkn, "term");
+        logErrSyntax(&ctx->log, ctx->tkn, "term");
         return SYN_ERR;
         break;
     }
@@ -404,7 +421,7 @@ int parseTerm(char* term_type, str_T* term_codename) {
  * @param used_args Získané argumenty funkcie v cieľovom kóde.
  * @return 0 v prípade úspechu, inak číslo chyby
 */
-int parseFnArg(str_T* par_name, char* term_type, char* bif_name,
+int parseFnArg(ctx_T *ctx, str_T* par_name, char* term_type, char* bif_name,
     DLLstr_T* used_args) {
     /*
         18. <PAR_IN> -> id : term
@@ -412,43 +429,43 @@ int parseFnArg(str_T* par_name, char* term_type, char* bif_name,
     */
     str_T arg_codename; // Tvar argumentu v cieľovom kóde
     StrInit(&arg_codename);
-    StrFillWith(par_name, StrRead(&(tkn->atr)));
-    switch (tkn->type)
+    StrFillWith(par_name, StrRead(&(ctx->tkn->atr)));
+    switch (ctx->tkn->type)
     {
     case ID:
-        TRY_OR_EXIT(nextToken());
-        if (tkn->type == COMMA || tkn->type == BRT_RND_R) {
+        TRY_OR_EXIT(nextToken(ctx));
+        if (ctx->tkn->type == COMMA || ctx->tkn->type == BRT_RND_R) {
             // 19. <PAR_IN> -> term
             // term je premenná a funkcia nemá názov pre parameter
-            TSData_T* variable = SymTabLookup(&symt, StrRead(par_name));
+            TSData_T* variable = SymTabLookup(&ctx->symt, StrRead(par_name));
             if (variable == NULL) {
                 // v TS nie je záznam s daným identifikátorom => nedeklarovaná premenná
-                logErrSemantic(tkn, "%s was undeclared", StrRead(par_name));
+                logErrSemantic(&ctx->log, ctx->tkn, "%s was undeclared", StrRead(par_name));
                 return SEM_ERR_UNDEF;
             }
             if (variable->type == SYM_TYPE_FUNC) {
                 // identifikátor označuje funkciu
-                logErrSemantic(tkn, "%s is a function", StrRead(par_name));
+                logErrSemantic(&ctx->log, ctx->tkn, "%s is a function", StrRead(par_name));
                 return SEM_ERR_RETURN;
             }
             if (!(variable->init)) {
                 // premenná nebola inicializovaná
-                logErrSemantic(tkn, "%s was uninitialized", StrRead(par_name));
+                logErrSemantic(&ctx->log, ctx->tkn, "%s was uninitialized", StrRead(par_name));
                 return SEM_ERR_UNDEF;
             }
             *term_type = variable->type;
             StrFillWith(par_name, "_"); // funkcia má vynechaný názvo pre parameter
             StrFillWith(&arg_codename, StrRead(&(variable->codename)));
-            saveToken();
+            saveToken(ctx);
         }
         // inak prvý token musí byť názov parametra
-        else if (tkn->type == COLON) {
+        else if (ctx->tkn->type == COLON) {
             // 18. <PAR_IN> -> id : term
-            TRY_OR_EXIT(nextToken());
-            TRY_OR_EXIT(parseTerm(term_type, &arg_codename));
+            TRY_OR_EXIT(nextToken(ctx));
+            TRY_OR_EXIT(parseTerm(ctx, term_type, &arg_codename));
         }
         else {
-            logErrSyntax(tkn, "',' or ':'");
+            logErrSyntax(&ctx->log, ctx->tkn, "',' or ':'");
             return SYN_ERR;
         }
         break;
@@ -457,15 +474,15 @@ int parseFnArg(str_T* par_name, char* term_type, char* bif_name,
     case STRING_CONST:
     case NIL:
         StrFillWith(par_name, "_");
-        TRY_OR_EXIT(parseTerm(term_type, &arg_codename));
+        TRY_OR_EXIT(parseTerm(ctx, term_type, &arg_codename));
         break;
     default:
-        logErrSyntax(tkn, "parameter identifier or term");
+        logErrSyntax(&ctx->log, ctx->tkn, "parameter identifier or term");
         return SYN_ERR;
     }
 
     // generácia inštrukcií pre niektoré vstavané funkcie
-    if (!biFnGenInstruction(bif_name == NULL ? "" : bif_name, StrRead(&arg_codename))) {
+    if (!biFnGenInstruction(ctx, bif_name == NULL ? "" : bif_name, StrRead(&arg_codename))) {
         // inak je predaný identifikátor argumentu v cieľovom kóde naspäť volajúcemu
         DLLstr_InsertLast(used_args, StrRead(&arg_codename));
     }
@@ -487,7 +504,7 @@ int parseFnArg(str_T* par_name, char* term_type, char* bif_name,
  * @param used_args Získané argumenty funkcie v cieľovom kóde.
  * @return 0 v prípade úspechu, inak číslo chyby
 */
-int parseFnCallArgs(bool defined, bool called_before, func_sig_T* sig,
+int parseFnCallArgs(ctx_T *ctx, bool defined, bool called_before, func_sig_T* sig,
     char* bif_name, DLLstr_T* used_args) {
     /*
         13. <PAR_LIST> -> id : term <PAR_IN_NEXT>
@@ -512,22 +529,22 @@ int parseFnCallArgs(bool defined, bool called_before, func_sig_T* sig,
         if (strcmp(bif_name, "write") == 0) write_function = true;
     }
 
-    TRY_OR_EXIT(nextToken());
-    while (tkn->type != BRT_RND_R)
+    TRY_OR_EXIT(nextToken(ctx));
+    while (ctx->tkn->type != BRT_RND_R)
         // ( argument1, argument2, ..., argumentN )
     {
         // pred každým argumentom, okrem prvého, musí nasledovať čiarka
         if (loaded_args > 0) { // ??? dat pred kontrolu poctu argumentov ???
-            if (tkn->type != COMMA) {
-                logErrSyntax(tkn, "comma");
+            if (ctx->tkn->type != COMMA) {
+                logErrSyntax(&ctx->log, ctx->tkn, "comma");
                 return SYN_ERR;
             }
-            TRY_OR_EXIT(nextToken());
+            TRY_OR_EXIT(nextToken(ctx));
         }
         else {
             /*  Táto extra syntaktická kokontrola zaručuje vyššiu prioritu
                 syntaktickej chyby pred sémantickou. */
-            switch (tkn->type)
+            switch (ctx->tkn->type)
             {
             case ID:
             case INT_CONST:
@@ -536,7 +553,7 @@ int parseFnCallArgs(bool defined, bool called_before, func_sig_T* sig,
             case NIL:
                 break;
             default:
-                logErrSyntax(tkn, "term or parameter name");
+                logErrSyntax(&ctx->log, ctx->tkn, "term or parameter name");
                 return SYN_ERR;
                 break;
             }
@@ -545,31 +562,31 @@ int parseFnCallArgs(bool defined, bool called_before, func_sig_T* sig,
         // kontrola, či nie je funkcia volaná s viacerými argumentami
         if ((defined || called_before) && !write_function) {
             if (strlen(StrRead(&(sig->par_types))) <= loaded_args) {
-                logErrSemantic(tkn, "too many arguments in function call");
+                logErrSemantic(&ctx->log, ctx->tkn, "too many arguments in function call");
                 return SEM_ERR_FUNC;
             }
         }
 
-        TRY_OR_EXIT(parseFnArg(&par_name, &arg_type, bif_name, used_args)); // príkaz na spracovanie jedného argumentu
+        TRY_OR_EXIT(parseFnArg(ctx, &par_name, &arg_type, bif_name, used_args)); // príkaz na spracovanie jedného argumentu
 
         // sémantická kontrola argumentu
         if (write_function) { // všetky argumenty vo funkcií "write" nemajú názov parametra
             if (strcmp(StrRead(&par_name), "_") != 0) {
-                logErrSemantic(tkn, "function \"write\" does not use parameter names");
+                logErrSemantic(&ctx->log, ctx->tkn, "function \"write\" does not use parameter names");
                 return SEM_ERR_FUNC;
             }
         }
         else if (defined || called_before) {
             // kontrola dátového typu argumentu s predpisom funkcie
             if (!isCompatibleAssign(StrRead(&(sig->par_types))[loaded_args], arg_type)) {
-                logErrSemantic(tkn, "different type in function call");
+                logErrSemantic(&ctx->log, ctx->tkn, "different type in function call");
                 return SEM_ERR_FUNC;
             }
 
             // kontrola názvu parametra s predpisom
             DLLstr_GetValue(&(sig->par_names), &temp);
             if (strcmp(StrRead(&par_name), StrRead(&temp)) != 0) {
-                logErrSemantic(tkn, "different parameter name");
+                logErrSemantic(&ctx->log, ctx->tkn, "different parameter name");
                 return SEM_ERR_FUNC;
             }
         }
@@ -600,14 +617,14 @@ int parseFnCallArgs(bool defined, bool called_before, func_sig_T* sig,
             DLLstr_InsertLast(&(sig->par_names), StrRead(&par_name));
         }
 
-        TRY_OR_EXIT(nextToken());
+        TRY_OR_EXIT(nextToken(ctx));
         loaded_args++;
         DLLstr_Next(&(sig->par_names));
     }
 
     if ((defined || called_before) && !write_function) { // kontrola, či bola funkcia zavolaná so správnym počtom argumentov
         if (strlen(StrRead(&(sig->par_types))) != loaded_args) {
-            logErrSemantic(tkn, "different count of arguments in function call");
+            logErrSemantic(&ctx->log, ctx->tkn, "different count of arguments in function call");
             return SEM_ERR_FUNC;
         }
     }
@@ -630,19 +647,19 @@ int parseFnCallArgs(bool defined, bool called_before, func_sig_T* sig,
  * @param result_type návratový typ funkcie
  * @return 0 v prípade úspechu, inak číslo chyby
 */
-int parseFnCall(char* result_type) {
+int parseFnCall(ctx_T *ctx, char* result_type) {
     // id ( <PAR_LIST> )
 
     // získanie informácii o funkcii z TS
-    TSData_T* fn = SymTabLookupGlobal(&symt, StrRead(&(tkn->atr)));
+    TSData_T* fn = SymTabLookupGlobal(&ctx->symt, StrRead(&(ctx->tkn->atr)));
     bool called_before = fn != NULL;
     bool built_in_fn = false;   // funkcia je vstavaná
     if (fn == NULL) // funkcia nebola definovaná a ani volaná
     {
         // vytvorí sa o nej záznam do TS
-        fn = SymTabCreateElement(StrRead(&(tkn->atr)));
+        fn = SymTabCreateElement(StrRead(&(ctx->tkn->atr)));
         if (fn == NULL) return COMPILER_ERROR;
-        StrFillWith(&(fn->codename), StrRead(&(tkn->atr)));
+        StrFillWith(&(fn->codename), StrRead(&(ctx->tkn->atr)));
         fn->type = SYM_TYPE_FUNC;
         fn->sig = SymTabCreateFuncSig();
         if (fn->sig == NULL) {
@@ -651,48 +668,48 @@ int parseFnCall(char* result_type) {
         fn->sig->ret_type = SYM_TYPE_UNKNOWN;
         fn->let = false;
         fn->init = false;
-        SymTabInsertGlobal(&symt, fn);
+        SymTabInsertGlobal(&ctx->symt, fn);
 
         // poznačiť názov funkcie do zoznamu nedefinovaných funkcií, pre kontrolu na koniec
-        DLLstr_InsertLast(&check_def_fns, fn->id);
+        DLLstr_InsertLast(&ctx->check_def_fns, fn->id);
     }
     else {
         built_in_fn = isBuiltInFunction(fn->id);
     }
 
-    TRY_OR_EXIT(nextToken());
-    if (tkn->type != BRT_RND_L) {
-        logErrSyntax(tkn, "'('");
+    TRY_OR_EXIT(nextToken(ctx));
+    if (ctx->tkn->type != BRT_RND_L) {
+        logErrSyntax(&ctx->log, ctx->tkn, "'('");
         return SYN_ERR;
     }
 
     // spracovanie argumentov funkcie
     DLLstr_T args_codenames;
     DLLstr_Init(&args_codenames);
-    TRY_OR_EXIT(parseFnCallArgs(fn->init, called_before, fn->sig, built_in_fn ? fn->id : NULL, &args_codenames));
+    TRY_OR_EXIT(parseFnCallArgs(ctx, fn->init, called_before, fn->sig, built_in_fn ? fn->id : NULL, &args_codenames));
 
     if (strcmp(fn->id, "substring") == 0) {
         // bude potrebné vložiť kód funkcie substring
-        bifn_substring_called = true;
+        ctx->bifn_substring_called = true;
     }
 
     // Generovanie cieľového kódu
     if (!built_in_fn || strcmp(fn->id, "substring") == 0) {
         // generovanie vloženia argumentov na zásobník a volania funkcie
-        genFnCall(fn->id, &args_codenames);
+        genFnCall(&ctx->gen, fn->id, &args_codenames);
     }
     // špeciálne prípady generovania kódu pri týchto vstavaných funkciách
     else if (strcmp(fn->id, "readString") == 0) {
-        genCode(INS_READ, VAR_TMP1, "string", NULL);
-        genCode(INS_PUSHS, VAR_TMP1, NULL, NULL);
+        genCode(&ctx->gen, INS_READ, VAR_TMP1, "string", NULL);
+        genCode(&ctx->gen, INS_PUSHS, VAR_TMP1, NULL, NULL);
     }
     else if (strcmp(fn->id, "readInt") == 0) {
-        genCode(INS_READ, VAR_TMP1, "int", NULL);
-        genCode(INS_PUSHS, VAR_TMP1, NULL, NULL);
+        genCode(&ctx->gen, INS_READ, VAR_TMP1, "int", NULL);
+        genCode(&ctx->gen, INS_PUSHS, VAR_TMP1, NULL, NULL);
     }
     else if (strcmp(fn->id, "readDouble") == 0) {
-        genCode(INS_READ, VAR_TMP1, "float", NULL);
-        genCode(INS_PUSHS, VAR_TMP1, NULL, NULL);
+        genCode(&ctx->gen, INS_READ, VAR_TMP1, "float", NULL);
+        genCode(&ctx->gen, INS_PUSHS, VAR_TMP1, NULL, NULL);
     }
     DLLstr_Dispose(&args_codenames);
 
@@ -716,11 +733,11 @@ int parseFnCall(char* result_type) {
  * @param target_type Dátový typ premennej, ktorej je hodnota priraďovaná. Slúži len pre potreby implicitnej konverzie literálu Int na Double
  * @return 0 v prípade úspechu, inak číslo chyby
 */
-int parseAssignment(char* result_type, char* result_codename, char target_type) {
+int parseAssignment(ctx_T *ctx, char* result_type, char* result_codename, char target_type) {
     bool possible_implicit_int_conversion = false;
-    TRY_OR_EXIT(nextToken());
+    TRY_OR_EXIT(nextToken(ctx));
     token_T* first_tkn;
-    switch (tkn->type) // treba rozlíšiť volanie funkcie a výraz
+    switch (ctx->tkn->type) // treba rozlíšiť volanie funkcie a výraz
     {
     case BRT_RND_L:
     case INT_CONST:
@@ -728,32 +745,32 @@ int parseAssignment(char* result_type, char* result_codename, char target_type)
     case STRING_CONST:
     case NIL:
         // 8. <ASSIGN> -> exp
-        TRY_OR_EXIT(parseExpression(result_type, &possible_implicit_int_conversion));
+        TRY_OR_EXIT(parseExpression(ctx, result_type, &possible_implicit_int_conversion));
         break;
     case ID:
         /*  Identifikátor môže byť názov premennej vo výraze alebo názov funkcie.
             Preto sa treba pozrieť na ďalší token. Ak ďalší token je ľavá zátvorka,
             potom je to volanie funkcie.
         */
-        first_tkn = tkn;
-        tkn = NULL; // ! Bez tohoto by bol first_tkn uvoľnený v nextToken().
-        TRY_OR_EXIT(nextToken());
-        if (tkn->type == BRT_RND_L) {
+        first_tkn = ctx->tkn;
+        ctx->tkn = NULL; // ! Bez tohoto by bol first_tkn uvoľnený v nextToken().
+        TRY_OR_EXIT(nextToken(ctx));
+        if (ctx->tkn->type == BRT_RND_L) {
             // 9. <ASSIGN> -> id ( <PAR_LIST> )
-            saveToken();
-            tkn = first_tkn;
-            bool popframe = shouldPopFrame(StrRead(&(tkn->atr))); // je potrebné zbaviť sa lokálneho rámca vytvoreného volanou funkciou
-            TRY_OR_EXIT(parseFnCall(result_type));
-            if (popframe) genCode(INS_POPFRAME, NULL, NULL, NULL);
+            saveToken(ctx);
+            ctx->tkn = first_tkn;
+            bool popframe = shouldPopFrame(StrRead(&(ctx->tkn->atr))); // je potrebné zbaviť sa lokálneho rámca vytvoreného volanou funkciou
+            TRY_OR_EXIT(parseFnCall(ctx, result_type));
+            if (popframe) genCode(&ctx->gen, INS_POPFRAME, NULL, NULL, NULL);
         }
         else {
-            saveToken();
-            tkn = first_tkn;
-            TRY_OR_EXIT(parseExpression(result_type, &possible_implicit_int_conversion));
+            saveToken(ctx);
+            ctx->tkn = first_tkn;
+            TRY_OR_EXIT(parseExpression(ctx, result_type, &possible_implicit_int_conversion));
         }
         break;
     default:
-        logErrSyntax(tkn, "assignment or function call");
+        logErrSyntax(&ctx->log, ctx->tkn, "assignment or function call");
         return SYN_ERR;
     }
 
@@ -761,15 +778,44 @@ int parseAssignment(char* result_type, char* result_codename, char target_type)
         (target_type == SYM_TYPE_DOUBLE || target_type == SYM_TYPE_DOUBLE_NIL)) {
         // vo výraze sú celočíselné literály a výsledok má byť priradený do dátového typu Double(?)
         // musí byť vykonaná implicitná konverzia
-        genCode(INS_INT2FLOATS, NULL, NULL, NULL);
+        genCode(&ctx->gen, INS_INT2FLOATS, NULL, NULL, NULL);
         *result_type = SYM_TYPE_DOUBLE;
     }
 
-    genCode(INS_POPS, result_codename, NULL, NULL); // priradenie výsledku do premennej
+    genCode(&ctx->gen, INS_POPS, result_codename, NULL, NULL); // priradenie výsledku do premennej
 
     return COMPILATION_OK;
 }
 
+/**
+ * Premennú let už nie je možné zmeniť. Ak bola inicializovaná konštantou rovnakého dátového
+ * typu (posledné vygenerované inštrukcie sú PUSHS <konštanta>, POPS <premenná>), v ďalšom kóde
+ * sa namiesto premennej použije priamo konštanta. Výrazy s ňou sa tak vyhodnotia už počas prekladu.
+ *
+ * @brief Nahradí identifikátor premennej let v cieľovom kóde jej konštantnou hodnotou
+ * @param variable práve inicializovaná premenná
+*/
+void propagateLetConstant(ctx_T *ctx, TSData_T* variable) {
+    static char* prefixes[] = { "int@", "float@", "string@" };
+    static char types[] = { SYM_TYPE_INT, SYM_TYPE_DOUBLE, SYM_TYPE_STRING };
+
+    DLLstr_T* code = ctx->gen.inside_fn_def ? &ctx->gen.code_fn : &ctx->gen.code_main;
+    if (code->last == NULL || code->last->prev == NULL) return;
+    char* pop = code->last->string;
+    char* push = code->last->prev->string;
+    if (strncmp(pop, INS_POPS " ", strlen(INS_POPS) + 1) != 0 ||
+        strcmp(pop + strlen(INS_POPS) + 1, StrRead(&(variable->codename))) != 0) return;
+    if (strncmp(push, INS_PUSHS " ", strlen(INS_PUSHS) + 1) != 0) return;
+
+    char* value = push + strlen(INS_PUSHS) + 1;
+    for (size_t i = 0; i < sizeof(types); i++) {
+        if (variable->type == types[i] && strncmp(value, prefixes[i], strlen(prefixes[i])) == 0) {
+            StrFillWith(&(variable->codename), value);
+            return;
+        }
+    }
+}
+
 /**
  * Stav tkn:
  *  - pred volaním: LET alebo VAR
@@ -782,29 +828,29 @@ int parseAssignment(char* result_type, char* result_codename, char target_type)
  * @brief Pravidlo pre spracovanie deklarácie/definície premennej
  * @return 0 v prípade úspechu, inak číslo chyby
 */
-int parseVariableDecl() {
+int parseVariableDecl(ctx_T *ctx) {
     /*
         2. <STAT> -> let id <DEF_VAR> <STAT>
         3. <STAT> -> var id <DEF_VAR> <STAT>
     */
-    bool let = tkn->type == LET ? true : false; // (ne)modifikovateľná premenná
+    bool let = ctx->tkn->type == LET ? true : false; // (ne)modifikovateľná premenná
 
-    TRY_OR_EXIT(nextToken());
-    if (tkn->type != ID) { // musí nasledovať názov premennej
-        logErrSyntax(tkn, "identifier");
+    TRY_OR_EXIT(nextToken(ctx));
+    if (ctx->tkn->type != ID) { // musí nasledovať názov premennej
+        logErrSyntax(&ctx->log, ctx->tkn, "identifier");
         return SYN_ERR;
     }
 
     // kontrola, či premenná s daným identifikátorom už nebola deklarovaná v tomto bloku
-    if (SymTabLookupLocal(&symt, StrRead(&(tkn->atr))) != NULL) {
-        logErrSemantic(tkn, "%s is already declared in this block", StrRead(&(tkn->atr)));
+    if (SymTabLookupLocal(&ctx->symt, StrRead(&(ctx->tkn->atr))) != NULL) {
+        logErrSemantic(&ctx->log, ctx->tkn, "%s is already declared in this block", StrRead(&(ctx->tkn->atr)));
         return SEM_ERR_REDEF;
     }
     // zápis novej premennej do TS
-    TSData_T* variable = SymTabCreateElement(StrRead(&(tkn->atr)));
+    TSData_T* variable = SymTabCreateElement(StrRead(&(ctx->tkn->atr)));
     if (variable == NULL)
     {
-        logErrCompilerMemAlloc();
+        logErrCompilerMemAlloc(&ctx->log);
         return COMPILER_ERROR;
     }
     variable->init = false;
@@ -813,36 +859,37 @@ int parseVariableDecl() {
     variable->type = SYM_TYPE_UNKNOWN;
 
     // Generovanie cieľového kódu
-    genUniqVar(parser_inside_fn_def ? "LF" : "GF", variable->id, &(variable->codename));
-    if (parser_inside_loop) { // deklarácia premennej musí byť pred najvrchnejším cyklom
-        DLLstr_InsertLast(&variables_declared_inside_loop, StrRead(&(variable->codename)));
+    genUniqVar(&ctx->gen, ctx->gen.inside_fn_def ? "LF" : "GF", variable->id, &(variable->codename));
+    if (ctx->inside_loop) { // deklarácia premennej musí byť pred najvrchnejším cyklom
+        DLLstr_InsertLast(&ctx->variables_declared_inside_loop, StrRead(&(variable->codename)));
     }
     else {
         // deklarácia premennej nie je v cykle, čiže môže byť hneď zapísaná
-        genCode(INS_DEFVAR, StrRead(&(variable->codename)), NULL, NULL);
+        genCode(&ctx->gen, INS_DEFVAR, StrRead(&(variable->codename)), NULL, NULL);
     }
 
     // ďalej musí nasledovať dátový typ alebo priradenie
-    TRY_OR_EXIT(nextToken());
-    switch (tkn->type)
+    TRY_OR_EXIT(nextToken(ctx));
+    switch (ctx->tkn->type)
     {
     case COLON: // 4. <DEF_VAR> -> : <TYPE> <INIT_VAL>
         // zistenie dátového typu
-        TRY_OR_EXIT(parseDataType(&(variable->type)));
+        TRY_OR_EXIT(parseDataType(ctx, &(variable->type)));
 
         // treba zistiť, či za deklaráciou dátového typu sa ešte nenachádza priradenie/inicializácia
-        TRY_OR_EXIT(nextToken());
-        if (tkn->type == ASSIGN) {
+        TRY_OR_EXIT(nextToken(ctx));
+        if (ctx->tkn->type == ASSIGN) {
             // 6. <INIT_VAL> -> = <ASSIGN>
             char assign_type = SYM_TYPE_UNKNOWN;
-            TRY_OR_EXIT(parseAssignment(&assign_type, StrRead(&(variable->codename)), variable->type));
+            TRY_OR_EXIT(parseAssignment(ctx, &assign_type, StrRead(&(variable->codename)), variable->type));
             variable->init = true;
 
             // kontrola výsledného typu výrazu s deklarovaným dátovým typom
             if (!isCompatibleAssign(variable->type, assign_type)) {
-                logErrSemantic(tkn, "incompatible data types");
+                logErrSemantic(&ctx->log, ctx->tkn, "incompatible data types");
                 return SEM_ERR_TYPE;
             }
+            if (let) propagateLetConstant(ctx, variable);
         }
         else { // bez počiatočnej inicializácie
             // <INIT_VAL> -> €
@@ -853,35 +900,36 @@ int parseVariableDecl() {
             case SYM_TYPE_STRING_NIL:
                 // implicitne inicializované na nil v prípade dátového typu zahrňujúceho nil
                 variable->init = true;
-                genCode(INS_MOVE, StrRead(&(variable->codename)), "nil@nil", NULL);
+                genCode(&ctx->gen, INS_MOVE, StrRead(&(variable->codename)), "nil@nil", NULL);
                 break;
             default:
                 break;
             }
-            saveToken();
+            saveToken(ctx);
         }
         break;
     case ASSIGN: // 5. <DEF_VAR> -> = <ASSIGN>
-        TRY_OR_EXIT(parseAssignment(&(variable->type), StrRead(&(variable->codename)), SYM_TYPE_UNKNOWN));
+        TRY_OR_EXIT(parseAssignment(ctx, &(variable->type), StrRead(&(variable->codename)), SYM_TYPE_UNKNOWN));
         variable->init = true;
 
         if (variable->type == SYM_TYPE_VOID) { // priradenie hodnoty z void funkcie
-            logErrSemantic(tkn, "void function does not return a value");
+            logErrSemantic(&ctx->log, ctx->tkn, "void function does not return a value");
             return SEM_ERR_TYPE;
         }
         else if (variable->type == SYM_TYPE_NIL) {  // len z nil nie je možné odvodiť typ
-            logErrSemantic(tkn, "could not deduce the data type");
+            logErrSemantic(&ctx->log, ctx->tkn, "could not deduce the data type");
             return SEM_ERR_UKN_T;
         }
+        if (let) propagateLetConstant(ctx, variable);
         break;
     default:
-        logErrSyntax(tkn, "':' or '='");
+        logErrSyntax(&ctx->log, ctx->tkn, "':' or '='");
         return SYN_ERR;
         break;
     }
 
     // vloženie záznamu o premennej do TS
-    SymTabInsertLocal(&symt, variable);
+    SymTabInsertLocal(&ctx->symt, variable);
 
     return COMPILATION_OK;
 }
@@ -895,28 +943,28 @@ int parseVariableDecl() {
  * @param had_return Ukazateľ na bool, ktorý bude značiť, či sa v bloku nachádzal príkaz return. Ak NULL, nič sa nezapisuje.
  * @return 0 v prípade úspechu, inak číslo chyby
 */
-int parseStatBlock(bool* had_return) {
+int parseStatBlock(ctx_T *ctx, bool* had_return) {
     // 11. <STAT> -> { <STAT> } <STAT>
 
     // počiatočná ľavá zátvorka
-    if (tkn->type != BRT_CUR_L) {
-        logErrSyntax(tkn, "'{'");
+    if (ctx->tkn->type != BRT_CUR_L) {
+        logErrSyntax(&ctx->log, ctx->tkn, "'{'");
         return SYN_ERR;
     }
 
     // vytvorenie nového lokálneho bloku v TS
-    SymTabAddLocalBlock(&symt);
+    SymTabAddLocalBlock(&ctx->symt);
 
-    TRY_OR_EXIT(nextToken());
-    while (tkn->type != BRT_CUR_R)
+    TRY_OR_EXIT(nextToken(ctx));
+    while (ctx->tkn->type != BRT_CUR_R)
     {
-        TRY_OR_EXIT(parse());
-        TRY_OR_EXIT(nextToken());
+        TRY_OR_EXIT(parse(ctx));
+        TRY_OR_EXIT(nextToken(ctx));
     }
 
     // vrátiť prítomnosť príkazu return a vymazať lokálny blok z TS
-    if (had_return != NULL) *had_return = SymTabCheckLocalReturn(&symt);
-    SymTabRemoveLocalBlock(&symt);
+    if (had_return != NULL) *had_return = SymTabCheckLocalReturn(&ctx->symt);
+    SymTabRemoveLocalBlock(&ctx->symt);
 
     return COMPILATION_OK;
 }
@@ -931,7 +979,7 @@ int parseStatBlock(bool* had_return) {
  * @param sig ukazateľ na dátovú štruktúru signatúry funkcie, kam sa zapíšu zistené informácie
  * @return 0 v prípade úspechu, inak číslo chyby
 */
-int parseFunctionSignature(bool compare_and_update, func_sig_T* sig) {
+int parseFunctionSignature(ctx_T *ctx, bool compare_and_update, func_sig_T* sig) {
     /*
         21. <FN_SIG> -> id id : <TYPE> <FN_PAR_NEXT>
         22. <FN_SIG> -> _ id : <TYPE> <FN_PAR_NEXT>
@@ -945,8 +993,8 @@ int parseFunctionSignature(bool compare_and_update, func_sig_T* sig) {
     str_T tmp; // pomocný reťazec
     StrInit(&tmp);
 
-    TRY_OR_EXIT(nextToken());
-    while (tkn->type != BRT_RND_R)
+    TRY_OR_EXIT(nextToken(ctx));
+    while (ctx->tkn->type != BRT_RND_R)
     {
         /*
             24. <FN_PAR_NEXT> -> , <FN_PAR> <FN_PAR_NEXT>
@@ -958,66 +1006,66 @@ int parseFunctionSignature(bool compare_and_update, func_sig_T* sig) {
         */
 
         if (loaded_params > 0) { // pred každým parametrom, okrem prvého, musí nasledovať čiarka
-            if (tkn->type != COMMA) {
-                logErrSyntax(tkn, "comma");
+            if (ctx->tkn->type != COMMA) {
+                logErrSyntax(&ctx->log, ctx->tkn, "comma");
                 return SYN_ERR;
             }
-            TRY_OR_EXIT(nextToken());
+            TRY_OR_EXIT(nextToken(ctx));
         }
 
-        if (tkn->type == ID || tkn->type == UNDERSCORE) { // názov parametra musí byť identifikátor alebo '_'
+        if (ctx->tkn->type == ID || ctx->tkn->type == UNDERSCORE) { // názov parametra musí byť identifikátor alebo '_'
 
             if (compare_and_update) { // funkcia bola volaná pred jej definíciou
                 /* Kontrola počtu parametrov s počtom argumentov v prvom volaní. */
                 if (strlen(StrRead(&(sig->par_types))) <= loaded_params) { // funkcia bola volaná s menším počtom argumentov
-                    logErrSemantic(tkn, "different number of parameters in function definition and first call");
+                    logErrSemantic(&ctx->log, ctx->tkn, "different number of parameters in function definition and first call");
                     return SEM_ERR_FUNC;
                 }
 
                 /*  Treba skontrolovať názov parametra s prvým volaním. */
                 DLLstr_GetValue(&(sig->par_names), &tmp);
-                if (strcmp(StrRead(&tmp), StrRead(&(tkn->atr))) != 0) {
-                    logErrSemantic(tkn, "different parameter name in definition and first call");
+                if (strcmp(StrRead(&tmp), StrRead(&(ctx->tkn->atr))) != 0) {
+                    logErrSemantic(&ctx->log, ctx->tkn, "different parameter name in definition and first call");
                     return SEM_ERR_FUNC;
                 }
             }
             else { // zápis názvu parametra do predpisu funkcie
-                DLLstr_InsertLast(&(sig->par_names), StrRead(&(tkn->atr)));
+                DLLstr_InsertLast(&(sig->par_names), StrRead(&(ctx->tkn->atr)));
             }
         }
         else {
-            logErrSyntax(tkn, "parameter name or underscore");
+            logErrSyntax(&ctx->log, ctx->tkn, "parameter name or underscore");
             return SYN_ERR;
         }
 
         // nasleduje identifikátor parametra vo vnútri funkcie
-        TRY_OR_EXIT(nextToken());
-        if (tkn->type == ID) {
+        TRY_OR_EXIT(nextToken(ctx));
+        if (ctx->tkn->type == ID) {
             compare_and_update ? DLLstr_GetValue(&(sig->par_names), &tmp) : DLLstr_GetLast(&(sig->par_names), &tmp);
 
             // názov parametra a identifikátor parametra sa musia líšiť
-            if (strcmp(StrRead(&tmp), StrRead(&(tkn->atr))) == 0) {
-                logErrSemantic(tkn, "parameter name and identifier must be different");
+            if (strcmp(StrRead(&tmp), StrRead(&(ctx->tkn->atr))) == 0) {
+                logErrSemantic(&ctx->log, ctx->tkn, "parameter name and identifier must be different");
                 return SEM_ERR_OTHER;
             }
-            DLLstr_InsertLast(&(sig->par_ids), StrRead(&(tkn->atr)));
+            DLLstr_InsertLast(&(sig->par_ids), StrRead(&(ctx->tkn->atr)));
         }
-        else if (tkn->type == UNDERSCORE) {
+        else if (ctx->tkn->type == UNDERSCORE) {
             DLLstr_InsertLast(&(sig->par_ids), "_");
         }
         else {
-            logErrSyntax(tkn, "parameter identifier");
+            logErrSyntax(&ctx->log, ctx->tkn, "parameter identifier");
             return SYN_ERR;
         }
 
         // nasleduje dátový typ parametra
-        TRY_OR_EXIT(nextToken()); // dvojbodka
-        if (tkn->type != COLON) {
-            logErrSyntax(tkn, "':'");
+        TRY_OR_EXIT(nextToken(ctx)); // dvojbodka
+        if (ctx->tkn->type != COLON) {
+            logErrSyntax(&ctx->log, ctx->tkn, "':'");
             return SYN_ERR;
         }
         char data_type;
-        TRY_OR_EXIT(parseDataType(&data_type));
+        TRY_OR_EXIT(parseDataType(ctx, &data_type));
         if (compare_and_update) { // funkcia bola volaná pred jej definíciou
             // kontrola typu v definícii s typom argumentu v prvom volaní
             bool same_type = true;
@@ -1041,7 +1089,7 @@ int parseFunctionSignature(bool compare_and_update, func_sig_T* sig) {
             }
             if (type_before == SYM_TYPE_UNKNOWN) same_type = true;
             if (!same_type) {
-                logErrSemanticFn(StrRead(&fn_name), "parameter types does not correspond to previous call");
+                logErrSemanticFn(&ctx->log, StrRead(&ctx->fn_name), "parameter types does not correspond to previous call");
                 return SEM_ERR_FUNC;
             }
             sig->par_types.data[loaded_params] = data_type; // zapíše sa dátový typ zistení z definície
@@ -1053,12 +1101,12 @@ int parseFunctionSignature(bool compare_and_update, func_sig_T* sig) {
         loaded_params++;
         DLLstr_Next(&(sig->par_names));
         DLLstr_Next(&(sig->par_ids));
-        TRY_OR_EXIT(nextToken());
+        TRY_OR_EXIT(nextToken(ctx));
     }
 
     if (compare_and_update) { // kontrola počtu parametrov v definícii s počtom argumentov v prvom volaní
         if (strlen(StrRead(&(sig->par_types))) != loaded_params) {
-            logErrSemantic(tkn, "different count of parameters in function definition and first call");
+            logErrSemantic(&ctx->log, ctx->tkn, "different count of parameters in function definition and first call");
             return SEM_ERR_FUNC;
         }
     }
@@ -1067,12 +1115,12 @@ int parseFunctionSignature(bool compare_and_update, func_sig_T* sig) {
     bool unique_names;
     if (!listHasUniqueValues(&(sig->par_names), &unique_names)) return COMPILER_ERROR;
     if (!unique_names) {
-        logErrSemanticFn(StrRead(&fn_name), "parameter names don't have different names");
+        logErrSemanticFn(&ctx->log, StrRead(&ctx->fn_name), "parameter names don't have different names");
         return SEM_ERR_OTHER;
     }
     if (!listHasUniqueValues(&(sig->par_ids), &unique_names)) return COMPILER_ERROR;
     if (!unique_names) {
-        logErrSemanticFn(StrRead(&fn_name), "parameter identifiers don't have different names");
+        logErrSemanticFn(&ctx->log, StrRead(&ctx->fn_name), "parameter identifiers don't have different names");
         return SEM_ERR_OTHER;
     }
 
@@ -1093,28 +1141,28 @@ int parseFunctionSignature(bool compare_and_update, func_sig_T* sig) {
  *      RETURN
  *
  * @brief Pravidlo pre spracovanie definície funkcie
- * @details Očakáva, že v globálnej premennej tkn je už načítaný token FUNC
+ * @details Očakáva, že v ctx->tkn je už načítaný token FUNC
  * @return 0 v prípade úspechu, inak číslo chyby
 */
-int parseFunction() {
+int parseFunction(ctx_T *ctx) {
     // 20. <STAT> -> func id ( <FN_SIG> ) <FN_RET_TYPE> { <STAT> } <STAT>
-    bool code_inside_fn_def = parser_inside_fn_def;
-    parser_inside_fn_def = true; // parser sa nachádza v definícií funkcie
+    bool code_inside_fn_def = ctx->gen.inside_fn_def;
+    ctx->gen.inside_fn_def = true; // parser sa nachádza v definícií funkcie
 
-    TRY_OR_EXIT(nextToken()); // názov funkcie
-    if (tkn->type != ID) {
-        logErrSyntax(tkn, "function identifier");
+    TRY_OR_EXIT(nextToken(ctx)); // názov funkcie
+    if (ctx->tkn->type != ID) {
+        logErrSyntax(&ctx->log, ctx->tkn, "function identifier");
         return SYN_ERR;
     }
 
-    TSData_T* fn = SymTabLookupGlobal(&symt, StrRead(&(tkn->atr)));
+    TSData_T* fn = SymTabLookupGlobal(&ctx->symt, StrRead(&(ctx->tkn->atr)));
     bool already_called = fn != NULL; // funkcia bola volaná pred jej definíciou, pretože existuje záznam v TS
     if (fn == NULL) {
         // vytvorenie záznamu o funkcii do TS
-        fn = SymTabCreateElement(StrRead(&(tkn->atr)));
+        fn = SymTabCreateElement(StrRead(&(ctx->tkn->atr)));
         if (fn == NULL) return COMPILER_ERROR;
-        SymTabInsertGlobal(&symt, fn);
-        StrFillWith(&(fn->codename), StrRead(&(tkn->atr)));
+        SymTabInsertGlobal(&ctx->symt, fn);
+        StrFillWith(&(fn->codename), StrRead(&(ctx->tkn->atr)));
         fn->type = SYM_TYPE_FUNC;
         fn->sig = SymTabCreateFuncSig();
         if (fn->sig == NULL) {
@@ -1124,49 +1172,49 @@ int parseFunction() {
     }
     else {
         if (fn->type != SYM_TYPE_FUNC) { // existuje globálna premenná s rovnakým názvom
-            logErrSemantic(tkn, "identifier is already used as a variable");
+            logErrSemantic(&ctx->log, ctx->tkn, "identifier is already used as a variable");
             return SEM_ERR_OTHER;
         }
         if (fn->init) { // funkcia už bola definovaná
-            logErrSemantic(tkn, "function was already defined");
+            logErrSemantic(&ctx->log, ctx->tkn, "function was already defined");
             return SEM_ERR_REDEF;
         }
         // v ostatných prípadoch záznam o funkcii existuje preto, lebo bola už volaná 
     }
     fn->init = true; // funkcia je odteraz definovaná
 
-    StrFillWith(&fn_name, fn->id); // zápis názvu aktuálne definovanej funkcie do globálnej premennej
+    StrFillWith(&ctx->fn_name, fn->id); // zápis názvu aktuálne definovanej funkcie do kontextu
 
-    TRY_OR_EXIT(nextToken());
-    if (tkn->type != BRT_RND_L) {
-        logErrSyntax(tkn, "'('");
+    TRY_OR_EXIT(nextToken(ctx));
+    if (ctx->tkn->type != BRT_RND_L) {
+        logErrSyntax(&ctx->log, ctx->tkn, "'('");
         return SYN_ERR;
     }
 
     // spracovanie predpisu, resp. definície parametrov
-    TRY_OR_EXIT(parseFunctionSignature(already_called, fn->sig));
+    TRY_OR_EXIT(parseFunctionSignature(ctx, already_called, fn->sig));
 
     // zistenie návratového typu funkcie
-    TRY_OR_EXIT(nextToken());
+    TRY_OR_EXIT(nextToken(ctx));
     fn->sig->ret_type = SYM_TYPE_VOID;
-    if (tkn->type == ARROW) {
+    if (ctx->tkn->type == ARROW) {
         // 30. <FN_RET_TYPE> -> "->" <TYPE>
-        TRY_OR_EXIT(parseDataType(&(fn->sig->ret_type)));
-        TRY_OR_EXIT(nextToken());
+        TRY_OR_EXIT(parseDataType(ctx, &(fn->sig->ret_type)));
+        TRY_OR_EXIT(nextToken(ctx));
     } // ak nenasleduje šípka '->', potom je to void funkcia
 
-    if (tkn->type == BRT_CUR_L) {
+    if (ctx->tkn->type == BRT_CUR_L) {
         // 31. <FN_RET_TYPE> -> €
-        TRY_OR_EXIT(nextToken());
+        TRY_OR_EXIT(nextToken(ctx));
     }
     else {
-        logErrSyntax(tkn, "'{'");
+        logErrSyntax(&ctx->log, ctx->tkn, "'{'");
         return SYN_ERR;
     }
 
     // Príprava parametrov pre telo funkcie
     // parametre budú vo vlastnom lokálnom bloku TS
-    SymTabAddLocalBlock(&symt);
+    SymTabAddLocalBlock(&ctx->symt);
     DLLstr_First(&(fn->sig->par_ids));
     str_T par_id;
     StrInit(&par_id);
@@ -1178,10 +1226,10 @@ int parseFunction() {
         }
         TSData_T* par = SymTabCreateElement(StrRead(&par_id));
         if (par == NULL) {
-            logErrCompilerMemAlloc();
+            logErrCompilerMemAlloc(&ctx->log);
             return COMPILER_ERROR;
         }
-        SymTabInsertLocal(&symt, par);
+        SymTabInsertLocal(&ctx->symt, par);
         par->init = true;
         par->let = true;
         par->type = StrRead(&(fn->sig->par_types))[i];
@@ -1195,33 +1243,65 @@ int parseFunction() {
     }
     StrDestroy(&par_id);
 
+    // kód funkcie sa generuje samostatne, aj keď je jej definícia vnorená
+    genFnCodeBegin(&ctx->gen, StrRead(&ctx->fn_name));
     // vygenerovanie inštrukcií začiatku funkcie (náveštie, deklarácie parametrov a ich inicializácia)
-    genFnDefBegin(StrRead(&fn_name), &(fn->sig->par_ids));
+    genFnDefBegin(&ctx->gen, StrRead(&ctx->fn_name), &(fn->sig->par_ids));
+    ctx->gen.code_fns.array[ctx->gen.code_fns.current].returns_value = fn->sig->ret_type != SYM_TYPE_VOID;
 
     // Spracovanie tela funkcie
-    SymTabAddLocalBlock(&symt);
-    while (tkn->type != BRT_CUR_R) {
-        TRY_OR_EXIT(parse());
-        TRY_OR_EXIT(nextToken());
+    SymTabAddLocalBlock(&ctx->symt);
+    while (ctx->tkn->type != BRT_CUR_R) {
+        TRY_OR_EXIT(parse(ctx));
+        TRY_OR_EXIT(nextToken(ctx));
     }
     // kontrola, či funkcia s návratovou hodnotou má všade kde je to treba, príkaz return
-    if (!SymTabCheckLocalReturn(&symt) && fn->sig->ret_type != SYM_TYPE_VOID) {
-        logErrSemanticFn(fn->id, "it is possible to exit function without return value");
+    if (!SymTabCheckLocalReturn(&ctx->symt) && fn->sig->ret_type != SYM_TYPE_VOID) {
+        logErrSemanticFn(&ctx->log, fn->id, "it is possible to exit function without return value");
         return SEM_ERR_FUNC;
     }
-    if (!SymTabCheckLocalReturn(&symt)) {
+    if (!SymTabCheckLocalReturn(&ctx->symt)) {
         // aj void-funkcia musí mať na konci inštrukciu RETURN, pre vrátenie riadenie programu
-        genCode(INS_RETURN, NULL, NULL, NULL);
+        genCode(&ctx->gen, INS_RETURN, NULL, NULL, NULL);
     }
-    SymTabRemoveLocalBlock(&symt);
+    SymTabRemoveLocalBlock(&ctx->symt);
 
-    SymTabRemoveLocalBlock(&symt); // odstránenie lokálneho bloku s parametrami
+    SymTabRemoveLocalBlock(&ctx->symt); // odstránenie lokálneho bloku s parametrami
+    genFnCodeEnd(&ctx->gen);
+    // vnorené funkcie sa vypíšu až s najvrchnejšou, kód funkcie v cykle sa ešte môže meniť
+    // presunom definícií premenných pred cyklus
+    if (ctx->options.stream && !ctx->inside_loop && ctx->gen.code_fns.current == -1) streamFunctions(ctx);
 
-    parser_inside_fn_def = code_inside_fn_def;
-    StrFillWith(&fn_name, "");
+    ctx->gen.inside_fn_def = code_inside_fn_def;
+    // obnovenie názvu nadradenej funkcie v prípade vnorenej definície
+    StrFillWith(&ctx->fn_name, ctx->gen.code_fns.current != -1 ? ctx->gen.code_fns.array[ctx->gen.code_fns.current].name : "");
     return COMPILATION_OK;
 }
 
+/**
+ * Stav tkn:
+ *  - pred volaním: FUNC
+ *  - po volaní:    BRT_CUR_R
+ *
+ * Definícia sa prevezme z cache, ak sa od posledného prekladu nezmenila ona ani signatúry a premenné,
+ * ktoré používa. Inak sa spracuje parseFunction a výsledok sa uloží do cache.
+ *
+ * @brief Pravidlo pre spracovanie definície funkcie na najvyššej úrovni pri inkrementálnom preklade
+ * @return 0 v prípade úspechu, inak číslo chyby
+*/
+static int parseFunctionIncremental(ctx_T *ctx) {
+    incr_fn_T unit;
+    REPORT_ENTER(REPORT_CACHE);
+    bool hit = incrFnBegin(ctx, &unit, &ctx->check_def_fns, &ctx->bifn_substring_called);
+    REPORT_LEAVE();
+    if (hit) return COMPILATION_OK;
+    int result = parseFunction(ctx);
+    REPORT_ENTER(REPORT_CACHE);
+    incrFnEnd(ctx, &unit, &ctx->check_def_fns, &ctx->bifn_substring_called, result == COMPILATION_OK);
+    REPORT_LEAVE();
+    return result;
+}
+
 /**
  * Stav tkn:
  *  - pred volaním: RETURN
@@ -1234,34 +1314,34 @@ int parseFunction() {
  * @brief Pravidlo pre spracovanie vrátenia návratovej hodnoty funkcie - return
  * @return 0 v prípade úspechu, inak číslo chyby
 */
-int parseReturn() {
+int parseReturn(ctx_T *ctx) {
     // 32. <STAT> -> return <RET_VAL> <STAT>
-    if (!parser_inside_fn_def) { // return sa nachádza v hlavnom tele programu
-        logErrSemantic(tkn, "return outside function definition");
+    if (!ctx->gen.inside_fn_def) { // return sa nachádza v hlavnom tele programu
+        logErrSemantic(&ctx->log, ctx->tkn, "return outside function definition");
         return SEM_ERR_OTHER;
     }
 
     bool possible_implicit_int_conversion = false;
 
-    TRY_OR_EXIT(nextToken());
+    TRY_OR_EXIT(nextToken(ctx));
     char result_type = SYM_TYPE_UNKNOWN;
-    switch (tkn->type)
+    switch (ctx->tkn->type)
     {
     case ID:; // id môže byť začiatok výrazu alebo sa za return môže nachádzať volanie funkcie
-        TSData_T* id_data = SymTabLookup(&symt, StrRead(&(tkn->atr)));
+        TSData_T* id_data = SymTabLookup(&ctx->symt, StrRead(&(ctx->tkn->atr)));
         if (id_data == NULL) { // za return je funkcia, ktorá nebola ešte volaná
-            saveToken();
+            saveToken(ctx);
             result_type = SYM_TYPE_VOID;
         }
         else {
             if (id_data->type == SYM_TYPE_FUNC) { // za return je funkcia
                 // 34. <RET_VAL> -> €
-                saveToken();
+                saveToken(ctx);
                 result_type = SYM_TYPE_VOID;
             }
             else { // za return je výraz začínajúci premennou
                 // 33. <RET_VAL> -> exp
-                TRY_OR_EXIT(parseExpression(&result_type, &possible_implicit_int_conversion));
+                TRY_OR_EXIT(parseExpression(ctx, &result_type, &possible_implicit_int_conversion));
             }
         }
         break;
@@ -1271,45 +1351,45 @@ int parseReturn() {
     case NIL:
     case BRT_RND_L:
         // spracovanie výrazu a zistenie typu návratovej hodnoty v return
-        TRY_OR_EXIT(parseExpression(&result_type, &possible_implicit_int_conversion));
+        TRY_OR_EXIT(parseExpression(ctx, &result_type, &possible_implicit_int_conversion));
         break;
     default: // 34. <RET_VAL> -> €
         // void return
-        saveToken();
+        saveToken(ctx);
         result_type = SYM_TYPE_VOID;
         break;
     }
 
     // získanie informácii o predpise aktuálnej funkcie
-    TSData_T* fn = SymTabLookupGlobal(&symt, StrRead(&fn_name));
+    TSData_T* fn = SymTabLookupGlobal(&ctx->symt, StrRead(&ctx->fn_name));
 
     if (fn->sig->ret_type == SYM_TYPE_VOID) { // vo vnútri void funkcie
         if (result_type != SYM_TYPE_VOID) { // void funkcia nesmie vraciať hodnotu
-            logErrSemanticFn(fn->id, "void function returns a value");
+            logErrSemanticFn(&ctx->log, fn->id, "void function returns a value");
             return SEM_ERR_RETURN;
         }
     }
     else { // funkcia má vraciať hodnotu
         if (result_type == SYM_TYPE_VOID) { // return nič nevracia
-            logErrSemanticFn(fn->id, "void return in non-void function");
+            logErrSemanticFn(&ctx->log, fn->id, "void return in non-void function");
             return SEM_ERR_RETURN;
         }
         if (possible_implicit_int_conversion && result_type == SYM_TYPE_INT &&
             (fn->sig->ret_type == SYM_TYPE_DOUBLE || fn->sig->ret_type == SYM_TYPE_DOUBLE_NIL)) {
             // vo výraze sú celočíselné literály a výsledok má byť priradený do dátového typu Double(?)
             // musí byť vykonaná implicitná konverzia
-            genCode(INS_INT2FLOATS, NULL, NULL, NULL);
+            genCode(&ctx->gen, INS_INT2FLOATS, NULL, NULL, NULL);
             result_type = SYM_TYPE_DOUBLE;
         }
         if (!isCompatibleAssign(fn->sig->ret_type, result_type)) { // návratový typ nesedí s predpisom funkcie
-            logErrSemanticFn(fn->id, "different return type");
+            logErrSemanticFn(&ctx->log, fn->id, "different return type");
             return SEM_ERR_FUNC;
         }
     }
 
-    SymTabModifyLocalReturn(&symt, true); // zapísať informáciu o prítomnosti return v aktuálnom bloku
+    SymTabModifyLocalReturn(&ctx->symt, true); // zapísať informáciu o prítomnosti return v aktuálnom bloku
 
-    genCode(INS_RETURN, NULL, NULL, NULL); // vloženie inštrukcie RETURN
+    genCode(&ctx->gen, INS_RETURN, NULL, NULL, NULL); // vloženie inštrukcie RETURN
 
     return COMPILATION_OK;
 }
@@ -1330,50 +1410,50 @@ int parseReturn() {
  * @brief Pravidlo pre spracovanie podmieneného bloku kódu
  * @return 0 v prípade úspechu, inak číslo chyby
 */
-int parseIf() {
+int parseIf(ctx_T *ctx) {
     // 35. <STAT> -> if <COND> { <STAT> } else { <STAT> } <STAT>
-    TRY_OR_EXIT(nextToken());
+    TRY_OR_EXIT(nextToken(ctx));
     TSData_T* let_variable = NULL; // informácie o premennej v podmienke "let <premenná>"
     str_T cond_false;       // náveštie kam sa má skočiť, keď podmienka je false
     str_T skip_cond_false;  // náveštie kam sa skočí z if{} časti, aby sa preskočila časť else{}
     StrInit(&cond_false);
     StrInit(&skip_cond_false);
 
-    genUniqLabel(StrRead(&fn_name), "if", &cond_false);
+    genUniqLabel(&ctx->gen, StrRead(&ctx->fn_name), "if", &cond_false);
     StrFillWith(&skip_cond_false, StrRead(&(cond_false)));
     StrAppend(&cond_false, '!');
     StrAppend(&skip_cond_false, '*');
 
-    switch (tkn->type) // rozlíšenie obyčajnej podmienky v tvare výrazu alebo test premennej na nil "let <premenná>"
+    switch (ctx->tkn->type) // rozlíšenie obyčajnej podmienky v tvare výrazu alebo test premennej na nil "let <premenná>"
     {
     case LET:;
         //  37. <COND> -> let id
-        TRY_OR_EXIT(nextToken());   // identifikátor testovanej premennej
-        if (tkn->type != ID) {
-            logErrSyntax(tkn, "identifier");
+        TRY_OR_EXIT(nextToken(ctx));   // identifikátor testovanej premennej
+        if (ctx->tkn->type != ID) {
+            logErrSyntax(&ctx->log, ctx->tkn, "identifier");
             return SYN_ERR;
         }
-        TSData_T* variable = SymTabLookup(&symt, StrRead(&(tkn->atr))); // informácie o premennej
+        TSData_T* variable = SymTabLookup(&ctx->symt, StrRead(&(ctx->tkn->atr))); // informácie o premennej
         if (variable == NULL) { // premenná nebola deklarovaná
-            logErrSemantic(tkn, "%s was undeclared", StrRead(&(tkn->atr)));
+            logErrSemantic(&ctx->log, ctx->tkn, "%s was undeclared", StrRead(&(ctx->tkn->atr)));
             return SEM_ERR_UNDEF;
         }
         if (variable->type == SYM_TYPE_FUNC) { // identifikátor označuje funkciu
-            logErrSemantic(tkn, "%s is a function", StrRead(&(tkn->atr)));
+            logErrSemantic(&ctx->log, ctx->tkn, "%s is a function", StrRead(&(ctx->tkn->atr)));
             return SEM_ERR_RETURN;
         }
         if (!(variable->init)) { // premenná nebola inicializovaná
-            logErrSemantic(tkn, "%s was uninitialized", StrRead(&(tkn->atr)));
+            logErrSemantic(&ctx->log, ctx->tkn, "%s was uninitialized", StrRead(&(ctx->tkn->atr)));
             return SEM_ERR_UNDEF;
         }
         if (!(variable->let)) { // premenná musí byť nemodifikovateľná
-            logErrSemantic(tkn, "%s must be unmodifiable variable", StrRead(&(tkn->atr)));
+            logErrSemantic(&ctx->log, ctx->tkn, "%s must be unmodifiable variable", StrRead(&(ctx->tkn->atr)));
             return SEM_ERR_OTHER;
         }
 
         // premenná musí byť v samostatnom bloku, kde bude jej typ zmenený na typ nezahrňujúci nil
-        SymTabAddLocalBlock(&symt);
-        let_variable = SymTabCreateElement(StrRead(&(tkn->atr)));
+        SymTabAddLocalBlock(&ctx->symt);
+        let_variable = SymTabCreateElement(StrRead(&(ctx->tkn->atr)));
         if (let_variable == NULL)
         {
             return COMPILER_ERROR;
@@ -1384,9 +1464,9 @@ int parseIf() {
         let_variable->type = convertNilTypeToNonNil(variable->type);
         StrFillWith(&(let_variable->codename), StrRead(&(variable->codename)));
 
-        SymTabInsertLocal(&symt, let_variable);
+        SymTabInsertLocal(&ctx->symt, let_variable);
 
-        genCode("JUMPIFEQ", StrRead(&cond_false), StrRead(&(variable->codename)), "nil@nil");
+        genCode(&ctx->gen, "JUMPIFEQ", StrRead(&cond_false), StrRead(&(variable->codename)), "nil@nil");
         break;
     case ID:;    // v podminke je obyčajný výraz
     case BRT_RND_L:;
@@ -1396,47 +1476,44 @@ int parseIf() {
     case NIL:;
         // 36. <COND> -> exp
         char exp_type = SYM_TYPE_UNKNOWN; // ???
-        bool possible_implicit_int_conversion = false; // nie je využívané v if
-        TRY_OR_EXIT(parseExpression(&exp_type, &possible_implicit_int_conversion));
+        // parseCondition vygeneruje skok na cond_false, ak je podmienka nepravdivá
+        TRY_OR_EXIT(parseCondition(ctx, &exp_type, StrRead(&cond_false)));
         if (exp_type != SYM_TYPE_BOOL && exp_type != SYM_TYPE_UNKNOWN) {
-            logErrSemantic(tkn, "condition must return a bool");
+            logErrSemantic(&ctx->log, ctx->tkn, "condition must return a bool");
             return SEM_ERR_TYPE;
         }
-        // na vrchole zásobníka je bool@true alebo bool@false
-        genCode(INS_PUSHS, "bool@false", NULL, NULL);
-        genCode(INS_JUMPIFEQS, StrRead(&cond_false), NULL, NULL);
         break;
     default:;
-        logErrSyntax(tkn, "let or an expression");
+        logErrSyntax(&ctx->log, ctx->tkn, "let or an expression");
         return SYN_ERR;
         break;
     }
 
-    TRY_OR_EXIT(nextToken());
+    TRY_OR_EXIT(nextToken(ctx));
     bool if_had_return;
-    TRY_OR_EXIT(parseStatBlock(&if_had_return)); // spracovanie príkazov keď podmienka je true
-    if (let_variable != NULL) SymTabRemoveLocalBlock(&symt);
+    TRY_OR_EXIT(parseStatBlock(ctx, &if_had_return)); // spracovanie príkazov keď podmienka je true
+    if (let_variable != NULL) SymTabRemoveLocalBlock(&ctx->symt);
 
-    genCode(INS_JUMP, StrRead(&skip_cond_false), NULL, NULL);
+    genCode(&ctx->gen, INS_JUMP, StrRead(&skip_cond_false), NULL, NULL);
 
-    TRY_OR_EXIT(nextToken());
-    if (tkn->type != ELSE) {
-        logErrSyntax(tkn, "else");
+    TRY_OR_EXIT(nextToken(ctx));
+    if (ctx->tkn->type != ELSE) {
+        logErrSyntax(&ctx->log, ctx->tkn, "else");
         return SYN_ERR;
     }
 
-    genCode(INS_LABEL, StrRead(&cond_false), NULL, NULL);
+    genCode(&ctx->gen, INS_LABEL, StrRead(&cond_false), NULL, NULL);
 
-    TRY_OR_EXIT(nextToken());
+    TRY_OR_EXIT(nextToken(ctx));
     bool else_had_return;
-    TRY_OR_EXIT(parseStatBlock(&else_had_return)); // spracovanie príkazov keď podmienka je false
+    TRY_OR_EXIT(parseStatBlock(ctx, &else_had_return)); // spracovanie príkazov keď podmienka je false
 
     if (if_had_return && else_had_return) {
         // pokiaľ sa v oboch častiach if aj else nachádzal return, potom bude return určite zastihnutý
-        SymTabModifyLocalReturn(&symt, true);
+        SymTabModifyLocalReturn(&ctx->symt, true);
     }
 
-    genCode(INS_LABEL, StrRead(&skip_cond_false), NULL, NULL);
+    genCode(&ctx->gen, INS_LABEL, StrRead(&skip_cond_false), NULL, NULL);
 
     StrDestroy(&cond_false);
     StrDestroy(&skip_cond_false);
@@ -1461,26 +1538,26 @@ int parseIf() {
  * @brief Pravidlo pre spracovanie cyklu while
  * @return 0 v prípade úspechu, inak číslo chyby
 */
-int parseWhile() {
+int parseWhile(ctx_T *ctx) {
     // 38. <STAT> -> while exp { <STAT> } <STAT>
     str_T loop_start;   // náveštie začiatku cyklu (spolu s podmienkou)
     str_T loop_end;     // náveštie za koniec cyklu (sem sa skočí keď podmienka nie je splnená)
     StrInit(&loop_start);
     StrInit(&loop_end);
 
-    genUniqLabel(StrRead(&fn_name), "while", &loop_start);
+    genUniqLabel(&ctx->gen, StrRead(&ctx->fn_name), "while", &loop_start);
     StrFillWith(&loop_end, StrRead(&(loop_start)));
     StrAppend(&loop_end, '!');
-    genCode(INS_LABEL, StrRead(&loop_start), NULL, NULL);
+    genCode(&ctx->gen, INS_LABEL, StrRead(&loop_start), NULL, NULL);
 
-    bool loop_inside_loop = parser_inside_loop; // cyklus v cykle
+    bool loop_inside_loop = ctx->inside_loop; // cyklus v cykle
     if (!loop_inside_loop) {
-        StrFillWith(&first_loop_label, StrRead(&loop_start));
+        StrFillWith(&ctx->first_loop_label, StrRead(&loop_start));
     }
-    parser_inside_loop = true;
+    ctx->inside_loop = true;
 
-    TRY_OR_EXIT(nextToken());
-    switch (tkn->type) // syntaktická kontrola, či sa v podmienke nachádza výraz
+    TRY_OR_EXIT(nextToken(ctx));
+    switch (ctx->tkn->type) // syntaktická kontrola, či sa v podmienke nachádza výraz
     {
     case ID:;
     case BRT_RND_L:;
@@ -1491,31 +1568,29 @@ int parseWhile() {
         // začiatok výrazu potvrdený
         break;
     default:
-        logErrSyntax(tkn, "expression");
+        logErrSyntax(&ctx->log, ctx->tkn, "expression");
         return SYN_ERR;
     }
 
     char exp_type = SYM_TYPE_UNKNOWN; // ???
-    bool possible_implicit_int_conversion = false; // nie je využívané vo while
-    TRY_OR_EXIT(parseExpression(&exp_type, &possible_implicit_int_conversion));
+    // parseCondition vygeneruje skok na loop_end, ak je podmienka nepravdivá
+    TRY_OR_EXIT(parseCondition(ctx, &exp_type, StrRead(&loop_end)));
     if (exp_type != SYM_TYPE_BOOL && exp_type != SYM_TYPE_UNKNOWN) {
-        logErrSemantic(tkn, "condition must return a bool");
+        logErrSemantic(&ctx->log, ctx->tkn, "condition must return a bool");
         return SEM_ERR_TYPE;
     }
-    genCode(INS_PUSHS, "bool@false", NULL, NULL);
-    genCode(INS_JUMPIFEQS, StrRead(&loop_end), NULL, NULL);
 
-    TRY_OR_EXIT(nextToken());
-    TRY_OR_EXIT(parseStatBlock(NULL));
+    TRY_OR_EXIT(nextToken(ctx));
+    TRY_OR_EXIT(parseStatBlock(ctx, NULL));
 
-    genCode(INS_JUMP, StrRead(&loop_start), NULL, NULL);
-    genCode(INS_LABEL, StrRead(&loop_end), NULL, NULL);
+    genCode(&ctx->gen, INS_JUMP, StrRead(&loop_start), NULL, NULL);
+    genCode(&ctx->gen, INS_LABEL, StrRead(&loop_end), NULL, NULL);
 
-    parser_inside_loop = loop_inside_loop;
-    if (!parser_inside_loop) { // najvrchnejší cyklus bol opustený
+    ctx->inside_loop = loop_inside_loop;
+    if (!ctx->inside_loop) { // najvrchnejší cyklus bol opustený
         // inštrukcie pre definície premenných vo vnútri cyklu musia byť vložené pred samotným cyklom
-        genDefVarsBeforeLoop(StrRead(&first_loop_label), &variables_declared_inside_loop);
-        DLLstr_Dispose(&variables_declared_inside_loop);
+        genDefVarsBeforeLoop(&ctx->gen, StrRead(&ctx->first_loop_label), &ctx->variables_declared_inside_loop);
+        DLLstr_Dispose(&ctx->variables_declared_inside_loop);
     }
 
     StrDestroy(&loop_start);
@@ -1559,114 +1634,134 @@ bool isCompatibleAssign(char dest, char src) {
     return false;
 }
 
-int nextToken() {
-    if (tkn != NULL) destroyToken(tkn);
-    tkn = getToken();
-    if (tkn == NULL) return COMPILER_ERROR;
-    logErrUpdateTokenInfo(tkn);
-    if (tkn->type == INVALID) {
-        logErrCodeAnalysis(LEX_ERR, tkn->ln, tkn->col, "invalid token");
+int nextToken(ctx_T *ctx) {
+    if (ctx->tkn != NULL) destroyToken(ctx->tkn);
+    REPORT_ENTER(REPORT_SCANNER);
+    ctx->tkn = getToken(&ctx->scanner);
+    REPORT_LEAVE();
+    if (ctx->tkn == NULL) return COMPILER_ERROR;
+    logErrUpdateTokenInfo(&ctx->log, ctx->tkn);
+    if (ctx->tkn->type == INVALID) {
+        logErrCodeAnalysis(&ctx->log, LEX_ERR, ctx->tkn->ln, ctx->tkn->col, "invalid token");
         return LEX_ERR;
     }
     return COMPILATION_OK;
 }
 
-void saveToken() {
-    storeToken(tkn);
-    tkn = NULL;
+void saveToken(ctx_T *ctx) {
+    storeToken(&ctx->scanner, ctx->tkn);
+    ctx->tkn = NULL;
 }
 
-bool initializeParser() {
-    SymTabInit(&symt);
+bool initializeParser(ctx_T *ctx) {
+    // stav z prekladu predchádzajúceho programu v tom istom procese
+    ctx->tkn = NULL;
+    ctx->inside_loop = false;
+    ctx->bifn_substring_called = false;
+    ctx->header_printed = false;
+    ctx->streamed_fns = 0;
 
-    loadBuiltInFunctionSignatures();
+    if (ctx->builtins != NULL) { // vstavané funkcie ostali v TS z predchádzajúceho prekladu
+        memcpy(ctx->symt.global, ctx->builtins, SYMT_BLOCK_SIZE);
+        ctx->symt.local = ctx->symt.global;
+    }
+    else {
+        SymTabInit(&ctx->symt);
+
+        loadBuiltInFunctionSignatures(ctx);
+    }
 
-    StrInit(&fn_name);
+    StrInit(&ctx->fn_name);
 
-    DLLstr_Init(&check_def_fns);
+    DLLstr_Init(&ctx->check_def_fns);
 
-    StrInit(&first_loop_label);
-    DLLstr_Init(&variables_declared_inside_loop);
+    StrInit(&ctx->first_loop_label);
+    DLLstr_Init(&ctx->variables_declared_inside_loop);
 
-    DLLstr_Init(&code_fn);
-    DLLstr_Init(&code_main);
+    genInit(&ctx->gen, &ctx->options);
     return true;
 }
 
-int parse() {
-    switch (tkn->type)
+int parse(ctx_T *ctx) {
+    switch (ctx->tkn->type)
     {
     case LET:;
     case VAR:;
-        TRY_OR_EXIT(parseVariableDecl());
+        TRY_OR_EXIT(parseVariableDecl(ctx));
         break;
     case ID:;
         // 10. <STAT> -> id = <ASSIGN> <STAT>
         // 12. <STAT> -> id ( <PAR_LIST> ) <STAT>
         char result_type;
-        token_T* first_tkn = tkn;
-        tkn = NULL;
-        TRY_OR_EXIT(nextToken());
-        if (tkn->type == BRT_RND_L) {
+        token_T* first_tkn = ctx->tkn;
+        ctx->tkn = NULL;
+        TRY_OR_EXIT(nextToken(ctx));
+        if (ctx->tkn->type == BRT_RND_L) {
             // 12. <STAT> -> id ( <PAR_LIST> ) <STAT>
-            saveToken();
-            tkn = first_tkn;
-            bool popframe = shouldPopFrame(StrRead(&(tkn->atr)));
-            TRY_OR_EXIT(parseFnCall(&result_type));
-            if (popframe) genCode(INS_POPFRAME, NULL, NULL, NULL);
-            genCode(INS_CLEARS, NULL, NULL, NULL); // volaná funkcia môže zanechať návratovú hodnotu na zásobníku
+            saveToken(ctx);
+            ctx->tkn = first_tkn;
+            bool popframe = shouldPopFrame(StrRead(&(ctx->tkn->atr)));
+            TRY_OR_EXIT(parseFnCall(ctx, &result_type));
+            if (popframe) genCode(&ctx->gen, INS_POPFRAME, NULL, NULL, NULL);
+            genCode(&ctx->gen, INS_CLEARS, NULL, NULL, NULL); // volaná funkcia môže zanechať návratovú hodnotu na zásobníku
         }
-        else if (tkn->type == ASSIGN) {
+        else if (ctx->tkn->type == ASSIGN) {
             // 10. <STAT> -> id = <ASSIGN> <STAT>
-            TSData_T* variable = SymTabLookup(&symt, StrRead(&(first_tkn->atr)));
+            TSData_T* variable = SymTabLookup(&ctx->symt, StrRead(&(first_tkn->atr)));
             if (variable == NULL) {
                 // v TS nie je záznam s daným identifikátorom => nedeklarovaná premenná
-                logErrSemantic(first_tkn, "%s was undeclared", StrRead(&(first_tkn->atr)));
+                logErrSemantic(&ctx->log, first_tkn, "%s was undeclared", StrRead(&(first_tkn->atr)));
                 return SEM_ERR_UNDEF;
             }
             if (variable->init && variable->let) {
                 // nemodifikovateľná premenná
-                logErrSemantic(first_tkn, "%s is unmodifiable and was already initialised", StrRead(&(first_tkn->atr)));
+                logErrSemantic(&ctx->log, first_tkn, "%s is unmodifiable and was already initialised", StrRead(&(first_tkn->atr)));
                 return SEM_ERR_OTHER;
             }
-            TRY_OR_EXIT(parseAssignment(&result_type, StrRead(&(variable->codename)), variable->type));
+            TRY_OR_EXIT(parseAssignment(ctx, &result_type, StrRead(&(variable->codename)), variable->type));
             if (!isCompatibleAssign(variable->type, result_type)) {
                 // nekompatibilný typ výsledku a premennej
-                logErrSemantic(first_tkn, "incompatible data types");
+                logErrSemantic(&ctx->log, first_tkn, "incompatible data types");
                 return SEM_ERR_TYPE;
             }
             variable->init = true;
             destroyToken(first_tkn);
         }
         else {
-            logErrSyntax(tkn, "'(' or '='");
+            logErrSyntax(&ctx->log, ctx->tkn, "'(' or '='");
             return SYN_ERR;
         }
         break;
     case BRT_CUR_L:;
         // 11. <STAT> -> { <STAT> } <STAT>
         bool block_had_return;
-        TRY_OR_EXIT(parseStatBlock(&block_had_return));
-        if (block_had_return) SymTabModifyLocalReturn(&symt, block_had_return);
+        TRY_OR_EXIT(parseStatBlock(ctx, &block_had_return));
+        if (block_had_return) SymTabModifyLocalReturn(&ctx->symt, block_had_return);
         break;
     case FUNC:;
         // 20. <STAT> -> func id ( <FN_SIG> ) <FN_RET_TYPE> { <STAT> } <STAT>
-        TRY_OR_EXIT(parseFunction());
+        if (ctx->options.incremental && ctx->options.cache != NULL && !ctx->options.stream &&
+            !ctx->gen.inside_fn_def && !ctx->inside_loop && ctx->symt.local == ctx->symt.global) {
+            TRY_OR_EXIT(parseFunctionIncremental(ctx)); // kód funkcie nezávisí od okolitých príkazov
+        }
+        else {
+            TRY_OR_EXIT(parseFunction(ctx));
+        }
         break;
     case RETURN:;
         // 32. <STAT> -> return <RET_VAL> <STAT>
-        TRY_OR_EXIT(parseReturn());
+        TRY_OR_EXIT(parseReturn(ctx));
         break;
     case IF:;
         // 35. <STAT> -> if <COND> { <STAT> } else { <STAT> } <STAT>
-        TRY_OR_EXIT(parseIf());
+        TRY_OR_EXIT(parseIf(ctx));
         break;
     case WHILE:;
         // 38. <STAT> -> while exp { <STAT> } <STAT>
-        TRY_OR_EXIT(parseWhile());
+        TRY_OR_EXIT(parseWhile(ctx));
         break;
     default:;
-        logErrSyntax(tkn, "beginning of a statement");
+        logErrSyntax(&ctx->log, ctx->tkn, "beginning of a statement");
         return SYN_ERR;
         break;
     }
@@ -1674,57 +1769,133 @@ int parse() {
     return COMPILATION_OK;
 }
 
-int checkIfAllFnDef() {
-    DLLstr_First(&check_def_fns);
-    while (DLLstr_IsActive(&check_def_fns))
+int checkIfAllFnDef(ctx_T *ctx) {
+    DLLstr_First(&ctx->check_def_fns);
+    while (DLLstr_IsActive(&ctx->check_def_fns))
     {
-        DLLstr_GetValue(&check_def_fns, &fn_name);
-        TSData_T* fn_info = SymTabLookupGlobal(&symt, StrRead(&fn_name));
+        DLLstr_GetValue(&ctx->check_def_fns, &ctx->fn_name);
+        TSData_T* fn_info = SymTabLookupGlobal(&ctx->symt, StrRead(&ctx->fn_name));
         if (!fn_info->init) {
-            logErrSemanticFn(StrRead(&fn_name), "was not defined");
+            logErrSemanticFn(&ctx->log, StrRead(&ctx->fn_name), "was not defined");
             return SEM_ERR_REDEF;
         }
-        DLLstr_Next(&check_def_fns);
+        DLLstr_Next(&ctx->check_def_fns);
     }
     return COMPILATION_OK;
 }
 
-void printOutCompiledCode() {
-    printf(".IFJcode23\n"); // povinná hlavička
+void setCompiledCodeOutput(ctx_T *ctx, int fd) {
+    ctx->output_fd = fd;
+}
 
-    // pomocné premenné
-    printf("DEFVAR %s\n", VAR_TMP1);
-    printf("DEFVAR %s\n", VAR_TMP2);
-    printf("DEFVAR %s\n", VAR_TMP3);
+int printOutCompiledCode(ctx_T *ctx) {
+    // dogenerovať inštrukcie pre vstavanú funkciu substring pokiaľ bola použitá
+    if (ctx->bifn_substring_called) {
+        genFnCodeBegin(&ctx->gen, "substring");
+        genSubstring(&ctx->gen);
+        genFnCodeEnd(&ctx->gen);
+    }
+
+    REPORT_ENTER(REPORT_OPTIMIZER);
+    optimizeCode(&ctx->gen); // optimalizácie nad celým vygenerovaným kódom
+    REPORT_LEAVE();
+
+    REPORT_ENTER(REPORT_OUTPUT);
+    if (ctx->options.short_names) { // krátke názvy premenných a náveští
+        FILE *map = NULL;
+        if (ctx->options.name_map != NULL && (map = fopen(ctx->options.name_map, "w")) == NULL) {
+            logErrCompiler(&ctx->log, "cannot open name map file");
+            REPORT_LEAVE();
+            return COMPILER_ERROR;
+        }
+        shortenNames(&ctx->gen, map);
+        if (map != NULL) fclose(map);
+    }
 
-    printf("JUMP !main\n"); // skok do hlavného tela programu
+    if (ctx->options.dump_cfg) { // namiesto kódu sa vypíše graf toku riadenia
+        int fd = dup(ctx->output_fd);
+        FILE *dump = fd < 0 ? NULL : fdopen(fd, "w");
+        if (dump == NULL) {
+            if (fd >= 0) close(fd);
+            logErrCompiler(&ctx->log, "cannot write compiled code");
+            REPORT_LEAVE();
+            return COMPILER_ERROR;
+        }
+        cfgPrintProgram(&ctx->gen, dump);
+        bool written = !ferror(dump);
+        if (fclose(dump) != 0) written = false;
+        REPORT_LEAVE();
+        if (!written) {
+            logErrCompiler(&ctx->log, "cannot write compiled code");
+            return COMPILER_ERROR;
+        }
+        return COMPILATION_OK;
+    }
 
-    // dogenerovať inštrukcie pre vstavanú funkciu substring pokiaľ bola použitá
-    if (bifn_substring_called) genSubstring();
+    printHeader(ctx); // pri postupnom výpise už mohla byť vypísaná spolu s hotovými funkciami
 
-    DLLstr_printContent(&code_fn); // kód uživateľských funkcií
+    writerList(&ctx->out, &ctx->gen.code_fn); // kód nedokončených definícií, za normálnych okolností prázdny
+    for (int i = 0; i < ctx->gen.code_fns.count; i++) {
+        writerList(&ctx->out, &(ctx->gen.code_fns.array[i].code)); // kód uživateľských funkcií, nevolané sú prázdne
+    }
 
     // hlavné telo programu
-    printf("LABEL !main\n");
-    DLLstr_printContent(&code_main);
-    printf("EXIT int@0\n");
+    writerLine(&ctx->out, "LABEL !main");
+    writerList(&ctx->out, &ctx->gen.code_main);
+    writerLine(&ctx->out, "EXIT int@0");
+
+    if (!writerFlush(&ctx->out)) {
+        logErrCompiler(&ctx->log, "cannot write compiled code");
+        REPORT_LEAVE();
+        return COMPILER_ERROR;
+    }
+    report_counters.output_lines = ctx->out.lines;
+    REPORT_LEAVE();
+    return COMPILATION_OK;
 }
 
-void destroyParser() {
-    if (tkn != NULL) {
-        destroyToken(tkn);
-        tkn = NULL;
+void destroyParser(ctx_T *ctx) {
+    if (ctx->tkn != NULL) {
+        destroyToken(ctx->tkn);
+        ctx->tkn = NULL;
     }
-    SymTabDestroy(&symt);
+    if (ctx->builtins != NULL) {
+        // symboly programu, vstavané funkcie ostávajú pre ďalší preklad
+        while (ctx->symt.local != ctx->symt.global) SymTabRemoveLocalBlock(&ctx->symt);
+        for (size_t i = 0; i < SYMTABLE_MAX_SIZE; i++) {
+            if (ctx->symt.global->array[i] != ctx->builtins->array[i]) SymTabDestroyElement(ctx->symt.global->array[i]);
+        }
+        memcpy(ctx->symt.global, ctx->builtins, SYMT_BLOCK_SIZE);
+    }
+    else {
+        SymTabDestroy(&ctx->symt);
+    }
+
+    StrDestroy(&ctx->fn_name);
+    DLLstr_Dispose(&ctx->check_def_fns);
 
-    StrDestroy(&fn_name);
-    DLLstr_Dispose(&check_def_fns);
+    StrDestroy(&ctx->first_loop_label);
+    DLLstr_Dispose(&ctx->variables_declared_inside_loop);
 
-    StrDestroy(&first_loop_label);
-    DLLstr_Dispose(&variables_declared_inside_loop);
+    genDestroy(&ctx->gen);
+}
+
+bool initializeBuiltIns(ctx_T *ctx) {
+    ctx->builtins = memAlloc(MEM_SYMTABLE, SYMT_BLOCK_SIZE);
+    if (ctx->builtins == NULL) return false;
+    SymTabInit(&ctx->symt);
+    loadBuiltInFunctionSignatures(ctx);
+    memcpy(ctx->builtins, ctx->symt.global, SYMT_BLOCK_SIZE);
+    return true;
+}
 
-    DLLstr_Dispose(&code_main);
-    DLLstr_Dispose(&code_fn);
+void destroyBuiltIns(ctx_T *ctx) {
+    if (ctx->builtins == NULL) return;
+    memcpy(ctx->symt.global, ctx->builtins, SYMT_BLOCK_SIZE);
+    ctx->symt.local = ctx->symt.global;
+    SymTabDestroy(&ctx->symt);
+    memFree(MEM_SYMTABLE, ctx->builtins);
+    ctx->builtins = NULL;
 }
 
 /* Koniec súboru parser.c */
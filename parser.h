@@ -13,6 +13,10 @@
 #include "scanner.h"
 #include "dll.h"
 #include "strR.h"
+#include "options.h"
+#include "logErr.h"
+#include "generator.h"
+#include "writer.h"
 
 #define COMPILATION_OK  0 ///< Preklad bez chýb
 #define LEX_ERR         1 ///< Chybný lexém 
@@ -36,21 +40,33 @@
     if (error_code != 0) return error_code; \
     } while (0)
 
- /**
-  * @brief Aktuálny načítaný token
- */
-extern token_T* tkn;
-
-/**
- * @brief Tabuľka symbolov (TS)
-*/
-extern SymTab_T symt;
-
 /**
- * @brief Indikuje, či sa aktuálne spracúva kód vo vnútri funkcie.
- * @details Podľa toho sa generovaný kód ukladá buď do code_fn alebo code_main.
+ * Kontext patrí jednému prekladu, funkcie parsera, precedenčnej analýzy a inkrementálneho
+ * prekladu ho dostávajú ako prvý parameter a ostatným modulom predávajú len ich časť
+ * (skener, hlásenie chýb, generátor). Vlákno môže mať vlastný kontext, preklady v rôznych
+ * vláknach tak nezdieľajú žiadny stav.
+ *
+ * @brief Stav prekladača počas prekladu jedného programu
 */
-extern bool parser_inside_fn_def;
+typedef struct ctx {
+    options_T options;      ///< nastavenia prekladu
+    scanner_T scanner;      ///< stav lexikálnej analýzy
+    errlog_T log;           ///< hlásenie chýb
+    gen_T gen;              ///< vygenerovaný kód a stav generátora
+    token_T *tkn;           ///< aktuálny načítaný token
+    SymTab_T symt;          ///< tabuľka symbolov (TS)
+    str_T fn_name;          ///< názov funkcie, ktorej definícia je práve spracovávaná
+    DLLstr_T check_def_fns; ///< funkcie, pri ktorých treba na konci sémantickej analýzy skontrolovať, či boli definované
+    bool inside_loop;       ///< parser sa nachádza vo vnútri cyklu
+    str_T first_loop_label; ///< meno náveštia na najvrchnejší cyklus
+    DLLstr_T variables_declared_inside_loop; ///< premenné, ktoré musia byť deklarované pred prvým nespracovaným cyklom
+    bool bifn_substring_called; ///< bola volaná vstavaná funkcia "substring"
+    writer_T out;           ///< výstup vygenerovaného kódu, pri postupnom výpise (--stream) sa používa už počas prekladu
+    bool header_printed;    ///< hlavička cieľového kódu už bola vypísaná
+    int streamed_fns;       ///< počet funkcií zo začiatku code_fns, ktoré už boli vypísané (--stream)
+    int output_fd;          ///< súborový deskriptor, do ktorého sa vypisuje vygenerovaný kód
+    TSBlock_T *builtins;    ///< globálny blok TS so vstavanými funkciami pre opakované preklady, inak NULL
+} ctx_T;
 
 /**
  * @brief Zistí kompatibilitu priradenia dvoch typov
@@ -61,21 +77,38 @@ extern bool parser_inside_fn_def;
 bool isCompatibleAssign(char dest, char src);
 
 /**
- * @brief Uvoľní aktuálne načítaný token v globálnej premennej tkn a nahradí ho novým zo scannera
+ * @brief Uvoľní aktuálne načítaný token ctx->tkn a nahradí ho novým zo scannera
  * @return 0 v prípade úspechu, inak číslo chyby
 */
-int nextToken();
+int nextToken(ctx_T *ctx);
 
 /**
- * @brief Uloží token v globálnej premennej tkn do úschovňe skenera a prepíše tkn na NULL
+ * @brief Uloží token ctx->tkn do úschovňe skenera a prepíše ctx->tkn na NULL
 */
-void saveToken();
+void saveToken(ctx_T *ctx);
 
 /**
+ * Ak bol kontext pripravený funkciou initializeBuiltIns, signatúry vstavaných funkcií sa
+ * nevytvárajú znova, globálny blok TS sa len obnoví do stavu po ich vložení.
  * @brief Inicializácia dátových štruktúr parsera
  * @return true v prípade úspechu, inak false
 */
-bool initializeParser();
+bool initializeParser(ctx_T *ctx);
+
+/**
+ * Signatúry vstavaných funkcií sa vložia do TS raz a ostanú v nej pre všetky ďalšie preklady
+ * v tomto kontexte, initializeParser a destroyParser potom obnovujú len zvyšok TS. Volá sa
+ * mimo prekladu (napr. raz pre vlákno servera), aby sa signatúry nealokovali v aréne prekladu.
+ *
+ * @brief Pripraví kontext na opakované preklady
+ * @return true v prípade úspechu, inak false
+*/
+bool initializeBuiltIns(ctx_T *ctx);
+
+/**
+ * @brief Uvoľní signatúry vstavaných funkcií kontextu pripraveného funkciou initializeBuiltIns
+*/
+void destroyBuiltIns(ctx_T *ctx);
 
 /**
  * Stav tkn:
@@ -85,23 +118,32 @@ bool initializeParser();
  * @brief Hlavná časť parsera, funkcia spracúva jeden <STAT>
  * @return 0 v prípade úspechu, inak číslo chyby
 */
-int parse();
+int parse(ctx_T *ctx);
 
 /**
  * @brief Skontroluje, či boli definované všetky volané funkcie
  * @return 0 ak je všetko v poriadku, inak číslo chyby
 */
-int checkIfAllFnDef();
+int checkIfAllFnDef(ctx_T *ctx);
 
 /**
+ * @brief Nastaví súborový deskriptor, do ktorého sa vypíše vygenerovaný kód (predvolene stdout)
+*/
+void setCompiledCodeOutput(ctx_T *ctx, int fd);
+
+/**
+ * Pri postupnom výpise (--stream) sú hlavička a kód dokončených funkcií vypísané už počas
+ * prekladu, v prípade chyby prekladu je preto na stdout len časť programu.
+ *
  * @brief Vypíše na stdout vygenerovaný IFJcode23.
+ * @return 0 v prípade úspechu, COMPILER_ERROR ak výstup nie je možné zapísať
 */
-void printOutCompiledCode();
+int printOutCompiledCode(ctx_T *ctx);
 
 /**
  * @brief Uvoľní všetky hlavné zdroje využívané prekladačom (parsera)
 */
-void destroyParser();
+void destroyParser(ctx_T *ctx);
 
 #endif // ifndef _PARSER_H_
 /* Koniec súboru parser.h */
@@ -0,0 +1,157 @@
+/** Projekt IFJ2023
+ * @file report.c
+ * @brief Meranie času jednotlivých fáz prekladu a počítadlá (--time-report)
+ * @author agent (agent@local)
+ * @date 19.10.2026
+ */
+
+#define _GNU_SOURCE // mallinfo2
+
+#include <malloc.h>
+#include <time.h>
+#include "report.h"
+#include "memory.h"
+
+/** Maximálna hĺbka vnorenia fáz, hlbšie vnorené fázy sa pripíšu nadradenej */
+#define REPORT_MAX_DEPTH 32
+
+/**
+ * Procesorový čas vlákna sa číta systémovým volaním (rádovo stovky ns, reálny čas cez vDSO
+ * desiatky ns), pri fázach trvajúcich mikrosekundy by meranie skreslilo výsledok. Číta sa preto
+ * najviac raz za túto dobu v ms a rozdelí sa medzi fázy od posledného čítania podľa reálneho času.
+*/
+#define REPORT_CPU_PERIOD_MS 0.1
+
+/** Názvy fáz vo výpise */
+static const char *report_names[REPORT_PHASES] = {
+    "other", "scanner", "parser", "expressions", "symtable", "codegen", "defvars",
+    "cache", "optimizer", "output", "teardown"
+};
+
+/**
+ * @brief Stav merania v jednom vlákne
+*/
+typedef struct report_state {
+    int stack[REPORT_MAX_DEPTH];    ///< zásobník začatých fáz
+    int depth;                      ///< počet fáz na zásobníku
+    int overflow;                   ///< počet začatých fáz nad REPORT_MAX_DEPTH
+    struct timespec wall;           ///< reálny čas poslednej zmeny fázy
+    struct timespec cpu;            ///< procesorový čas vlákna pri poslednom čítaní
+    double pending_ms[REPORT_PHASES]; ///< reálny čas fáz od posledného čítania procesorového času
+    double pending_total_ms;        ///< súčet pending_ms
+    double wall_ms[REPORT_PHASES];  ///< reálny čas fáz v ms
+    double cpu_ms[REPORT_PHASES];   ///< procesorový čas fáz v ms
+    long calls[REPORT_PHASES];      ///< počet začatí fáz
+} report_state_T;
+
+_Thread_local report_counters_T report_counters;
+
+_Thread_local bool report_enabled = false;
+
+static _Thread_local report_state_T report;
+
+/**
+ * @brief Rozdiel časov v milisekundách
+*/
+static double reportMs(struct timespec *from, struct timespec *to) {
+    return (to->tv_sec - from->tv_sec) * 1e3 + (to->tv_nsec - from->tv_nsec) / 1e6;
+}
+
+/**
+ * @brief Rozdelí procesorový čas od posledného čítania medzi fázy podľa ich reálneho času
+*/
+static void reportSampleCpu() {
+    struct timespec cpu;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &cpu);
+    double elapsed = reportMs(&report.cpu, &cpu);
+    for (int i = 0; i < REPORT_PHASES; i++) {
+        if (report.pending_total_ms > 0) report.cpu_ms[i] += elapsed * report.pending_ms[i] / report.pending_total_ms;
+        report.pending_ms[i] = 0;
+    }
+    if (report.pending_total_ms <= 0) report.cpu_ms[report.stack[report.depth - 1]] += elapsed;
+    report.pending_total_ms = 0;
+    report.cpu = cpu;
+}
+
+/**
+ * @brief Pripíše čas od poslednej zmeny fázy fáze na vrchole zásobníka
+*/
+static void reportSwitch() {
+    struct timespec wall;
+    clock_gettime(CLOCK_MONOTONIC, &wall);
+    int phase = report.stack[report.depth - 1];
+    double elapsed = reportMs(&report.wall, &wall);
+    report.wall_ms[phase] += elapsed;
+    report.pending_ms[phase] += elapsed;
+    report.pending_total_ms += elapsed;
+    report.wall = wall;
+    if (report.pending_total_ms >= REPORT_CPU_PERIOD_MS) reportSampleCpu();
+}
+
+void reportBegin(bool enabled) {
+    report_enabled = enabled;
+    if (!enabled) return;
+    report = (report_state_T){ .depth = 1 };
+    report.stack[0] = REPORT_OTHER;
+    report.calls[REPORT_OTHER] = 1;
+    report_counters = (report_counters_T){ .heap_bytes = -1 };
+    clock_gettime(CLOCK_MONOTONIC, &report.wall);
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &report.cpu);
+}
+
+void reportEnter(report_phase_T phase) {
+    reportSwitch();
+    report.calls[phase]++;
+    if (report.depth < REPORT_MAX_DEPTH) report.stack[report.depth++] = phase;
+    else report.overflow++;
+}
+
+void reportLeave() {
+    reportSwitch();
+    if (report.overflow > 0) report.overflow--;
+    else if (report.depth > 1) report.depth--;
+}
+
+void reportSampleHeap() {
+    struct mallinfo2 info = mallinfo2();
+    report_counters.heap_bytes = (long)(info.uordblks + info.hblkhd); // aj bloky alokované cez mmap
+}
+
+void reportPrint(FILE *out, bool json) {
+    reportSwitch();
+    reportSampleCpu();
+    double wall = 0, cpu = 0;
+    for (int i = 0; i < REPORT_PHASES; i++) {
+        wall += report.wall_ms[i];
+        cpu += report.cpu_ms[i];
+    }
+    report_counters_T *c = &report_counters;
+    mem_stats_T mem = memStats(MEM_TAGS);
+
+    if (json) {
+        fprintf(out, "{\"phases\":{");
+        for (int i = 0; i < REPORT_PHASES; i++) {
+            fprintf(out, "%s\"%s\":{\"wall_ms\":%.3f,\"cpu_ms\":%.3f,\"calls\":%ld}", i > 0 ? "," : "",
+                report_names[i], report.wall_ms[i], report.cpu_ms[i], report.calls[i]);
+        }
+        fprintf(out, "},\"total\":{\"wall_ms\":%.3f,\"cpu_ms\":%.3f},\"counters\":{\"tokens\":%ld,"
+            "\"instructions\":%ld,\"output_lines\":%ld,\"symtable_lookups\":%ld,\"heap_bytes\":%ld,"
+            "\"allocations\":%ld,\"allocated_bytes\":%ld,\"peak_bytes\":%ld}}\n",
+            wall, cpu, c->tokens, c->instructions, c->output_lines, c->lookups, c->heap_bytes,
+            mem.allocs, mem.bytes, mem.peak);
+        return;
+    }
+
+    fprintf(out, "time report:\n  %-12s %10s %10s %7s %10s\n", "phase", "wall ms", "cpu ms", "wall %", "calls");
+    for (int i = 0; i < REPORT_PHASES; i++) {
+        if (report.calls[i] == 0) continue;
+        fprintf(out, "  %-12s %10.3f %10.3f %6.1f%% %10ld\n", report_names[i], report.wall_ms[i], report.cpu_ms[i],
+            wall > 0 ? 100.0 * report.wall_ms[i] / wall : 0.0, report.calls[i]);
+    }
+    fprintf(out, "  %-12s %10.3f %10.3f %6.1f%%\n", "total", wall, cpu, 100.0);
+    fprintf(out, "  tokens %ld, instructions %ld, output lines %ld, symtable lookups %ld, heap %ld B\n",
+        c->tokens, c->instructions, c->output_lines, c->lookups, c->heap_bytes);
+    fprintf(out, "  allocations %ld, allocated %ld B, peak %ld B\n", mem.allocs, mem.bytes, mem.peak);
+}
+
+/* Koniec súboru report.c */
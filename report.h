@@ -0,0 +1,100 @@
+/** Projekt IFJ2023
+ * @file report.h
+ * @brief Meranie času jednotlivých fáz prekladu a počítadlá (--time-report)
+ * @author agent (agent@local)
+ * @date 19.10.2026
+ */
+
+#ifndef _REPORT_H_
+#define _REPORT_H_
+
+#include <stdbool.h>
+#include <stdio.h>
+
+/**
+ * Čas sa pripisuje fáze na vrchole zásobníka fáz, vnorené fázy sa do nadradenej nezapočítavajú.
+ * @brief Fázy prekladu
+*/
+typedef enum report_phase {
+    REPORT_OTHER,       ///< nastavenie prekladu, čítanie vstupu a čas mimo ostatných fáz
+    REPORT_SCANNER,     ///< lexikálna analýza (getToken)
+    REPORT_PARSER,      ///< syntaktická a sémantická analýza rekurzívnym zostupom
+    REPORT_EXPRESSION,  ///< precedenčná analýza výrazov (parseExpression)
+    REPORT_SYMTABLE,    ///< vyhľadávanie a vkladanie do tabuľky symbolov
+    REPORT_CODEGEN,     ///< generovanie inštrukcií (genCode)
+    REPORT_DEFVARS,     ///< presun definícií premenných pred cyklus (genDefVarsBeforeLoop)
+    REPORT_CACHE,       ///< vyhľadávanie a ukladanie do prekladovej cache
+    REPORT_OPTIMIZER,   ///< optimalizácie nad celým vygenerovaným kódom
+    REPORT_OUTPUT,      ///< skracovanie názvov a výpis cieľového kódu
+    REPORT_TEARDOWN,    ///< uvoľnenie dátových štruktúr prekladača
+    REPORT_PHASES       ///< počet fáz
+} report_phase_T;
+
+/**
+ * @brief Počítadlá udalostí počas prekladu
+*/
+typedef struct report_counters {
+    long tokens;        ///< počet tokenov prečítaných skenerom
+    long instructions;  ///< počet vygenerovaných inštrukcií (pred optimalizáciami)
+    long output_lines;  ///< počet vypísaných riadkov cieľového kódu
+    long lookups;       ///< počet vyhľadaní v tabuľke symbolov
+    long heap_bytes;    ///< obsadená halda pred uvoľnením prekladača (celý proces), -1 ak nie je známa
+} report_counters_T;
+
+/**
+ * @brief Počítadlá aktuálneho prekladu v tomto vlákne
+*/
+extern _Thread_local report_counters_T report_counters;
+
+/**
+ * Meranie patrí vláknu, ktoré prekladá, a nie je súčasťou kontextu prekladu, aby sa fázy
+ * dali vyznačiť aj vo funkciách, ktoré kontext nedostávajú (napr. tabuľka symbolov).
+ * @brief Meranie je v tomto vlákne zapnuté (--time-report), nastavuje reportBegin
+*/
+extern _Thread_local bool report_enabled;
+
+/**
+ * @brief Začne fázu prekladu, ak je zapnuté meranie (--time-report)
+*/
+#define REPORT_ENTER(phase) \
+    do { if (report_enabled) reportEnter(phase); } while (0)
+
+/**
+ * @brief Ukončí naposledy začatú fázu prekladu, ak je zapnuté meranie (--time-report)
+*/
+#define REPORT_LEAVE() \
+    do { if (report_enabled) reportLeave(); } while (0)
+
+/**
+ * Nameraný čas sa vynuluje, začne sa fáza REPORT_OTHER. Meria sa reálny čas (CLOCK_MONOTONIC)
+ * a procesorový čas vlákna (CLOCK_THREAD_CPUTIME_ID), ten sa medzi krátke fázy rozdeľuje
+ * podľa ich reálneho času.
+ *
+ * @brief Začne meranie prekladu v tomto vlákne
+ * @param enabled merať čas fáz, inak sa meranie v tomto vlákne vypne
+*/
+void reportBegin(bool enabled);
+
+/**
+ * @brief Začne vnorenú fázu prekladu
+*/
+void reportEnter(report_phase_T phase);
+
+/**
+ * @brief Ukončí naposledy začatú fázu prekladu a pokračuje v nadradenej
+*/
+void reportLeave();
+
+/**
+ * @brief Zaznamená veľkosť obsadenej haldy, volá sa pred uvoľnením dátových štruktúr prekladača
+*/
+void reportSampleHeap();
+
+/**
+ * @brief Ukončí meranie a vypíše čas fáz a počítadlá
+ * @param json vypísať jeden riadok vo formáte JSON namiesto tabuľky
+*/
+void reportPrint(FILE *out, bool json);
+
+#endif // ifndef _REPORT_H_
+/* Koniec súboru report.h */
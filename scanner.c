@@ -15,6 +15,7 @@
 #include <stdbool.h>
 #include <string.h>
 #include "scanner.h"
+#include "memory.h"
 
 #define END_OF_MULTILINE_STRING 3 //Počet uvozovek které jsou třeba k uknčení víceřádkového řetězce
 
@@ -49,8 +50,35 @@ typedef enum state {
     NESTED_COMMENT_S
 } state_t;
 
-///< úschovňa pre jeden token
-token_T *storage = NULL; 
+/**
+ * @brief Vráti súbor, z ktorého skener číta
+ */
+static FILE *scannerInput(scanner_T *s) {
+    return s->input != NULL ? s->input : stdin;
+}
+
+void scannerReset(scanner_T *s, FILE *input) {
+    if (s->storage != NULL) {
+        destroyToken(s->storage);
+        s->storage = NULL;
+    }
+    while (s->replay_count > 0) destroyToken(s->replay[--s->replay_count]);
+    if (input == NULL) { // koniec prekladu
+        memFree(MEM_SCANNER, s->replay);
+        s->replay = NULL;
+        s->replay_capacity = 0;
+    }
+    s->input = input;
+    s->ln = 1;
+    s->col = 0;
+    s->escape_state = 0;
+    s->escape_digits = 0;
+    s->tokens = 0;
+}
+
+long scannerTokenCount(scanner_T *s) {
+    return s->tokens;
+}
 
 /**
  * @brief Převede řetězec, který odpovídá klíčovému slovu na odpovídající token id. Tedy funkce slouží jako tabulka klíčových slov
@@ -93,7 +121,7 @@ int keyw_token_num(char * string) {
  */
 token_T* init_token(token_T **token) {
     //alokace pameti pro token
-    *token = malloc(sizeof(token_T));
+    *token = memAlloc(MEM_SCANNER, sizeof(token_T));
 
     //alokace paměti pro token se nepovedla, vrať false
     if (*token == NULL) {
@@ -127,14 +155,13 @@ void set_token(token_T* token, int type, str_T atr, int ln, int col) {
 /**
  * @brief Funkce funguje jako podautomat. Analyzuje escape sekvence v řetězci
  * 
+ * @param s stav skenera
  * @param c 
  * @return int 
  */
-int escape_seq_process(char c) {
-    static int state = 0; //Stav -- stavy jsou celkem tři {0,1,2}
-    static int num_of_digits = 0; //Zde bude uložen počet hexadecimálních číslic (může jich být maximálně 8)
+int escape_seq_process(scanner_T *s, char c) {
     int result = 0; //Výsledek procesu (zpracování escape sekvence), 0 = false, 1 = true, -1 = je v procesu
-    switch (state)
+    switch (s->escape_state)
     {
     case 0: ;//jednoduché (jednoznakové) escape sekvence
         switch (c) {
@@ -147,7 +174,7 @@ int escape_seq_process(char c) {
                 break;
             case 'u': ;
                 //unicode escape sekvence
-                state = 1;
+                s->escape_state = 1;
                 result = -1;
                 break;
             default:
@@ -158,23 +185,23 @@ int escape_seq_process(char c) {
         break;
     case 1: ;//na vstupu je levá složená závorka
         if (c == '{') {
-            state = 2;
+            s->escape_state = 2;
             result = -1;
         } else { 
             result = 0;  
         }
         break;
     case 2: ;
-        if (isxdigit(c) && num_of_digits < 8) {
+        if (isxdigit(c) && s->escape_digits < 8) {
         //Na vstupu může být jakékoliv hexadecimální číslo, ale může jich být pouze 8
-            state = 2;
+            s->escape_state = 2;
             result = -1;
-            num_of_digits++;
-        } else if (c == '}' && num_of_digits >= 1) {
+            s->escape_digits++;
+        } else if (c == '}' && s->escape_digits >= 1) {
         //Ukončení této sekvence pomocí levé složené závorky
         //Uvnitř složených závorek musí být alespoň jedna hexadecimální číslice
-            num_of_digits = 0;
-            state = 0;
+            s->escape_digits = 0;
+            s->escape_state = 0;
             result = 1;
         } else {
         //Na vstupu je špatný znak
@@ -188,9 +215,10 @@ int escape_seq_process(char c) {
  * @brief Funkce vypočítá výsledné odsazení nejbližší trojice uvozovek od místa použití funkce
  *          Funkce navrátí ukazatel do souboru na místo, odkud byla použita
  * 
+ * @param s stav skenera
  * @return odsazení první nalezené """
  */
-int get_indentation() {
+int get_indentation(scanner_T *s) {
     int c;
     int indent = 0;
     bool possibility_to_find = true;
@@ -198,7 +226,7 @@ int get_indentation() {
     int num_of_readed_characters = 0;
     
     // Čtení znaků ze vstupu a hledání prvních trojitých uvozovek
-    while ((c = fgetc(stdin)) != EOF) {
+    while ((c = fgetc(scannerInput(s))) != EOF) {
         if (c == EOF) {
             indent = 0;
             break;
@@ -216,7 +244,7 @@ int get_indentation() {
             
             num_of_quotes = 1;
 
-            while ((c = fgetc(stdin)) == '"') {
+            while ((c = fgetc(scannerInput(s))) == '"') {
                 num_of_quotes++;
             }
 
@@ -235,11 +263,11 @@ int get_indentation() {
         indent = 0;
       }
     }
-    fseek(stdin, -num_of_readed_characters, SEEK_CUR);
+    fseek(scannerInput(s), -num_of_readed_characters, SEEK_CUR);
     return indent + 1;
 }
 
-token_T *getToken()
+token_T *getToken(scanner_T *s)
 {
     //stav automatu
     state_t state = 0;
@@ -248,10 +276,6 @@ token_T *getToken()
     //Proměnná reprezentuje konkrétní token, pokud je rovna -1, znamená to, že token ještě nebyl zpracován
     int id_token = -1;
 
-    //Lokální statické proměnné pro řádek a sloupec začínajícího tokenu
-    static int ln = 1;          //řádek
-    static int col = 0;         //sloupec
-
     //Pomocné proměnné pro některé stavy
     int col_begin_token = 0;        //speciální proměnná pro uložení pozice, kde začíná víceznakový token (string, identifikátor,...)
     int line_begin_token = 0;       //speciální proměnná pro uložení pozice, kde začíná víceznakový token (string, identifikátor,...)
@@ -264,29 +288,31 @@ token_T *getToken()
     //zde bude uložený nový token
     token_T *tkn = NULL;
 
-    if (storage != NULL) {
-        tkn = storage;
-        storage = NULL;
+    if (s->storage != NULL) {
+        tkn = s->storage;
+        s->storage = NULL;
         return tkn;
     }
+    if (s->replay_count > 0) return s->replay[--s->replay_count];
     
     //inicializace struktury
     if (init_token(&tkn) == NULL) {
         return NULL;
     }
+    s->tokens++;
     //inicializace řetězce, kam se budou ukládat víceznakové tokeny
     StrInit(&tkn->atr);
 /*===============================================================HLAVNÍ SMYČKA===============================================================*/
     while(true) {
         //načtení znaku ze souboru
-        c = getc(stdin);
+        c = getc(scannerInput(s));
 
         //přečtený další znak na jednom řádku
-        col++;
+        s->col++;
         //Znak nového řádku, je třeba inkrementovat ln = line number
         if (c == '\n') {
-            ln++;
-            col = 0;
+            s->ln++;
+            s->col = 0;
         }
 
         //proměnná indikuje, jestli se má vložit znak zpět do streamu nebo ne
@@ -296,8 +322,8 @@ token_T *getToken()
 /*=======================================STATE=======================================*/
             case INIT_STATE_S: ;
 
-                col_begin_token = col;
-                line_begin_token = ln;
+                col_begin_token = s->col;
+                line_begin_token = s->ln;
                 add_char_to_tkn = true;
 
                 if (isspace(c)) {
@@ -604,7 +630,7 @@ token_T *getToken()
                     state = MULTI_LINE_NEW_LINE_S;
                     add_char_to_tkn = false;
                     //Nyni se vypocita, jake odsazeni maji posledni ukoncovaci uvozovky
-                    indent = get_indentation();
+                    indent = get_indentation(s);
                     
                 } else if (isblank(c)) {
                     //Bílé znaky se ignorují
@@ -633,7 +659,7 @@ token_T *getToken()
                     state = MULTI_LINE_NEW_LINE_S;
                 } else {
                     //Dalsi mezery se pridaji
-                    int indentation = col - indent;
+                    int indentation = s->col - indent;
                     //Kontrola spravneho odsazeni
                     if (indentation < 0) {
                         id_token = INVALID;
@@ -695,7 +721,7 @@ token_T *getToken()
 /*=======================================STATE=======================================*/
             case ESCAPE_SEKV_S: ;
                 //Zde se zpracovává escape sekvence v řetězci
-                int esc_seq_proc = escape_seq_process(c);
+                int esc_seq_proc = escape_seq_process(s, c);
                 if (esc_seq_proc == -1) {
                     //analýza escape sekvence není u konce, zůstává se v tomto stavu
                     state = ESCAPE_SEKV_S;
@@ -785,12 +811,12 @@ token_T *getToken()
             //Vraceny znak do streamu se nebude pridavat do retezce
             add_char_to_tkn = false;
             //Je třeba vrátit znak do streamu 
-            //Pokud znak, který bude vrácen je "new line", je třeba decrementovat i ln, aby se znak \n nepřečetl dvakrát
+            //Pokud znak, který bude vrácen je "new line", je třeba decrementovat i s->ln, aby se znak \n nepřečetl dvakrát
             if (c == '\n')
-                ln--;
+                s->ln--;
 
-            col--;
-            ungetc(c, stdin);
+            s->col--;
+            ungetc(c, scannerInput(s));
         }
         //Přidání znaku do atributu tokenu
         if (add_char_to_tkn) {
@@ -822,12 +848,21 @@ token_T *getToken()
     return NULL;
 }
 
-void storeToken(token_T *tkn)
+void storeToken(scanner_T *s, token_T *tkn)
 {
-    storage = tkn;
+    s->storage = tkn;
+}
+
+void unreadTokens(scanner_T *s, token_T **tokens, int count) {
+    if (s->replay_count + count > s->replay_capacity) {
+        s->replay_capacity = (s->replay_count + count) * 2;
+        s->replay = memRealloc(MEM_SCANNER, s->replay, sizeof(token_T *) * s->replay_capacity);
+        if (s->replay == NULL) exit(99);
+    }
+    for (int i = count - 1; i >= 0; i--) s->replay[s->replay_count++] = tokens[i];
 }
 
 void destroyToken(token_T *tkn) {
     StrDestroy(&tkn->atr);
-    free(tkn);
+    memFree(MEM_SCANNER, tkn);
 }
\ No newline at end of file
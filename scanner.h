@@ -8,6 +8,7 @@
 #ifndef _SCANNER_H_
 #define _SCANNER_H_
 
+#include <stdio.h>
 #include "strR.h"
 
 /**
@@ -70,6 +71,24 @@ typedef struct token
     int col;       ///< pozícia prvého charakteru tokenu v riadku
 } token_T;
 
+/**
+ * Pred prvým použitím musí byť štruktúra vynulovaná a nastavená funkciou scannerReset.
+ * @brief Stav skenera počas prekladu jedného programu
+ */
+typedef struct scanner
+{
+    FILE *input;            ///< vstup skenera, NULL značí stdin
+    token_T *storage;       ///< úschovňa pre jeden token
+    token_T **replay;       ///< tokeny vrátené skeneru (zásobník, posledný sa prečíta ako prvý), čítajú sa pred vstupom
+    int replay_count;       ///< počet vrátených tokenov
+    int replay_capacity;    ///< kapacita poľa replay
+    int ln;                 ///< riadok naposledy prečítaného znaku
+    int col;                ///< stĺpec naposledy prečítaného znaku
+    int escape_state;       ///< stav spracovania escape sekvencie (0, 1, 2)
+    int escape_digits;      ///< počet hexadecimálnych číslic escape sekvencie
+    long tokens;            ///< počet tokenov načítaných zo vstupu od posledného scannerReset
+} scanner_T;
+
 /**
  * @brief Vráti uschovaný token, inak prečíta ďalší token na vstupe STDIN
  * @return ukazateľ na alokovaný token
@@ -80,13 +99,37 @@ typedef struct token
  *  - ln:       riadok, ktorým začínal token
  *  - col:      stĺpec, ktorým začínal token
  */
-token_T *getToken();
+token_T *getToken(scanner_T *s);
+
+/**
+ * Zahodí uschovaný token a nastaví pozíciu na začiatok vstupu, volá sa pred prekladom
+ * ďalšieho programu v tom istom procese.
+ *
+ * @brief Nastaví vstup skenera
+ * @param s stav skenera
+ * @param input súbor so zdrojovým programom, musí umožňovať fseek, NULL značí koniec prekladu
+ *              (uvoľní pamäť skenera) a čítanie zo stdin
+ */
+void scannerReset(scanner_T *s, FILE *input);
+
+/**
+ * @brief Počet tokenov načítaných zo vstupu od posledného volania scannerReset (bez vrátených tokenov)
+ */
+long scannerTokenCount(scanner_T *s);
 
 /**
  * @brief Uloží token do pamäte skenera
- * @details Hodnota je uschovaná v globálnej premennej. NULL značí, že pamäť je prázdna.
+ * @details Hodnota je uschovaná v stave skenera. NULL značí, že pamäť je prázdna.
+ */
+void storeToken(scanner_T *s, token_T *tkn);
+
+/**
+ * Token uložený pomocou storeToken sa prečíta pred nimi, vstup skenera až po nich.
+ * @brief Vráti skeneru predčítané tokeny, getToken ich vráti v poradí tokens[0], tokens[1], ...
+ * @param tokens pole tokenov, skener preberá ich vlastníctvo (nie poľa)
+ * @param count počet tokenov
  */
-void storeToken(token_T *tkn);
+void unreadTokens(scanner_T *s, token_T **tokens, int count);
 
 /**
  * @brief Dealokuje datovou strukturu token
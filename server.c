@@ -0,0 +1,231 @@
+/** Projekt IFJ2023
+ * @file server.c
+ * @brief Prekladový server na lokálnom UNIX sockete
+ * @author agent (agent@local)
+ * @date 19.10.2026
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <errno.h>
+#include <pthread.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include <sys/un.h>
+#include <time.h>
+#include <unistd.h>
+#include "server.h"
+#include "compiler.h"
+#include "parser.h"
+#include "writer.h"
+
+/** Maximálny počet vlákien servera */
+#define SERVER_MAX_JOBS 256
+
+/** Pauza v nanosekundách po chybe accept, ktorú nespôsobil klient (napr. EMFILE) */
+#define SERVER_ACCEPT_BACKOFF_NS 100000000L
+
+/**
+ * @brief Stav servera spoločný pre všetky vlákna
+*/
+typedef struct server {
+    int socket;         ///< počúvajúci socket
+    options_T defaults; ///< nastavenia servera, predvolené pre každú požiadavku
+} server_T;
+
+/** Cesta k socketu, ktorý sa odstráni pri ukončení servera */
+static char *server_path = NULL;
+
+/**
+ * @brief Obsluha SIGINT a SIGTERM, odstráni socket a ukončí server
+*/
+static void serverStop(int sig) {
+    (void)sig;
+    if (server_path != NULL) unlink(server_path);
+    _exit(COMPILATION_OK);
+}
+
+/**
+ * @brief Odošle obsah dočasného súboru
+ * @return true v prípade úspechu, inak false
+*/
+static bool serverSendFile(int conn, FILE *f, long size) {
+    char buffer[SERVER_MAX_LINE];
+    while (size > 0) {
+        size_t n = fread(buffer, 1, size < (long)sizeof(buffer) ? (size_t)size : sizeof(buffer), f);
+        if (n == 0 || !writerWriteAll(conn, buffer, n)) return false;
+        size -= n;
+    }
+    return true;
+}
+
+/**
+ * Prepínače --batch, --server, --name-map a --cache sa v požiadavke nepovoľujú, pracujú so súbormi servera.
+ * @brief Načíta prepínače z hlavičky požiadavky a nastaví podľa nich options
+ * @param options nastavenia požiadavky, výsledok
+ * @return true v prípade úspechu, inak false
+*/
+static bool serverReadOptions(FILE *in, options_T *defaults, options_T *options) {
+    char line[SERVER_MAX_LINE];
+    if (fgets(line, sizeof(line), in) == NULL) return false;
+    char *end;
+    long argc = strtol(line, &end, 10);
+    if (end == line || *end != '\n' || argc < 0 || argc > SERVER_MAX_ARGS) return false;
+
+    char *argv[SERVER_MAX_ARGS + 1] = { "server" };
+    bool ok = true;
+    int count = 0;
+    for (; count < argc; count++) {
+        if (fgets(line, sizeof(line), in) == NULL || strchr(line, '\n') == NULL) {
+            ok = false;
+            break;
+        }
+        *strchr(line, '\n') = '\0';
+        argv[count + 1] = strdup(line);
+        if (argv[count + 1] == NULL) exit(COMPILER_ERROR);
+    }
+
+    *options = *defaults;
+    ok = ok && parseOptions(argc + 1, argv, options) && options->batch == NULL && options->server == NULL &&
+        options->name_map == NULL && options->cache == defaults->cache;
+    for (int i = 1; i <= count; i++) free(argv[i]);
+    options->name_map = NULL; // ukazovali do uvoľnených argumentov
+    options->batch = options->server = NULL;
+    return ok;
+}
+
+/**
+ * Skener sa pri viacriadkových reťazcoch vracia vo vstupe (fseek), program sa preto
+ * najprv uloží do dočasného súboru.
+ * @brief Obslúži jedno spojenie, preloží program z požiadavky a odošle výsledok
+*/
+static void serverHandle(ctx_T *ctx, int conn, options_T *defaults) {
+    FILE *in = fdopen(conn, "r");
+    FILE *source = tmpfile(), *code = tmpfile(), *diagnostics = tmpfile();
+    if (in == NULL || source == NULL || code == NULL || diagnostics == NULL) {
+        if (in != NULL) fclose(in);
+        else close(conn);
+        if (source != NULL) fclose(source);
+        if (code != NULL) fclose(code);
+        if (diagnostics != NULL) fclose(diagnostics);
+        return;
+    }
+
+    options_T options;
+    bool options_ok = serverReadOptions(in, defaults, &options);
+    char buffer[SERVER_MAX_LINE];
+    size_t n;
+    while ((n = fread(buffer, 1, sizeof(buffer), in)) > 0) fwrite(buffer, 1, n, source);
+    bool received = !ferror(in); // napr. vypršal SERVER_RECV_TIMEOUT_SEC
+    rewind(source);
+
+    int result = COMPILER_ERROR;
+    if (!received) {
+        fprintf(diagnostics, "incomplete request\n");
+    }
+    else if (options_ok) {
+        compiler_T c = { source, fileno(code), diagnostics, options, false };
+        result = compileWith(ctx, &c);
+    }
+    else {
+        fprintf(diagnostics, "invalid options in request\n");
+    }
+
+    char header[SERVER_MAX_LINE];
+    long code_size = writerFileSize(code), diagnostics_size = writerFileSize(diagnostics);
+    if (code_size < 0 || diagnostics_size < 0) code_size = diagnostics_size = 0;
+    int len = snprintf(header, sizeof(header), "%d %ld %ld\n", result, code_size, diagnostics_size);
+    if (writerWriteAll(conn, header, len) && serverSendFile(conn, code, code_size)) {
+        serverSendFile(conn, diagnostics, diagnostics_size);
+    }
+
+    fclose(source);
+    fclose(code);
+    fclose(diagnostics);
+    fclose(in);
+}
+
+/**
+ * @brief Vlákno, ktoré prijíma a obsluhuje spojenia
+*/
+static void *serverWorker(void *arg) {
+    server_T *server = arg;
+    // kontext so signatúrami vstavaných funkcií sa pripraví raz, medzi požiadavkami sa len obnoví
+    ctx_T *ctx = calloc(1, sizeof(ctx_T));
+    if (ctx == NULL || !initializeBuiltIns(ctx)) exit(COMPILER_ERROR);
+    struct timeval timeout = { SERVER_RECV_TIMEOUT_SEC, 0 };
+    while (true) {
+        int conn = accept(server->socket, NULL, NULL);
+        if (conn < 0) {
+            // napr. EMFILE trvá, kým sa neuvoľnia deskriptory, opakovanie by len zaťažilo procesor
+            if (errno != EINTR && errno != ECONNABORTED) nanosleep(&(struct timespec){ 0, SERVER_ACCEPT_BACKOFF_NS }, NULL);
+            continue;
+        }
+        setsockopt(conn, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout)); // klient nemôže blokovať vlákno
+        serverHandle(ctx, conn, &(server->defaults));
+    }
+    return NULL;
+}
+
+int serverRun(char *path, int jobs, const options_T *options) {
+    struct sockaddr_un addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    if (strlen(path) >= sizeof(addr.sun_path)) {
+        fprintf(stderr, "server: socket path too long: %s\n", path);
+        return COMPILER_ERROR;
+    }
+    strcpy(addr.sun_path, path);
+
+    server_T server = { socket(AF_UNIX, SOCK_STREAM, 0), *options };
+    server.defaults.server = NULL; // požiadavky server nespúšťajú
+    if (server.socket < 0) {
+        fprintf(stderr, "server: cannot create socket: %s\n", strerror(errno));
+        return COMPILER_ERROR;
+    }
+    struct stat st;
+    if (lstat(path, &st) == 0) {
+        if (!S_ISSOCK(st.st_mode)) {
+            fprintf(stderr, "server: %s exists and is not a socket\n", path);
+            close(server.socket);
+            return COMPILER_ERROR;
+        }
+        unlink(path); // socket z predchádzajúceho behu servera
+    }
+    if (bind(server.socket, (struct sockaddr *)&addr, sizeof(addr)) != 0 || listen(server.socket, SOMAXCONN) != 0) {
+        fprintf(stderr, "server: cannot listen on %s: %s\n", path, strerror(errno));
+        close(server.socket);
+        return COMPILER_ERROR;
+    }
+
+    server_path = path;
+    struct sigaction stop;
+    memset(&stop, 0, sizeof(stop));
+    stop.sa_handler = serverStop;
+    sigaction(SIGINT, &stop, NULL);
+    sigaction(SIGTERM, &stop, NULL);
+    // zápis do spojenia s odpojeným klientom vráti EPIPE namiesto ukončenia servera
+    struct sigaction ignore;
+    memset(&ignore, 0, sizeof(ignore));
+    ignore.sa_handler = SIG_IGN;
+    sigaction(SIGPIPE, &ignore, NULL);
+
+    if (jobs <= 0) jobs = (int)sysconf(_SC_NPROCESSORS_ONLN);
+    if (jobs <= 0) jobs = 1;
+    if (jobs > SERVER_MAX_JOBS) jobs = SERVER_MAX_JOBS;
+
+    pthread_t threads[SERVER_MAX_JOBS];
+    int started = 0;
+    for (; started < jobs - 1; started++) {
+        if (pthread_create(&threads[started], NULL, serverWorker, &server) != 0) break;
+    }
+    serverWorker(&server); // hlavné vlákno obsluhuje spojenia tiež
+    return COMPILATION_OK;
+}
+
+/* Koniec súboru server.c */
@@ -0,0 +1,46 @@
+/** Projekt IFJ2023
+ * @file server.h
+ * @brief Prekladový server na lokálnom UNIX sockete
+ * @author agent (agent@local)
+ * @date 19.10.2026
+ */
+
+#ifndef _SERVER_H_
+#define _SERVER_H_
+
+#include "options.h"
+
+/*
+ * Protokol, jedna požiadavka na spojenie:
+ *   klient -> server: "<n>\n", n riadkov s prepínačmi prekladača ("<prepínač>\n"),
+ *                     zdrojový program až do konca zápisu (shutdown SHUT_WR)
+ *   server -> klient: "<návratový kód> <dĺžka kódu> <dĺžka hlásení>\n", cieľový kód, hlásenia chýb
+ */
+
+/** Maximálny počet prepínačov v požiadavke */
+#define SERVER_MAX_ARGS 64
+
+/** Maximálna dĺžka riadku hlavičky požiadavky alebo odpovede */
+#define SERVER_MAX_LINE 4096
+
+/** Čas v sekundách, po ktorom server zruší požiadavku, ktorej klient neposiela dáta */
+#define SERVER_RECV_TIMEOUT_SEC 30
+
+/**
+ * Socket na ceste path sa vytvorí (existujúci socket sa najprv odstráni, iný súbor na ceste
+ * je chyba) a požiadavky obsluhuje jobs vlákien, z ktorých každé prekladá jednu požiadavku
+ * naraz vo vlastnom kontexte prekladu. Požiadavka, ktorej klient neposiela dáta dlhšie ako
+ * SERVER_RECV_TIMEOUT_SEC, sa zruší. Nastavenia servera sú predvolené pre každú požiadavku,
+ * prepínače z požiadavky ich menia len pre ňu. Server beží, kým ho neukončí SIGINT alebo
+ * SIGTERM, vtedy socket odstráni.
+ *
+ * @brief Spustí prekladový server
+ * @param path cesta k UNIX socketu
+ * @param jobs počet vlákien, 0 znamená počet procesorov
+ * @param options nastavenia servera
+ * @return návratový kód pri chybe vytvorenia socketu, inak sa nevracia
+*/
+int serverRun(char *path, int jobs, const options_T *options);
+
+#endif // ifndef _SERVER_H_
+/* Koniec súboru server.h */
@@ -6,10 +6,11 @@
  */
 
 #include "strR.h"
+#include "memory.h"
 
 void StrInit(str_T *s)
 {
-    s -> data = (char *)malloc(STR_INIT_SIZE * sizeof(char));
+    s -> data = (char *)memAlloc(MEM_STRING, STR_INIT_SIZE * sizeof(char));
 
     if(s -> data == NULL) {
         fprintf(stderr, "StrInit() memory allocation error.\n");
@@ -24,7 +25,7 @@ void StrInit(str_T *s)
 
 void StrDestroy(str_T *s)
 {
-    free(s -> data);
+    memFree(MEM_STRING, s -> data);
     s -> data = NULL;
     s -> size = 0;
 }
@@ -39,7 +40,7 @@ void StrAppend(str_T *s, char c)
     // realokovat ak je potrebne
     if (strlen(s->data) + 1 == s->size) {
         s->size *= 2;
-        s->data = (char *)realloc(s->data, s->size);
+        s->data = (char *)memRealloc(MEM_STRING, s->data, s->size);
 
         if (s->data == NULL) {
             fprintf(stderr, "StrAppend() memory allocation error.\n");
@@ -60,7 +61,7 @@ void StrFillWith(str_T *dest, char *src)
     // realokovat ak je potrebne na len + 1
     if (len >= dest->size) {
         dest->size = len + 1;
-        dest->data = (char *)realloc(dest->data, dest->size);
+        dest->data = (char *)memRealloc(MEM_STRING, dest->data, dest->size);
 
         if (dest->data == NULL) {
             fprintf(stderr, "StrFillWith() memory allocation error..\n");
@@ -79,7 +80,7 @@ void StrCat(str_T *dest, str_T *src)
     // realokovat ak je potrebne na dlzku dest + dlzku src + 1
     if (len_dest + len_src + 1 >= dest->size) {
         dest->size = len_dest + len_src + 1;
-        dest->data = (char *)realloc(dest->data, dest->size);
+        dest->data = (char *)memRealloc(MEM_STRING, dest->data, dest->size);
         
         if (dest->data == NULL) {
             fprintf(stderr, "StrCat() memory allocation error.\n");
@@ -98,7 +99,7 @@ void StrCatString(str_T *dest, char *src)
     // realokovat ak je potrebne na dlzku dest + dlzku src + 1
     if (len_dest + len_src + 1 >= dest->size) {
         dest->size = len_dest + len_src + 1;
-        dest->data = (char *)realloc(dest->data, dest->size);
+        dest->data = (char *)memRealloc(MEM_STRING, dest->data, dest->size);
         
         if (dest->data == NULL) {
             fprintf(stderr, "StrCatString() memory allocation error.\n");
@@ -6,6 +6,8 @@
  */
 
 #include "symtable.h"
+#include "memory.h"
+#include "report.h"
 
 //djb2 hash function
 unsigned long hashOne(const char *str)
@@ -31,7 +33,7 @@ unsigned long hashTwo(const char *str)
 }
 
 func_sig_T *SymTabCreateFuncSig() {
-    func_sig_T *f = malloc(sizeof(func_sig_T));
+    func_sig_T *f = memAlloc(MEM_SYMTABLE, sizeof(func_sig_T));
     if (f == NULL) {
         fprintf(stderr, "SymTabCreateFuncSig() - memory allocation error\n");
         exit(99);
@@ -46,19 +48,22 @@ func_sig_T *SymTabCreateFuncSig() {
 
 TSData_T *SymTabCreateElement(char *key)
 {
-    TSData_T *elem = malloc(sizeof(TSData_T));
+    TSData_T *elem = memAlloc(MEM_SYMTABLE, sizeof(TSData_T));
     if(elem == NULL) {
         fprintf(stderr, "SymTabCreateElement() - memory allocation error\n");
         exit(99);
     }
-    elem->id = malloc(sizeof(char)*(strlen(key)+1));
+    elem->id = memAlloc(MEM_SYMTABLE, sizeof(char)*(strlen(key)+1));
     if(elem->id == NULL) {
-        free(elem);
+        memFree(MEM_SYMTABLE, elem);
         fprintf(stderr, "SymTabCreateElement() - memory allocation error\n");
         exit(99);
     }
     //inicializacia
     elem->type = SYM_TYPE_UNKNOWN;
+    elem->let = false;
+    elem->init = false;
+    elem->sig = NULL;
     strcpy(elem->id, key);
     StrInit(&(elem->codename));
     return elem; 
@@ -71,17 +76,17 @@ void SymTabDestroyElement(TSData_T *elem) {
             StrDestroy(&(elem->sig->par_types));
             DLLstr_Dispose(&(elem->sig->par_names));
             DLLstr_Dispose(&(elem->sig->par_ids));
-            free(elem->sig);
+            memFree(MEM_SYMTABLE, elem->sig);
         }
-        free(elem->id);
+        memFree(MEM_SYMTABLE, elem->id);
         StrDestroy(&(elem->codename));
-        free(elem);
+        memFree(MEM_SYMTABLE, elem);
     }
 }
 
 void SymTabInit(SymTab_T *st) {
 
-    st -> global = malloc(sizeof (TSBlock_T) + sizeof(TSData_T*) * SYMTABLE_MAX_SIZE);
+    st -> global = memAlloc(MEM_SYMTABLE, sizeof (TSBlock_T) + sizeof(TSData_T*) * SYMTABLE_MAX_SIZE);
 
     if(st -> global == NULL) {
         fprintf(stderr, "SymTabInit() - memory allocation error\n");
@@ -108,7 +113,7 @@ void SymTabAddLocalBlock(SymTab_T *st) {
         exit(99);
     }
     
-    TSBlock_T *newBlock = malloc(sizeof (TSBlock_T) + sizeof(TSData_T*) * SYMTABLE_MAX_SIZE);
+    TSBlock_T *newBlock = memAlloc(MEM_SYMTABLE, sizeof (TSBlock_T) + sizeof(TSData_T*) * SYMTABLE_MAX_SIZE);
 
     if(newBlock == NULL) { 
         fprintf(stderr, "SymTabAddLocalBlock() - new block memory allocation error\n");
@@ -145,7 +150,7 @@ void SymTabRemoveLocalBlock(SymTab_T *st) {
         }
     }   
 
-    free(currentLocal); 
+    memFree(MEM_SYMTABLE, currentLocal); 
 }
 
 void SymTabDestroy(SymTab_T *st) {
@@ -164,17 +169,20 @@ TSData_T *SymTabLookup(SymTab_T *st, char *key) {
     }
 
     //hladanie od posledneho lokalneho az po globalny
+    REPORT_ENTER(REPORT_SYMTABLE);
+    report_counters.lookups++;
     TSBlock_T *currentBlock = st->local;
     TSData_T *result = NULL;
     while (currentBlock != NULL) {
         result = SymTabBlockLookUp(currentBlock, key);
         if(result != NULL) {
-            return result;
+            break;
         }
         currentBlock = currentBlock->prev;
     }
+    REPORT_LEAVE();
 
-    return NULL;
+    return result;
 }
 
 TSData_T *SymTabLookupGlobal(SymTab_T *st, char *key) {
@@ -183,7 +191,11 @@ TSData_T *SymTabLookupGlobal(SymTab_T *st, char *key) {
         return NULL;
     }
 
-    return SymTabBlockLookUp(st->global, key);
+    REPORT_ENTER(REPORT_SYMTABLE);
+    report_counters.lookups++;
+    TSData_T *result = SymTabBlockLookUp(st->global, key);
+    REPORT_LEAVE();
+    return result;
 }
 
 TSData_T *SymTabLookupLocal(SymTab_T *st, char *key) {
@@ -192,7 +204,11 @@ TSData_T *SymTabLookupLocal(SymTab_T *st, char *key) {
         return NULL;
     }
 
-    return SymTabBlockLookUp(st->local, key);
+    REPORT_ENTER(REPORT_SYMTABLE);
+    report_counters.lookups++;
+    TSData_T *result = SymTabBlockLookUp(st->local, key);
+    REPORT_LEAVE();
+    return result;
 }
 
 void SymTabInsertGlobal(SymTab_T *st, TSData_T *elem) {
@@ -202,7 +218,9 @@ void SymTabInsertGlobal(SymTab_T *st, TSData_T *elem) {
         exit(99);
     }
 
+    REPORT_ENTER(REPORT_SYMTABLE);
     SymTabBlockInsert(st->global, elem);
+    REPORT_LEAVE();
 }
 
 void SymTabInsertLocal(SymTab_T *st, TSData_T *elem) {
@@ -212,7 +230,9 @@ void SymTabInsertLocal(SymTab_T *st, TSData_T *elem) {
             exit(99);
         }
 
+    REPORT_ENTER(REPORT_SYMTABLE);
     SymTabBlockInsert(st->local, elem);
+    REPORT_LEAVE();
 }
 
 bool SymTabCheckLocalReturn(SymTab_T *st) {
@@ -7,6 +7,14 @@
 # bash test.sh symtable
 # bash test.sh syntax_dbg
 # bash test.sh semantic_dbg
+# bash test.sh compiler
+# bash test.sh stream
+# bash test.sh short_names
+# bash test.sh batch
+# bash test.sh server
+# bash test.sh cache
+# bash test.sh incremental
+# bash test.sh time_report
 
 if [ $# -gt 0 ]; then
     if [ ! -d "tests/$1" ]; then 
@@ -23,4 +31,12 @@ else
     echo "bash test.sh symtable"
     echo "bash test.sh syntax_dbg"
     echo "bash test.sh semantic_dbg"
+    echo "bash test.sh compiler"
+    echo "bash test.sh stream"
+    echo "bash test.sh short_names"
+    echo "bash test.sh batch"
+    echo "bash test.sh server"
+    echo "bash test.sh cache"
+    echo "bash test.sh incremental"
+    echo "bash test.sh time_report"
 fi
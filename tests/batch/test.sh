@@ -0,0 +1,109 @@
+#!/bin/bash
+
+# dávkový preklad musí pre každý program vo zozname dať rovnaký kód a návratový kód ako priamy
+# preklad, výsledky vypísať v poradí zoznamu a hlásenia chýb označiť vstupným súborom
+
+make || exit 1
+
+echo "Executing batch tests"
+
+out_dir="batch.result"
+rm -rf "${out_dir}"
+mkdir "${out_dir}"
+
+batch_ok=true
+
+# celý korpus, výsledky v poradí zoznamu, návratový kód procesu je prvý nenulový výsledok
+rm -f list.result expected_list.result
+first_error=0
+for f in ../system_compile/*.swift ../semantic_dbg/*.sample
+do
+    name=$(basename "$f")
+    echo "$f ${out_dir}/${name}.code" >>list.result
+    ./main.out <"$f" >"${out_dir}/${name}.expected" 2>/dev/null
+    expected=$?
+    echo "$f ${expected}" >>expected_list.result
+    if [ ${first_error} -eq 0 ]; then first_error=${expected}; fi
+done
+./main.out --batch=list.result --jobs=4 >"actual_list.result" 2>"diagnostics.result"
+actual=$?
+if ! cmp -s "expected_list.result" "actual_list.result"; then
+    batch_ok=false
+    echo "Batch results differ from direct compilation or are out of order"
+fi
+if [ ${actual} -ne ${first_error} ]; then
+    batch_ok=false
+    echo "Batch returned #${actual}, expected first error #${first_error}"
+fi
+for f in ../system_compile/*.swift ../semantic_dbg/*.sample
+do
+    name=$(basename "$f")
+    if ! cmp -s "${out_dir}/${name}.expected" "${out_dir}/${name}.code"; then
+        batch_ok=false
+        echo "Compiled code differs for $f"
+    fi
+done
+
+# každý riadok hlásení začína vstupným súborom, ktorého sa týka
+if [ ! -s "diagnostics.result" ] || grep -v -E '^\.\./(system_compile|semantic_dbg)/[^ ]+: ' "diagnostics.result"; then
+    batch_ok=false
+    echo "Diagnostics without an input prefix"
+fi
+f="../semantic_dbg/3e01.sample"
+./main.out <"$f" 2>&1 >/dev/null | sed "s|^|$f: |" >"expected_err.result"
+grep -F "$f: " "diagnostics.result" >"actual_err.result"
+if ! cmp -s "expected_err.result" "actual_err.result"; then
+    batch_ok=false
+    echo "Diagnostics of $f differ from direct compilation"
+fi
+
+# viac vlákien ako programov
+f="../system_compile/$(ls ../system_compile | grep '\.swift$' | head -n 1)"
+echo "$f ${out_dir}/jobs.code" >list.result
+./main.out <"$f" >"${out_dir}/jobs.expected"
+if ! ./main.out --batch=list.result --jobs=16 >/dev/null 2>&1 || ! cmp -s "${out_dir}/jobs.expected" "${out_dir}/jobs.code"; then
+    batch_ok=false
+    echo "Batch with more jobs than programs failed"
+fi
+
+# chýbajúci vstup sa hlási pri danom programe, ostatné sa preložia
+printf "missing.swift %s\n%s %s\n" "${out_dir}/missing.code" "$f" "${out_dir}/after.code" >list.result
+./main.out --batch=list.result --jobs=2 >"actual_list.result" 2>"diagnostics.result"
+actual=$?
+printf "missing.swift 99\n%s 0\n" "$f" >"expected_list.result"
+if [ ${actual} -ne 99 ] || ! cmp -s "expected_list.result" "actual_list.result" || \
+    ! grep -q "^missing.swift: cannot open input file" "diagnostics.result" || \
+    ! cmp -s "${out_dir}/jobs.expected" "${out_dir}/after.code"; then
+    batch_ok=false
+    echo "Missing input not reported per file"
+fi
+
+# nezapísateľný výstup sa hlási pri danom programe, ostatné sa preložia
+printf "%s /dev/full\n%s %s\n" "$f" "$f" "${out_dir}/after.code" >list.result
+./main.out --batch=list.result --jobs=2 >"actual_list.result" 2>"diagnostics.result"
+actual=$?
+printf "%s 99\n%s 0\n" "$f" "$f" >"expected_list.result"
+if [ ${actual} -ne 99 ] || ! cmp -s "expected_list.result" "actual_list.result" || \
+    ! grep -q "^$f: \[COMPILER ERROR\] cannot write compiled code" "diagnostics.result" || \
+    ! cmp -s "${out_dir}/jobs.expected" "${out_dir}/after.code"; then
+    batch_ok=false
+    echo "Failed write not reported per file"
+fi
+
+# riadok bez výstupného súboru je chyba celej dávky, nič sa neprekladá
+printf "%s %s\n%s\n" "$f" "${out_dir}/none.code" "$f" >list.result
+./main.out --batch=list.result >"actual_list.result" 2>"diagnostics.result"
+actual=$?
+if [ ${actual} -ne 99 ] || [ -s "actual_list.result" ] || [ -e "${out_dir}/none.code" ] || \
+    ! grep -q "^batch: missing output file for $f" "diagnostics.result"; then
+    batch_ok=false
+    echo "Missing output column did not fail the batch"
+fi
+
+rm -rf "${out_dir}" list.result expected_list.result actual_list.result diagnostics.result expected_err.result actual_err.result
+
+if ${batch_ok} ; then
+    echo "[PASS]"
+else
+    echo "[FAIL]"
+fi
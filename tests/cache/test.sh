@@ -0,0 +1,80 @@
+#!/bin/bash
+
+# preklad s cache musí pri minutí aj pri zásahu dať rovnaký kód, hlásenia chýb aj návratový kód
+# ako priamy preklad
+
+make || exit 1
+
+echo "Executing cache tests"
+
+cache_dir="cache.result"
+rm -rf "${cache_dir}"
+mkdir "${cache_dir}"
+
+cache_ok=true
+for pass in miss hit
+do
+    for f in ../system_compile/*.swift ../semantic_dbg/*.sample ../syntax_dbg/*.sample
+    do
+        ./main.out <"$f" >"expected.result" 2>"expected_err.result"
+        expected=$?
+        ./main.out --cache="${cache_dir}" <"$f" >"actual.result" 2>"actual_err.result"
+        actual=$?
+        if [ ${expected} -ne ${actual} ] || ! cmp -s "expected.result" "actual.result" || ! cmp -s "expected_err.result" "actual_err.result"; then
+            cache_ok=false
+            echo -e "Cached result (${pass}) differs for ${f}\t\terr #${expected} vs #${actual}"
+        fi
+    done
+done
+
+# prepínače sú súčasťou kľúča
+f="../system_compile/Inlining.swift"
+./main.out --no-inline <"$f" >"expected.result"
+./main.out --cache="${cache_dir}" --no-inline <"$f" >"actual.result"
+cmp -s "expected.result" "actual.result" || { cache_ok=false; echo "Cache ignored --no-inline"; }
+
+# každý program bol raz minutý a raz zasiahnutý, --no-inline je nový záznam
+count=$(ls ../system_compile/*.swift ../semantic_dbg/*.sample ../syntax_dbg/*.sample | wc -l)
+stats=$(./main.out --cache="${cache_dir}" --cache-stats <"$f" 2>&1 >/dev/null)
+if [[ "${stats}" != *"total $((count + 1)) hits, $((count + 1)) misses"* ]]; then
+    cache_ok=false
+    echo "Unexpected statistics: ${stats}"
+fi
+
+# dávka vo viacerých vláknach nesmie pri súčasnej úprave stratiť žiadny počet v štatistike
+batch_dir="batch_cache.result"
+rm -rf "${batch_dir}" batch_list.result
+mkdir "${batch_dir}"
+for f in ../system_compile/*.swift
+do
+    echo "$f /dev/null" >>batch_list.result
+done
+batch_count=$(wc -l <batch_list.result)
+./main.out --batch=batch_list.result --jobs=8 --cache="${batch_dir}" >/dev/null 2>&1
+# ďalšie kolá už len zasahujú, opakovaním sa zvýši súbeh pri úprave štatistiky
+for round in 1 2 3 4
+do
+    stats=$(./main.out --batch=batch_list.result --jobs=8 --cache="${batch_dir}" --cache-stats 2>&1 >/dev/null)
+done
+if [[ "${stats}" != *"total $((4 * batch_count)) hits, ${batch_count} misses"* ]]; then
+    cache_ok=false
+    echo "Unexpected statistics after batch --jobs=8: ${stats}"
+fi
+rm -rf "${batch_dir}" batch_list.result
+
+# pri prekročení limitu ostanú len najnovšie záznamy
+(cat "$f"; echo "// new") | ./main.out --cache="${cache_dir}" --cache-limit=8 --cache-stats >/dev/null 2>&1
+[ $? -eq 0 ] || { cache_ok=false; echo "Compilation with eviction failed"; }
+size=$(cat "${cache_dir}"/???????????????????????????????? | wc -c)
+if [ "${size}" -gt 8192 ] || [ "${size}" -eq 0 ]; then
+    cache_ok=false
+    echo "Cache size ${size} B after eviction to 8 KiB"
+fi
+
+rm -rf "${cache_dir}" expected.result expected_err.result actual.result actual_err.result
+
+if ${cache_ok} ; then
+    echo "[PASS]"
+else
+    echo "[FAIL]"
+fi
@@ -0,0 +1,126 @@
+#include "../../compiler.h"
+#include "../../parser.h"
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define TEST(cond)                                    \
+    if (!(cond))                                      \
+    {                                                 \
+        printf("FAIL[ln %d]\t%s\n", __LINE__, #cond); \
+        exit(EXIT_FAILURE); \
+    }
+
+#define THREADS 4
+
+const char *program =
+    "func fib(_ n: Int) -> Int {\n"
+    "    if n < 2 { return n } else {\n"
+    "        let m = n - 1\n"
+    "        let k = n - 2\n"
+    "        let a = fib(m)\n"
+    "        let b = fib(k)\n"
+    "        return a + b\n"
+    "    }\n"
+    "}\n"
+    "var i = 0\n"
+    "while i < 10 {\n"
+    "    let f = fib(i)\n"
+    "    write(f, \"\\n\")\n"
+    "    i = i + 1\n"
+    "}\n"
+    "let s = readString()\n"
+    "if let s {\n"
+    "    let t = substring(of: s, startingAt: 1, endingBefore: 3)\n"
+    "    write(t)\n"
+    "} else {}\n";
+
+const char *syntax_error = "var x = \n func (\n";
+
+/**
+ * @brief Preloží zdrojový program z reťazca, vygenerovaný kód uloží do *output
+ * @return návratový kód prekladu
+ */
+int compileString(const char *source, char **output) {
+    FILE *in = tmpfile();
+    FILE *out = tmpfile();
+    TEST(in != NULL && out != NULL);
+    fputs(source, in);
+    rewind(in);
+
+    compiler_T c = { in, fileno(out), NULL, options_default, false };
+    int result = compile(&c);
+
+    // kód je zapísaný priamo do deskriptora, fseek zosynchronizuje pozíciu súboru
+    TEST(fseek(out, 0, SEEK_END) == 0);
+    long size = ftell(out);
+    *output = calloc(size + 1, 1);
+    TEST(*output != NULL);
+    rewind(out);
+    TEST(fread(*output, 1, size, out) == (size_t)size);
+
+    fclose(in);
+    fclose(out);
+    return result;
+}
+
+char *expected = NULL;
+
+void *worker(void *arg) {
+    (void)arg;
+    for (int i = 0; i < 5; i++) {
+        char *output;
+        TEST(compileString(program, &output) == COMPILATION_OK);
+        TEST(strcmp(output, expected) == 0);
+        free(output);
+    }
+    return NULL;
+}
+
+void test() {
+    // opakovaný preklad v jednom vlákne dáva rovnaký výsledok
+    TEST(compileString(program, &expected) == COMPILATION_OK);
+    TEST(strncmp(expected, ".IFJcode23\n", 11) == 0);
+    char *output;
+    TEST(compileString(program, &output) == COMPILATION_OK);
+    TEST(strcmp(output, expected) == 0);
+    free(output);
+
+    // chyba prekladu neovplyvní nasledujúci preklad
+    TEST(compileString(syntax_error, &output) == SYN_ERR);
+    free(output);
+    TEST(compileString(program, &output) == COMPILATION_OK);
+    TEST(strcmp(output, expected) == 0);
+    free(output);
+
+    // hlásenia chýb prekladu sa zapisujú do zadaného súboru
+    FILE *in = tmpfile(), *out = tmpfile(), *diagnostics = tmpfile();
+    TEST(in != NULL && out != NULL && diagnostics != NULL);
+    fputs(syntax_error, in);
+    rewind(in);
+    compiler_T c = { in, fileno(out), diagnostics, options_default, false };
+    TEST(compile(&c) == SYN_ERR);
+    char line[256] = "";
+    rewind(diagnostics);
+    TEST(fgets(line, sizeof(line), diagnostics) != NULL);
+    TEST(strncmp(line, "Syntax Error", strlen("Syntax Error")) == 0);
+    fclose(in);
+    fclose(out);
+    fclose(diagnostics);
+
+    // súčasný preklad vo viacerých vláknach
+    pthread_t threads[THREADS];
+    for (int i = 0; i < THREADS; i++) TEST(pthread_create(&threads[i], NULL, worker, NULL) == 0);
+    for (int i = 0; i < THREADS; i++) TEST(pthread_join(threads[i], NULL) == 0);
+
+    free(expected);
+}
+
+int main()
+{
+    test();
+
+    printf("Everything OK\n");
+    return 0;
+}
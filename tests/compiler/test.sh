@@ -0,0 +1,5 @@
+#!/bin/bash
+
+make test.out  || exit 1
+echo "Executing compiler unit tests"
+./test.out
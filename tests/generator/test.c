@@ -14,31 +14,31 @@ int failures = 0;
 
 int main()
 {
-    DLLstr_Init(&code_main);
-    DLLstr_Init(&code_fn);
+    gen_T gen;
+    genInit(&gen, &options_default);
 
     str_T s;
     StrInit(&s);
 
-    genUniqVar("GF", "x", &s);
+    genUniqVar(&gen, "GF", "x", &s);
     TEST(strcmp(StrRead(&s), "GF@x$1") == 0);
 
     StrDestroy(&s);
     StrInit(&s);
 
-    genUniqVar("GF", "x", &s);
+    genUniqVar(&gen, "GF", "x", &s);
     TEST(strcmp(StrRead(&s), "GF@x$2") == 0);
 
     StrDestroy(&s);
     StrInit(&s);
 
-    genUniqLabel("pow", "while", &s);
+    genUniqLabel(&gen, "pow", "while", &s);
     TEST(strcmp(StrRead(&s), "pow&while1") == 0);
 
     StrDestroy(&s);
     StrInit(&s);
 
-    genUniqLabel("fib", "while", &s);
+    genUniqLabel(&gen, "fib", "while", &s);
     TEST(strcmp(StrRead(&s), "fib&while2") == 0);
 
     StrDestroy(&s);
@@ -73,28 +73,28 @@ int main()
 
     StrDestroy(&s);
 
-    genCode("ADD", "GF@x", "GF@y", "LF@z");
-    if(parser_inside_fn_def) {
-        TEST(strcmp(code_fn.last->string, "ADD GF@x GF@y LF@z") == 0);
+    genCode(&gen, "ADD", "GF@x", "GF@y", "LF@z");
+    if(gen.inside_fn_def) {
+        TEST(strcmp(gen.code_fn.last->string, "ADD GF@x GF@y LF@z") == 0);
     }
     else {
-        TEST(strcmp(code_main.last->string, "ADD GF@x GF@y LF@z") == 0);
+        TEST(strcmp(gen.code_main.last->string, "ADD GF@x GF@y LF@z") == 0);
     }
 
-    genCode("PUSHFRAME", NULL, NULL, NULL);
-    if(parser_inside_fn_def) {
-        TEST(strcmp(code_fn.last->string, "PUSHFRAME") == 0);
+    genCode(&gen, "PUSHFRAME", NULL, NULL, NULL);
+    if(gen.inside_fn_def) {
+        TEST(strcmp(gen.code_fn.last->string, "PUSHFRAME") == 0);
     }
     else {
-        TEST(strcmp(code_main.last->string, "PUSHFRAME") == 0);
+        TEST(strcmp(gen.code_main.last->string, "PUSHFRAME") == 0);
     }
 
-    genCode("DEFVAR", NULL, "GF@x", NULL);
-    if(parser_inside_fn_def) {
-        TEST(strcmp(code_fn.last->string, "DEFVAR GF@x") == 0);
+    genCode(&gen, "DEFVAR", NULL, "GF@x", NULL);
+    if(gen.inside_fn_def) {
+        TEST(strcmp(gen.code_fn.last->string, "DEFVAR GF@x") == 0);
     }
     else {
-        TEST(strcmp(code_main.last->string, "DEFVAR GF@x") == 0);
+        TEST(strcmp(gen.code_main.last->string, "DEFVAR GF@x") == 0);
     }
 
     DLLstr_T *variables = malloc(sizeof(DLLstr_T));
@@ -107,15 +107,15 @@ int main()
     DLLstr_InsertLast(variables, "LF@x$1");
     DLLstr_InsertLast(variables, "LF@y$2");
 
-    genDefVarsBeforeLoop("&while25", variables);
+    genDefVarsBeforeLoop(&gen, "&while25", variables);
 
-    if(parser_inside_fn_def) {
-        TEST(strcmp(code_fn.last->string, "DEFVAR LF@y$2") == 0);
-        TEST(strcmp(code_fn.last->prev->string, "DEFVAR LF@x$1") == 0);
+    if(gen.inside_fn_def) {
+        TEST(strcmp(gen.code_fn.last->string, "DEFVAR LF@y$2") == 0);
+        TEST(strcmp(gen.code_fn.last->prev->string, "DEFVAR LF@x$1") == 0);
     }
     else {
-        TEST(strcmp(code_main.last->string, "DEFVAR LF@y$2") == 0);
-        TEST(strcmp(code_main.last->prev->string, "DEFVAR LF@x$1") == 0);
+        TEST(strcmp(gen.code_main.last->string, "DEFVAR LF@y$2") == 0);
+        TEST(strcmp(gen.code_main.last->prev->string, "DEFVAR LF@x$1") == 0);
     }
 
     DLLstr_Dispose(variables);
@@ -126,17 +126,17 @@ int main()
     DLLstr_InsertLast(variables2, "a");
     DLLstr_InsertLast(variables2, "b");
 
-    parser_inside_fn_def = true;
+    gen.inside_fn_def = true;
 
-    genFnDefBegin("main", variables2);
+    genFnDefBegin(&gen, "main", variables2);
 
-    TEST(strcmp(code_fn.last->prev->prev->prev->prev->prev->prev->string, "LABEL main") == 0);
-    TEST(strcmp(code_fn.last->prev->prev->prev->prev->prev->string, "CREATEFRAME") == 0);
-    TEST(strcmp(code_fn.last->prev->prev->prev->prev->string, "PUSHFRAME") == 0);
-    TEST(strcmp(code_fn.last->prev->prev->prev->string, "DEFVAR LF@a%") == 0);
-    TEST(strcmp(code_fn.last->prev->prev->string, "POPS LF@a%") == 0);
-    TEST(strcmp(code_fn.last->prev->string, "DEFVAR LF@b%") == 0);
-    TEST(strcmp(code_fn.last->string, "POPS LF@b%") == 0);
+    TEST(strcmp(gen.code_fn.last->prev->prev->prev->prev->prev->prev->string, "LABEL main") == 0);
+    TEST(strcmp(gen.code_fn.last->prev->prev->prev->prev->prev->string, "CREATEFRAME") == 0);
+    TEST(strcmp(gen.code_fn.last->prev->prev->prev->prev->string, "PUSHFRAME") == 0);
+    TEST(strcmp(gen.code_fn.last->prev->prev->prev->string, "DEFVAR LF@a%") == 0);
+    TEST(strcmp(gen.code_fn.last->prev->prev->string, "POPS LF@a%") == 0);
+    TEST(strcmp(gen.code_fn.last->prev->string, "DEFVAR LF@b%") == 0);
+    TEST(strcmp(gen.code_fn.last->string, "POPS LF@b%") == 0);
 
     DLLstr_Dispose(variables2);
     free(variables2);
@@ -146,24 +146,23 @@ int main()
     DLLstr_InsertLast(variables3, "int@6");
     DLLstr_InsertLast(variables3, "LF@x$1");
 
-    genFnCall("sum", variables3);
+    genFnCall(&gen, "sum", variables3);
 
-    if(parser_inside_fn_def) {
-        TEST(strcmp(code_fn.last->prev->prev->string, "PUSH LF@x$1") == 0);
-        TEST(strcmp(code_fn.last->prev->string, "PUSH int@6") == 0);
-        TEST(strcmp(code_fn.last->string, "CALL sum") == 0);
+    if(gen.inside_fn_def) {
+        TEST(strcmp(gen.code_fn.last->prev->prev->string, "PUSH LF@x$1") == 0);
+        TEST(strcmp(gen.code_fn.last->prev->string, "PUSH int@6") == 0);
+        TEST(strcmp(gen.code_fn.last->string, "CALL sum") == 0);
     }
     else {
-        TEST(strcmp(code_main.last->prev->prev->string, "PUSH LF@x$1") == 0);
-        TEST(strcmp(code_main.last->prev->string, "PUSH int@6") == 0);
-        TEST(strcmp(code_main.last->string, "CALL sum") == 0);
+        TEST(strcmp(gen.code_main.last->prev->prev->string, "PUSH LF@x$1") == 0);
+        TEST(strcmp(gen.code_main.last->prev->string, "PUSH int@6") == 0);
+        TEST(strcmp(gen.code_main.last->string, "CALL sum") == 0);
     }
 
     DLLstr_Dispose(variables3);
     free(variables3);
 
-    DLLstr_Dispose(&code_fn);
-    DLLstr_Dispose(&code_main);
+    genDestroy(&gen);
 
     if(failures != 0)
     {
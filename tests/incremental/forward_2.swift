@@ -0,0 +1,11 @@
+func f(_ x: Int) -> Int {
+	let y = g(x)
+	return y
+}
+
+func g(_ a: Double) -> Int {
+	return 2
+}
+
+let r = f(3)
+write(r, "\n")
@@ -0,0 +1,7 @@
+var unused = 1
+var base = 10
+func add(_ n: Int) -> Int {
+    return n + base
+}
+let v = add(1)
+write(v, "\n")
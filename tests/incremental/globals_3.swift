@@ -0,0 +1,6 @@
+var base = 2.5
+func add(_ n: Int) -> Int {
+    return n + base
+}
+let v = add(1)
+write(v, "\n")
@@ -0,0 +1,15 @@
+func outer(_ n: Int) -> Int {
+    func inner(_ k: Int) -> Int {
+        return k * 3
+    }
+    var i = 0
+    var s = 0
+    while i < n {
+        let t = inner(i)
+        s = s + t
+        i = i + 1
+    }
+    return s
+}
+let o = outer(4)
+write(o, "\n")
@@ -0,0 +1,6 @@
+func first(_ s: String) -> String? {
+    let c = substring(of: s, startingAt: 0, endingBefore: 1)
+    return c
+}
+let c = first("xyz")
+write(c, "\n")
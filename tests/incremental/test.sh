@@ -0,0 +1,64 @@
+#!/bin/bash
+
+# inkrementálny preklad musí dať rovnaký kód, hlásenia chýb aj návratový kód ako priamy preklad,
+# aj keď sa funkcie prevezmú z cache pri preklade zmeneného alebo iného programu
+
+make || exit 1
+
+echo "Executing incremental compilation tests"
+
+cache_dir="cache.result"
+incremental_ok=true
+
+# porovná inkrementálny preklad programu $1 s priamym prekladom
+compare() {
+    ./main.out <"$1" >"expected.result" 2>"expected_err.result"
+    expected=$?
+    ./main.out --cache="${cache_dir}" --incremental <"$1" >"actual.result" 2>"actual_err.result"
+    actual=$?
+    if [ ${expected} -ne ${actual} ] || ! cmp -s "expected.result" "actual.result" || ! cmp -s "expected_err.result" "actual_err.result"; then
+        incremental_ok=false
+        echo -e "Incremental result differs for $2\t\terr #${expected} vs #${actual}"
+    fi
+}
+
+# postupné úpravy programu: <názov>_<verzia>.swift, verzie sa prekladajú za sebou s jednou cache
+for group in $(ls *_1.swift | sed 's/_1\.swift$//')
+do
+    rm -rf "${cache_dir}"
+    mkdir "${cache_dir}"
+    for f in $(ls "${group}"_*.swift | sort -V)
+    do
+        compare "$f" "$f"
+    done
+done
+
+# po zmene tela g sa f prevezme z cache, aj keď v nej je signatúra g odvodená z volania pred definíciou
+rm -rf "${cache_dir}"
+mkdir "${cache_dir}"
+./main.out --cache="${cache_dir}" --incremental <"forward_1.swift" >/dev/null
+stats=$(./main.out --cache="${cache_dir}" --incremental --cache-stats <"forward_3.swift" 2>&1 >/dev/null)
+if [[ "${stats}" != *"1 functions reused, 1 compiled"* ]]; then
+    incremental_ok=false
+    echo "Unexpected statistics: ${stats}"
+fi
+
+# ostatné programy so zmenou mimo funkcií, funkcie sa prevezmú aj z iných programov v spoločnej cache
+rm -rf "${cache_dir}"
+mkdir "${cache_dir}"
+for pass in miss hit
+do
+    for f in ../system_compile/*.swift ../semantic_dbg/*.sample ../syntax_dbg/*.sample
+    do
+        (cat "$f"; echo; echo "// ${pass}") >"program.result"
+        compare "program.result" "$f (${pass})"
+    done
+done
+
+rm -rf "${cache_dir}" program.result expected.result expected_err.result actual.result actual_err.result
+
+if ${incremental_ok} ; then
+    echo "[PASS]"
+else
+    echo "[FAIL]"
+fi
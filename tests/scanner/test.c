@@ -49,8 +49,10 @@ char *tkn_ids[] = {
 
 int main()
 {
+    scanner_T s = { 0 };
+    scannerReset(&s, stdin);
     token_T *tkn = NULL;
-    tkn = getToken();
+    tkn = getToken(&s);
     while (tkn->type != EOF_TKN && tkn->type != INVALID)
     {
         if (tkn != NULL)
@@ -58,7 +60,7 @@ int main()
             printf("%s\n", tkn_ids[tkn->type]);
             destroyToken(tkn);
         }
-        tkn = getToken();
+        tkn = getToken(&s);
     }
     if(tkn != NULL)
     {
@@ -69,6 +71,7 @@ int main()
         }
         destroyToken(tkn);
     } 
+    scannerReset(&s, NULL);
 
     return 0;
 }
\ No newline at end of file
@@ -3,6 +3,9 @@
 #include "../../parser.h"
 #include "../../exp.h"
 
+/** Kontext prekladu testovaného výrazu */
+static ctx_T ctx;
+
 void create_variable_info(char* id, char var_type, bool init) {
     TSData_T* var = SymTabCreateElement(id);
     var->type = var_type;
@@ -12,7 +15,7 @@ void create_variable_info(char* id, char var_type, bool init) {
         var->sig = SymTabCreateFuncSig();
     }
 
-    SymTabInsertLocal(&symt, var);
+    SymTabInsertLocal(&ctx.symt, var);
 }
 
 void init_used_variables() {
@@ -39,20 +42,21 @@ void init_used_variables() {
 int main() {
     char expected_type = getchar(); // na prvom riadku sample-u je očakávaný typ výsledku výrazu
 
-    initializeParser();
+    ctx.options = options_default;
+    initializeParser(&ctx);
     init_used_variables();
-    TRY_OR_EXIT(nextToken());
+    TRY_OR_EXIT(nextToken(&ctx));
 
     char result_type = SYM_TYPE_VOID;
     bool literal;
-    int ret_code = parseExpression(&result_type, &literal);
+    int ret_code = parseExpression(&ctx, &result_type, &literal);
 
-    if (tkn != NULL && ret_code == COMPILATION_OK) {
+    if (ctx.tkn != NULL && ret_code == COMPILATION_OK) {
         fprintf(stderr, "test.c: tkn must remain NULL after parseExpression\n");
         return 50;
     }
-    tkn = getToken();
-    destroyParser();
+    ctx.tkn = getToken(&ctx.scanner);
+    destroyParser(&ctx);
 
     // X na začiatku sample znamená, že test neskúša návratový typ výrazu
     if (expected_type != 'X') {
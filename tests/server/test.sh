@@ -0,0 +1,56 @@
+#!/bin/bash
+
+# preklad cez server musí dať rovnaký kód, hlásenia chýb aj návratový kód ako priamy preklad
+
+make || exit 1
+
+echo "Executing server tests"
+
+socket="/tmp/ifj23_server_test_$$.sock"
+./main.out --server="${socket}" --jobs=4 &
+server_pid=$!
+for i in $(seq 50); do
+    [ -S "${socket}" ] && break
+    sleep 0.1
+done
+
+server_ok=true
+for f in ../system_compile/*.swift ../semantic_dbg/*.sample ../syntax_dbg/*.sample
+do
+    ./main.out <"$f" >"expected.result" 2>"expected_err.result"
+    expected=$?
+    ./client.out "${socket}" <"$f" >"actual.result" 2>"actual_err.result"
+    actual=$?
+    if [ ${expected} -ne ${actual} ] || ! cmp -s "expected.result" "actual.result" || ! cmp -s "expected_err.result" "actual_err.result"; then
+        server_ok=false
+        echo -e "Server result differs for ${f}\t\terr #${expected} vs #${actual}"
+    fi
+done
+
+# prepínače z požiadavky platia len pre ňu
+f="../system_compile/Inlining.swift"
+./main.out --no-inline <"$f" >"expected.result"
+./client.out "${socket}" --no-inline <"$f" >"actual.result"
+cmp -s "expected.result" "actual.result" || { server_ok=false; echo "Server ignored --no-inline"; }
+./main.out <"$f" >"expected.result"
+./client.out "${socket}" <"$f" >"actual.result"
+cmp -s "expected.result" "actual.result" || { server_ok=false; echo "Server kept options of previous request"; }
+
+kill ${server_pid}
+wait ${server_pid} 2>/dev/null
+
+# iný súbor na ceste socketu server neodstráni a skončí chybou
+echo "keep" >"${socket}"
+./main.out --server="${socket}" --jobs=1 2>/dev/null
+if [ $? -eq 0 ] || [ "$(cat "${socket}")" != "keep" ]; then
+    server_ok=false
+    echo "Server replaced a regular file at the socket path"
+fi
+rm -f "${socket}"
+rm -f expected.result expected_err.result actual.result actual_err.result
+
+if ${server_ok} ; then
+    echo "[PASS]"
+else
+    echo "[FAIL]"
+fi
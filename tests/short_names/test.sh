@@ -0,0 +1,72 @@
+#!/bin/bash
+
+# program s krátkymi názvami (--short-names) sa musí správať rovnako ako s pôvodnými názvami,
+# --name-map zapíše tabuľku "<rozsah> <krátky názov> <pôvodný názov>"
+
+make || exit 1
+
+echo "Executing short names tests"
+
+names_ok=true
+
+# každý program zo system_run preložený s --short-names dá v interprete očakávaný výstup
+for f in ../system_compile/*.swift
+do
+    name=$(basename "${f%.*}")
+    ./main.out --short-names <"$f" >"actual.prog"
+    result=$?
+    if [ ${result} -ne 0 ]; then
+        names_ok=false
+        echo -e "Failed to compile $f with --short-names\t\terr #${result}"
+        continue
+    fi
+    timeout 2 ../system_run/ic23int "actual.prog" <"../system_run/${name}.stdin" >"actual.result" 2>/dev/null
+    result=$?
+    expected=0
+    if [ -f "../system_run/${name}.code" ]; then expected=$(cat "../system_run/${name}.code"); fi
+    if [ ${result} -ne ${expected} ] || ! cmp -s "../system_run/${name}.stdout" "actual.result"; then
+        names_ok=false
+        echo -e "Program $f with short names behaves differently\t\terr #${result}"
+    fi
+
+    # mapa názvov nemení kód, každý riadok má tvar "<rozsah> <krátky názov> <pôvodný názov>"
+    ./main.out --name-map="map.result" <"$f" >"expected.prog"
+    if ! cmp -s "actual.prog" "expected.prog" || grep -v -E '^[^ ]+ [a-zA-Z][a-zA-Z0-9]* [^ ]+$' "map.result"; then
+        names_ok=false
+        echo "Invalid name map for $f"
+    fi
+done
+
+# tabuľka známeho programu: premenné funkcií, globálne premenné a náveštia
+f="../system_compile/TailCalls.swift"
+./main.out --name-map="map.result" <"$f" >"actual.prog"
+for line in "sumTo a LF@n%" "sumTo b LF@a%" "gcd c LF@r\$1" "fact c LF@f\$2" "GF a GF@s\$1" "label a sumTo" \
+    "label b sumTo&if1!" "label j fact&if1!"
+do
+    if ! grep -q -x -F "${line}" "map.result"; then
+        names_ok=false
+        echo "Name map of $f is missing \"${line}\""
+    fi
+done
+# v kóde ostali len krátke názvy, pôvodné sa nevyskytujú
+if ! grep -q -x "LABEL sumTo&if1!" <(./main.out <"$f") || grep -q -F 'LF@n%' "actual.prog" ||
+    ! grep -q -x "LABEL b" "actual.prog" || ! grep -q -F "LF@a " "actual.prog"; then
+    names_ok=false
+    echo "Code of $f does not use the short names"
+fi
+
+# mapu názvov nie je možné zapísať
+./main.out --name-map="nonexistent/map.result" <"$f" >/dev/null 2>"actual.result"
+result=$?
+if [ ${result} -ne 99 ] || ! grep -q "cannot open name map file" "actual.result"; then
+    names_ok=false
+    echo "Unwritable name map not reported (err #${result})"
+fi
+
+rm -f actual.prog expected.prog actual.result map.result
+
+if ${names_ok} ; then
+    echo "[PASS]"
+else
+    echo "[FAIL]"
+fi
@@ -0,0 +1,84 @@
+#!/bin/bash
+
+# postupný výpis (--stream) musí dať program s rovnakým správaním ako výpis celého programu, bez
+# optimalizácií nad celým programom (vkladanie funkcií, odstránenie nevolaných funkcií a rámcov)
+# musí byť vygenerovaný kód zhodný
+
+make || exit 1
+
+echo "Executing stream tests"
+
+stream_ok=true
+
+# každý program zo system_run preložený s --stream dá v interprete očakávaný výstup
+for f in ../system_compile/*.swift
+do
+    name=$(basename "${f%.*}")
+    ./main.out --stream <"$f" >"actual.prog"
+    result=$?
+    if [ ${result} -ne 0 ]; then
+        stream_ok=false
+        echo -e "Failed to compile $f with --stream\t\terr #${result}"
+        continue
+    fi
+    timeout 2 ../system_run/ic23int "actual.prog" <"../system_run/${name}.stdin" >"actual.result" 2>/dev/null
+    result=$?
+    expected=0
+    if [ -f "../system_run/${name}.code" ]; then expected=$(cat "../system_run/${name}.code"); fi
+    if [ ${result} -ne ${expected} ] || ! cmp -s "../system_run/${name}.stdout" "actual.result"; then
+        stream_ok=false
+        echo -e "Streamed program $f behaves differently\t\terr #${result}"
+    fi
+done
+
+# bez optimalizácií nad celým programom je kód zhodný, aj chyby prekladu sú rovnaké
+for f in ../system_compile/*.swift ../semantic_dbg/*.sample ../syntax_dbg/*.sample
+do
+    ./main.out --no-inline --no-dead-fns --no-call-cleanup <"$f" >"expected.result" 2>"expected_err.result"
+    expected=$?
+    ./main.out --stream --no-inline --no-call-cleanup <"$f" >"actual.result" 2>"actual_err.result"
+    actual=$?
+    if [ ${expected} -ne ${actual} ] || ! cmp -s "expected_err.result" "actual_err.result" ||
+        { [ ${expected} -eq 0 ] && ! cmp -s "expected.result" "actual.result"; }; then
+        stream_ok=false
+        echo -e "Streamed code differs for $f\t\terr #${expected} vs #${actual}"
+    fi
+done
+
+# vnorené funkcie sa vypíšu až s najvrchnejšou, funkcia v cykle až po cykle, v poradí definícií
+f="../system_compile/NestedFunctions.swift"
+./main.out --stream --no-inline <"$f" | grep "^LABEL [a-zA-Z]*$" >"actual.result"
+printf "LABEL outer\nLABEL inner\nLABEL innermost\nLABEL other\nLABEL inLoop\n" >"expected.result"
+if ! cmp -s "expected.result" "actual.result"; then
+    stream_ok=false
+    echo "Unexpected order of streamed functions in $f"
+fi
+
+# funkcia volaná pred svojou definíciou sa pri --stream nevynechá ani nevloží
+f="../system_compile/ForwardCalls.swift"
+./main.out --stream <"$f" >"actual.result"
+if ! grep -q "^CALL second$" "actual.result" || ! grep -q "^LABEL second$" "actual.result"; then
+    stream_ok=false
+    echo "Function called before its definition missing from streamed $f"
+fi
+
+# prepínače, ktoré potrebujú celý program, sa s --stream nedajú kombinovať
+f="../system_compile/$(ls ../system_compile | grep '\.swift$' | head -n 1)"
+for option in --short-names --name-map=map.result --dump-cfg
+do
+    ./main.out --stream ${option} <"$f" >"actual.result" 2>"actual_err.result"
+    result=$?
+    if [ ${result} -ne 99 ] || [ -s "actual.result" ] || [ -e "map.result" ] ||
+        ! grep -q "cannot be combined" "actual_err.result"; then
+        stream_ok=false
+        echo "Option --stream ${option} was not rejected (err #${result})"
+    fi
+done
+
+rm -f actual.prog actual.result expected.result actual_err.result expected_err.result map.result
+
+if ${stream_ok} ; then
+    echo "[PASS]"
+else
+    echo "[FAIL]"
+fi
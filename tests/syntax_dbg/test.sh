@@ -40,6 +40,11 @@ else
     echo "[FAIL]"
 fi
 
+if ! command -v valgrind >/dev/null 2>&1 ; then
+    echo -e "\n[VALGRIND SKIP] valgrind not found, memory check not run"
+    exit 0
+fi
+
 echo -e "\nValgrind check running, this may take a while"
 valgrind_ok=true
 
@@ -1,6 +1,9 @@
 #include "../../parser.h"
 #include "../../exp.h"
 
+/** Kontext prekladu testovaného výrazu */
+static ctx_T ctx;
+
 void create_variable_info(char* id, char var_type, bool init) {
     TSData_T* var = SymTabCreateElement(id);
     var->type = var_type;
@@ -10,7 +13,7 @@ void create_variable_info(char* id, char var_type, bool init) {
         var->sig = SymTabCreateFuncSig();
     }
 
-    SymTabInsertLocal(&symt, var);
+    SymTabInsertLocal(&ctx.symt, var);
 }
 
 void init_used_variables() {
@@ -35,22 +38,23 @@ void init_used_variables() {
 }
 
 int main() {
-    initializeParser();
+    ctx.options = options_default;
+    initializeParser(&ctx);
     init_used_variables();
 
-    TRY_OR_EXIT(nextToken());
+    TRY_OR_EXIT(nextToken(&ctx));
 
     char result_type;
     bool literal; 
-    int ret_code = parseExpression(&result_type, &literal);
+    int ret_code = parseExpression(&ctx, &result_type, &literal);
 
-    if (tkn != NULL && ret_code == COMPILATION_OK) {
+    if (ctx.tkn != NULL && ret_code == COMPILATION_OK) {
         fprintf(stderr, "test.c: tkn must remain NULL after parseExpression\n");
         return 50;
     }
 
-    destroyParser();
-    tkn = getToken();
+    destroyParser(&ctx);
+    ctx.tkn = getToken(&ctx.scanner);
 
     return ret_code;
 }
\ No newline at end of file
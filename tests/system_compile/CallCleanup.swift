@@ -0,0 +1,38 @@
+// Volania void funkcii bez CLEARS a funkcie bez lokalneho ramca
+
+var counter = 3
+
+func banner() {
+	write("--\n")
+}
+
+func countdown() {
+	if (counter > 0) {
+		write(counter, "\n")
+		counter = counter - 1
+		countdown()
+	} else {
+		write("start\n")
+	}
+}
+
+func show(_ x: Int) {
+	write("x=", x, "\n")
+}
+
+func twice(_ x: Int) -> Int {
+	let r = x * 2
+	return r
+}
+
+banner()
+countdown()
+var i = 0
+while (i < 3) {
+	show(i)
+	twice(i)
+	banner()
+	i = i + 1
+}
+let t = twice(21)
+write(t, "\n")
@@ -0,0 +1,54 @@
+// Nedosiahnutelny kod a podmienky vyhodnotene pocas prekladu
+
+let debug = 0
+let level = 2
+let name = "cfg"
+let ratio = 1.5
+var counter = 0
+
+func check(_ x: Int) -> Int {
+	if (x > 10) {
+		return 1
+	} else {
+		return 0
+	}
+	write("nikdy\n")
+}
+
+func report(_ x: Int) {
+	return
+	write("nikdy ", x, "\n")
+}
+
+if (debug == 1) {
+	write("debug\n")
+} else {
+	write("release\n")
+}
+if (level >= 2) {
+	if (name == "cfg") {
+		write("level ", level, " ", name, "\n")
+	} else {
+		write("nikdy\n")
+	}
+} else {
+	write("nikdy\n")
+}
+while (debug > 0) {
+	write("nikdy\n")
+}
+let scaled = ratio * 2.0
+write(scaled, "\n")
+let total = level * 10 + debug
+write(total, "\n")
+while (counter < level) {
+	counter = counter + 1
+	let c = check(counter)
+	write(counter, c, "\n")
+}
+let hundred = level * 100
+let big = check(hundred)
+write(big, "\n")
+report(level)
+let joined = name + "!"
+write(joined, "\n")
@@ -0,0 +1,44 @@
+// Funkcie, ktore nie su volane z hlavneho tela programu, sa negeneruju
+
+func unusedA(_ x: Int) -> Int {
+	let y = used(x)
+	return y
+}
+
+func used(_ x: Int) -> Int {
+	let y = x * 3
+	write("used ", y, "\n")
+	return y
+}
+
+// nevolane vzajomne rekurzivne funkcie
+func ping(_ n: Int) {
+	if (n > 0) {
+		let m = n - 1
+		pong(m)
+	} else {}
+}
+
+func pong(_ n: Int) {
+	ping(n)
+	write("pong\n")
+}
+
+// volana len z inej volanej funkcie
+func inner(_ s: String) {
+	write(s, "\n")
+	write(s, "\n")
+	write(s, "\n")
+}
+
+func outer(_ s: String) {
+	inner(s)
+	let t = s + "!"
+	inner(t)
+	let u = substring(of: t, startingAt: 0, endingBefore: 2)
+	write(u, "\n")
+}
+
+let a = used(5)
+write(a, "\n")
+outer("ab")
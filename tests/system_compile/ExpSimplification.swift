@@ -0,0 +1,36 @@
+var x = 7
+var y = 2.5
+let s = "ab"
+var n: Int? = nil
+var m: Int? = 4
+let k = x * 2 + 0 - x + 3 * 1 + (x - 1) + 2 - 5
+write(k, "\n")
+let d = y * 2.0 + 1.0 * y - 0.0 + 3 + 2.0 / 1.0
+write(d, "\n")
+let d2 = 1 + 2.5 * 2
+write(d2, "\n")
+let c = "x" + "y\n" + s + "" + "\u{41}" + s
+write(c, "\n")
+let e = (n ?? 5) + (m ?? 6) + (nil ?? 3)
+write(e, "\n")
+if x == 7 { write("eq\n") } else { write("neq\n") }
+if x != 7 { write("ne\n") } else { write("e\n") }
+if x <= 7 { write("le\n") } else {}
+if x >= 8 { write("ge\n") } else { write("lt\n") }
+if 3 < 2 { write("no\n") } else { write("yes\n") }
+if "a" == "a" { write("streq\n") } else {}
+if y * 2.0 > 4.9 { write("gt\n") } else {}
+while x > 0 { x = x - 3 }
+write(x, "\n")
+let big = 9223372036854775807 + 0
+write(big, "\n")
+let dz = 10 / 3 * 3
+write(dz, "\n")
+let q = x - x
+write(q, "\n")
+let mixed = 1 + (2 + 3.0)
+write(mixed, "\n")
+let r = (x + 1) + 2 - 4
+write(r, "\n")
+let b2 = (x < 5) == (y > 1.0)
+if b2 { write("b\n") } else {}
@@ -0,0 +1,24 @@
+// Funkcia volana z funkcie definovanej pred nou
+
+func first(_ n: Int) -> Int {
+	let s: Int = second(n)
+	return s + 1
+}
+
+func second(_ n: Int) -> Int {
+	if (n > 0) {
+		let t: Int = third(n)
+		return t * 10
+	} else {
+		return 0
+	}
+}
+
+func third(_ n: Int) -> Int {
+	return n - 1
+}
+
+let r = first(4)
+write(r, "\n")
+let z = first(0)
+write(z, "\n")
@@ -0,0 +1,37 @@
+// Zdielanie premennych ramca medzi premennymi s neprekryvajucou sa zivotnostou
+
+func stats(_ a: Int, _ b: Int) -> Int {
+	let sum = a + b
+	write("sum ", sum, "\n")
+	let diff = a - b
+	write("diff ", diff, "\n")
+	let prod = a * b
+	write("prod ", prod, "\n")
+	var acc = 0
+	var i = 0
+	while (i < a) {
+		let sq = i * i
+		acc = acc + sq
+		let cube = sq * i
+		acc = acc + cube
+		i = i + 1
+	}
+	let result = acc + sum
+	return result
+}
+
+func fact(_ n: Int) -> Int {
+	if (n < 2) {
+		return 1
+	} else {
+		let m = n - 1
+		let sub = fact(m)
+		let r = n * sub
+		return r
+	}
+}
+
+let s = stats(4, 3)
+write(s, "\n")
+let f = fact(10)
+write(f, "\n")
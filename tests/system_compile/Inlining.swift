@@ -0,0 +1,63 @@
+// Vkladanie tiel malych funkcii do miesta volania
+
+func inc(_ x: Int) -> Int {
+	return x + 1
+}
+
+// viac navratov z funkcie
+func maxOf(_ a: Int, _ b: Int) -> Int {
+	if (a > b) {
+		return a
+	} else {
+		return b
+	}
+}
+
+func twice(_ x: Int) -> Int {
+	let a = inc(x)
+	let b = inc(a)
+	return b - 2 + x
+}
+
+func greet(_ _: Int, name n: String) {
+	write("Ahoj ", n, "\n")
+}
+
+// vzajomna rekurzia sa nevklada
+func isEven(_ n: Int) -> Int {
+	if (n == 0) {
+		return 1
+	} else {
+		let m = n - 1
+		let r = isOdd(m)
+		return r
+	}
+}
+
+func isOdd(_ n: Int) -> Int {
+	if (n == 0) {
+		return 0
+	} else {
+		let m = n - 1
+		let r = isEven(m)
+		return r
+	}
+}
+
+var i = 0
+var sum = 0
+while (i < 5) {
+	let k = inc(i)
+	sum = sum + k
+	i = k
+}
+write(sum, "\n")
+let m = maxOf(3, 7)
+let n = maxOf(9, m)
+write(m, " ", n, "\n")
+let t = twice(20)
+write(t, "\n")
+greet(1, name: "svet")
+let e = isEven(6)
+let o = isEven(7)
+write(e, " ", o, "\n")
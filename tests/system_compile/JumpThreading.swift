@@ -0,0 +1,42 @@
+// Skoky na skoky a susedne navestia pri vnorenych podmienkach a cykloch
+
+func classify(_ x: Int) -> Int {
+	var r = 0
+	if (x > 0) {
+		if (x > 10) {
+			if (x > 100) {
+				r = 3
+			} else {
+			}
+		} else {
+			r = 1
+		}
+	} else {
+	}
+	return r
+}
+
+var i = 0
+var sum = 0
+while (i < 20) {
+	var j = 0
+	while (j < i) {
+		if (j > 5) {
+			if (j > 10) {
+				sum = sum + 2
+			} else {
+			}
+		} else {
+			sum = sum + 1
+		}
+		j = j + 1
+	}
+	i = i + 1
+}
+write(sum, "\n")
+let m = 0 - 5
+let a = classify(m)
+let b = classify(5)
+let c = classify(50)
+let d = classify(500)
+write(a, b, c, d, "\n")
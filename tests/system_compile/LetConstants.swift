@@ -0,0 +1,43 @@
+let debug = 0
+let level = 2
+let scale : Double = 3
+let name = "cfg"
+let ratio = 1.5
+
+if debug == 1 {
+    write("debug\n")
+} else {
+    write("release\n")
+}
+if level > 1 {
+    write("level ", level, "\n")
+} else {}
+let half = scale / 2.0
+let twice = ratio * 2.0
+write(half, " ", twice, "\n")
+let shout = name + "!"
+write(shout, "\n")
+
+func report(_ n : Int) -> Int {
+    let step = 3
+    if step == 3 {
+        return n + step
+    } else {
+        return 0
+    }
+}
+let reported = report(level)
+write(reported, "\n")
+
+var i = 0
+while i < 3 {
+    let inc = 1
+    i = i + inc
+}
+write(i, "\n")
+let copy = level
+let other : Int? = 7
+if let other {
+    let sum = copy + other
+    write(sum, "\n")
+} else {}
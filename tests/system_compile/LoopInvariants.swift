@@ -0,0 +1,41 @@
+// Presun invariantnych prikazov pred cyklus
+
+func repeatText(_ s: String, times n: Int) -> String {
+	var out = ""
+	var i = 0
+	while (i < n) {
+		let sep = s + "-"
+		let len = length(sep)
+		out = out + sep
+		i = i + len - len + 1
+	}
+	return out
+}
+
+var x: Int? = nil
+var i = 0
+while (i < 0) {
+	let never = x! + 1
+	write(never, "\n")
+}
+var total = 0
+let base = 7
+i = 0
+while (i < 3) {
+	var j = 0
+	while (j < 4) {
+		let step = base * 2 + 1
+		let bonus = i * 10
+		total = total + step + bonus
+		j = j + 1
+	}
+	if (x != nil) {
+		let y = x! + 1
+		write(y, "\n")
+	} else {
+	}
+	i = i + 1
+}
+write(total, "\n")
+let r = repeatText("ab", times: 3)
+write(r, "\n")
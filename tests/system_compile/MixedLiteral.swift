@@ -0,0 +1,7 @@
+let mixed = 1 + (2 + 3.0)
+write(mixed, "\n")
+var d = 2.5
+let nested = (1 + 2) * (4 + d)
+write(nested, "\n")
+let chain = 1 + (2 * (3 + 0.5))
+write(chain, "\n")
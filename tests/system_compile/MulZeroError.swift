@@ -0,0 +1,6 @@
+var a = 7
+var b = 0
+let zero = a * 0
+write(zero, "\n")
+let z = 0 * (a / b)
+write(z, "\n")
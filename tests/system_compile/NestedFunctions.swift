@@ -0,0 +1,32 @@
+// Vnorene definicie funkcii, ich kod sa vypisuje v poradi definicii aj pri --stream
+
+func outer(_ n: Int) -> Int {
+	func inner(_ k: Int) -> Int {
+		func innermost(_ m: Int) -> Int {
+			return m + 1
+		}
+		let r = innermost(k)
+		return r * 2
+	}
+	let r = inner(n)
+	return r + 1
+}
+
+func other(_ s: String) {
+	write(s, "\n")
+}
+
+let a = outer(20)
+write(a, "\n")
+other("after outer")
+
+// funkcia definovana v cykle sa vypise az po skonceni cyklu
+var i = 0
+while (i < 3) {
+	func inLoop(_ x: Int) -> Int {
+		return x + 100
+	}
+	let y = inLoop(i)
+	write(y, "\n")
+	i = i + 1
+}
@@ -0,0 +1,35 @@
+// Volania substring s konstantnymi argumentmi
+
+func show(_ s: String?) {
+	if let s {
+		write("[", s, "]\n")
+	} else {
+		write("nil\n")
+	}
+}
+
+let a = substring(of: "hello world", startingAt: 6, endingBefore: 11)
+show(a)
+let b = substring(of: "a\tb\\c", startingAt: 1, endingBefore: 4)
+show(b)
+let c = substring(of: "abc", startingAt: 2, endingBefore: 2)
+show(c)
+let d = substring(of: "abc", startingAt: 3, endingBefore: 3)
+show(d)
+let e = substring(of: "abc", startingAt: 1, endingBefore: 4)
+show(e)
+var t = readString()
+var u = t!
+let f = substring(of: u, startingAt: 0, endingBefore: 3)
+show(f)
+let g = substring(of: u, startingAt: 4, endingBefore: 4)
+show(g)
+let h = substring(of: u, startingAt: 5, endingBefore: 5)
+show(h)
+let k = substring(of: u, startingAt: 2, endingBefore: 7)
+show(k)
+let m = substring(of: u, startingAt: 0, endingBefore: 40)
+show(m)
+var i = 1
+let n = substring(of: u, startingAt: i, endingBefore: 3)
+show(n)
@@ -0,0 +1,91 @@
+// Dlhe podretazce skladane zdvojovanim
+
+func show(_ s: String?) {
+	if let s {
+		let n = length(s)
+		write(n, " [", s, "]\n")
+	} else {
+		write("nil\n")
+	}
+}
+
+var t = readString()
+var u = t!
+var i = 0
+var j = 0
+i = 0
+j = 0
+let s0_0 = substring(of: u, startingAt: i, endingBefore: j)
+show(s0_0)
+i = 5
+j = 6
+let s5_6 = substring(of: u, startingAt: i, endingBefore: j)
+show(s5_6)
+i = 0
+j = 63
+let s0_63 = substring(of: u, startingAt: i, endingBefore: j)
+show(s0_63)
+i = 0
+j = 64
+let s0_64 = substring(of: u, startingAt: i, endingBefore: j)
+show(s0_64)
+i = 0
+j = 65
+let s0_65 = substring(of: u, startingAt: i, endingBefore: j)
+show(s0_65)
+i = 1
+j = 66
+let s1_66 = substring(of: u, startingAt: i, endingBefore: j)
+show(s1_66)
+i = 3
+j = 103
+let s3_103 = substring(of: u, startingAt: i, endingBefore: j)
+show(s3_103)
+i = 10
+j = 137
+let s10_137 = substring(of: u, startingAt: i, endingBefore: j)
+show(s10_137)
+i = 0
+j = 128
+let s0_128 = substring(of: u, startingAt: i, endingBefore: j)
+show(s0_128)
+i = 0
+j = 129
+let s0_129 = substring(of: u, startingAt: i, endingBefore: j)
+show(s0_129)
+i = 45
+j = 300
+let s45_300 = substring(of: u, startingAt: i, endingBefore: j)
+show(s45_300)
+i = 44
+j = 300
+let s44_300 = substring(of: u, startingAt: i, endingBefore: j)
+show(s44_300)
+i = 0
+j = 256
+let s0_256 = substring(of: u, startingAt: i, endingBefore: j)
+show(s0_256)
+i = 0
+j = 300
+let s0_300 = substring(of: u, startingAt: i, endingBefore: j)
+show(s0_300)
+i = 299
+j = 300
+let s299_300 = substring(of: u, startingAt: i, endingBefore: j)
+show(s299_300)
+i = 200
+j = 100
+let s200_100 = substring(of: u, startingAt: i, endingBefore: j)
+show(s200_100)
+i = 0
+j = 301
+let s0_301 = substring(of: u, startingAt: i, endingBefore: j)
+show(s0_301)
+var w = u
+var m = length(w)
+while m > 1 {
+	let x = substring(of: w, startingAt: 1, endingBefore: m)
+	w = x!
+	m = length(w)
+}
+write(w, "\n")
@@ -0,0 +1,59 @@
+// Rekurzivne volanie na konci funkcie sa nahradi skokom na jej zaciatok
+
+// scitanie cisel 1..n s akumulatorom
+func sumTo(_ n: Int, acc a: Int) -> Int {
+	if (n == 0) {
+		return a
+	} else {
+		let m = n - 1
+		let s = a + n
+		let r = sumTo(m, acc: s)
+		return r
+	}
+}
+
+// vysledok sa vracia cez spolocny return za podmienkou
+func gcd(_ a: Int, _ b: Int) -> Int {
+	var r : Int?
+	if (b == 0) {
+		r = a
+	} else {
+		if (a > b) {
+			let d = a - b
+			r = gcd(d, b)
+		} else {
+			let d = b - a
+			r = gcd(a, d)
+		}
+	}
+	return r!
+}
+
+// void funkcia, volanie je poslednym prikazom
+func countDown(_ n: Int, _ _: String) {
+	if (n > 0) {
+		let m = n - 1
+		countDown(m, "x")
+	} else {
+		write("start\n")
+	}
+}
+
+// volanie, ktore nie je na konci funkcie, zostava zachovane
+func fact(_ n: Int) -> Int {
+	if (n < 2) {
+		return 1
+	} else {
+		let m = n - 1
+		let f = fact(m)
+		return n * f
+	}
+}
+
+let s = sumTo(30000, acc: 0)
+write(s, "\n")
+let g = gcd(60000, 48)
+write(g, "\n")
+countDown(30000, "y")
+let f = fact(10)
+write(f, "\n")
@@ -0,0 +1,18 @@
+// Zlucovanie vypisov konstant
+
+let answer = 42
+let neg = 0 - 7
+let word = "slovo"
+var x = 5
+write("Result: ", answer, "\n")
+write("neg=", neg, " nil=", nil, "|\n")
+write("a\tb \"q\" \u{41}", "\\", "\n")
+write("x=", x, ", ", word, "\n")
+write("one ")
+write("two ")
+write(3, "\n")
+var i = 0
+while (i < 2) {
+	write("i", "=", i, "\n")
+	i = i + 1
+}
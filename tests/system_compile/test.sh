@@ -46,6 +46,11 @@ do
     mv "$f" "../system_run"
 done
 
+if ! command -v valgrind >/dev/null 2>&1 ; then
+    echo -e "\n[VALGRIND SKIP] valgrind not found, memory check not run"
+    exit 0
+fi
+
 echo -e "\nValgrind leak-check running, this may take a while (checks only programs that compile successfully)"
 valgrind_ok=true
 for f in *.swift
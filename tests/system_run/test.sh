@@ -11,8 +11,12 @@ do
     echo -n "${f}: "
     timeout 2 ./ic23int "${f}" <"${test_sample}.stdin" >"${test_sample}.result"
     result=$?
+    expected=0
+    if [ -f "${test_sample}.code" ]; then # očakávaná chyba interpretu
+        expected=$(cat "${test_sample}.code")
+    fi
 
-    if [ ${result} -eq 0 ]; then 
+    if [ ${result} -eq ${expected} ]; then 
         diff "${test_sample}.stdout" "${test_sample}.result"
         result=$?
         if [ ${result} -eq 0 ]; then
@@ -0,0 +1,79 @@
+#!/bin/bash
+
+# --time-report a --alloc-stats nesmú zmeniť vygenerovaný kód ani návratový kód, výpis JSON musí
+# byť platný a počítadlá musia zodpovedať prekladu
+
+make || exit 1
+
+echo "Executing time report tests"
+
+report_ok=true
+
+for f in ../system_compile/*.swift ../semantic_dbg/*.sample
+do
+    ./main.out <"$f" >"expected.result" 2>/dev/null
+    expected=$?
+    ./main.out --time-report=json <"$f" >"actual.result" 2>"report.result"
+    actual=$?
+    if [ ${expected} -ne ${actual} ] || ! cmp -s "expected.result" "actual.result"; then
+        report_ok=false
+        echo -e "Compiled code differs for $f\t\terr #${expected} vs #${actual}"
+    fi
+    # posledný riadok hlásení je report, počet riadkov výstupu sedí s vygenerovaným kódom
+    if ! tail -n 1 "report.result" | python3 -c '
+import json, sys
+r = json.loads(sys.stdin.read())
+lines = int(sys.argv[1])
+c = r["counters"]
+assert set(r["phases"]) >= {"scanner", "parser", "expressions", "symtable", "codegen", "defvars", "output"}
+assert c["tokens"] > 0 and r["total"]["wall_ms"] > 0
+assert c["output_lines"] == lines or lines == 0
+assert c["allocations"] > 0 and c["peak_bytes"] > 0 and c["allocated_bytes"] >= c["peak_bytes"]
+' "$(wc -l <"actual.result")" 2>/dev/null; then
+        report_ok=false
+        echo "Invalid JSON report for $f"
+    fi
+done
+
+# textový výpis s tabuľkou fáz, kód sa nemení
+f="../system_compile/$(ls ../system_compile | grep '\.swift$' | head -n 1)"
+./main.out <"$f" >"expected.result"
+./main.out --time-report <"$f" >"actual.result" 2>"report.result"
+if ! cmp -s "expected.result" "actual.result" || ! grep -q "^time report:" "report.result" || \
+    ! grep -q "^  parser " "report.result" || ! grep -q "^  tokens [1-9]" "report.result"; then
+    report_ok=false
+    echo "Invalid text report for $f"
+fi
+
+# preklad v aréne a preklad cez malloc dávajú rovnaký výsledok
+for f in ../system_compile/*.swift ../semantic_dbg/*.sample
+do
+    ./main.out <"$f" >"expected.result" 2>"expected_err.result"
+    expected=$?
+    ./main.out --no-arena <"$f" >"actual.result" 2>"actual_err.result"
+    actual=$?
+    if [ ${expected} -ne ${actual} ] || ! cmp -s "expected.result" "actual.result" || ! cmp -s "expected_err.result" "actual_err.result"; then
+        report_ok=false
+        echo -e "Result without arena differs for $f\t\terr #${expected} vs #${actual}"
+    fi
+done
+
+# po úspešnom preklade je všetka alokovaná pamäť uvoľnená
+for f in ../system_compile/*.swift
+do
+    ./main.out <"$f" >"expected.result"
+    ./main.out --alloc-stats <"$f" >"actual.result" 2>"report.result"
+    live=$(grep "^  total " "report.result" | awk '{ print $NF }')
+    if ! cmp -s "expected.result" "actual.result" || [ "${live}" != "0" ]; then
+        report_ok=false
+        echo "Invalid allocation statistics for $f (live ${live})"
+    fi
+done
+
+rm -f expected.result actual.result report.result expected_err.result actual_err.result
+
+if ${report_ok} ; then
+    echo "[PASS]"
+else
+    echo "[FAIL]"
+fi
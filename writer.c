@@ -0,0 +1,86 @@
+/** Projekt IFJ2023
+ * @file writer.c
+ * @brief Bufferovaný výpis vygenerovaného cieľového kódu
+ * @author agent (agent@local)
+ * @date 19.10.2026
+ */
+
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include "writer.h"
+
+bool writerWriteAll(int fd, const char *data, size_t size) {
+    while (size > 0) {
+        ssize_t written = write(fd, data, size);
+        if (written < 0 && errno == EINTR) continue;
+        if (written <= 0) return false;
+        data += written;
+        size -= (size_t)written;
+    }
+    return true;
+}
+
+long writerFileSize(FILE *f) {
+    fflush(f);
+    if (fseek(f, 0, SEEK_END) != 0) return -1;
+    long size = ftell(f);
+    rewind(f);
+    return size;
+}
+
+/**
+ * @brief Zapíše blok dát na výstup, po prvej chybe sa už nezapisuje
+*/
+static void writerWriteBlock(writer_T *w, const char *data, size_t size) {
+    if (!w->failed && !writerWriteAll(w->fd, data, size)) w->failed = true;
+}
+
+void writerInit(writer_T *w, int fd) {
+    if (fd == STDOUT_FILENO) fflush(stdout);
+    w->fd = fd;
+    w->used = 0;
+    w->failed = false;
+    w->lines = 0;
+}
+
+/**
+ * @brief Vypíše blok dát danej dĺžky
+*/
+static void writerPut(writer_T *w, const char *data, size_t size) {
+    if (w->used + size > WRITER_BUFFER_SIZE) {
+        writerWriteBlock(w, w->buffer, w->used);
+        w->used = 0;
+        if (size > WRITER_BUFFER_SIZE) { // nezmestí sa ani do prázdneho buffera
+            writerWriteBlock(w, data, size);
+            return;
+        }
+    }
+    memcpy(w->buffer + w->used, data, size);
+    w->used += size;
+}
+
+void writerPuts(writer_T *w, const char *s) {
+    writerPut(w, s, strlen(s));
+}
+
+void writerLine(writer_T *w, const char *s) {
+    writerPut(w, s, strlen(s));
+    writerPut(w, "\n", 1);
+    w->lines++;
+}
+
+void writerList(writer_T *w, DLLstr_T *list) {
+    for (DLLstr_el_ptr el = list->first; el != NULL; el = el->next) {
+        writerLine(w, el->string);
+    }
+}
+
+bool writerFlush(writer_T *w) {
+    writerWriteBlock(w, w->buffer, w->used);
+    w->used = 0;
+    return !w->failed;
+}
+
+/* Koniec súboru writer.c */
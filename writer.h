@@ -0,0 +1,79 @@
+/** Projekt IFJ2023
+ * @file writer.h
+ * @brief Bufferovaný výpis vygenerovaného cieľového kódu
+ * @author agent (agent@local)
+ * @date 19.10.2026
+ */
+
+#ifndef _WRITER_H_
+#define _WRITER_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+#include "dll.h"
+
+/** Veľkosť buffera výpisu v bajtoch */
+#define WRITER_BUFFER_SIZE (64 * 1024)
+
+/**
+ * Reťazce sa kopírujú do buffera, ktorý sa zapisuje jedným volaním write až po jeho naplnení,
+ * reťazce dlhšie ako buffer sa zapíšu priamo. Výpis nepoužíva formátovací reťazec ani FILE.
+ *
+ * @brief Výstup zapisujúci do súborového deskriptora po veľkých blokoch
+*/
+typedef struct writer {
+    int fd;                             ///< súborový deskriptor výstupu
+    size_t used;                        ///< počet obsadených bajtov buffera
+    bool failed;                        ///< niektorý zápis zlyhal
+    long lines;                         ///< počet vypísaných riadkov
+    char buffer[WRITER_BUFFER_SIZE];    ///< dáta čakajúce na zápis
+} writer_T;
+
+/**
+ * Pri výpise na stdout vyprázdni jeho buffer, aby sa predchádzajúci výpis cez printf nepremiešal
+ * s výpisom writera. Ostatné deskriptory (súbory dávky, dočasné súbory servera a cache) stdout nemenia.
+ * @brief Inicializuje výstup
+ * @param fd súborový deskriptor výstupu
+*/
+void writerInit(writer_T *w, int fd);
+
+/**
+ * @brief Vypíše reťazec
+*/
+void writerPuts(writer_T *w, const char *s);
+
+/**
+ * @brief Vypíše reťazec a znak nového riadku
+*/
+void writerLine(writer_T *w, const char *s);
+
+/**
+ * @brief Vypíše všetky reťazce zoznamu, každý na samostatný riadok
+*/
+void writerList(writer_T *w, DLLstr_T *list);
+
+/**
+ * @brief Zapíše obsah buffera na výstup
+ * @return true ak boli všetky zápisy úspešné, inak false
+*/
+bool writerFlush(writer_T *w);
+
+/**
+ * Čiastočné a prerušené (EINTR) zápisy sa opakujú. Používa sa aj pre výstup mimo writer_T
+ * (súbory cache, odpoveď servera, požiadavka klienta).
+ * @brief Zapíše celý blok dát do súborového deskriptora
+ * @return true v prípade úspechu, inak false
+*/
+bool writerWriteAll(int fd, const char *data, size_t size);
+
+/**
+ * Do dočasného súboru sa zapisuje priamo cez jeho deskriptor, fseek preto najprv zosynchronizuje
+ * pozíciu súboru.
+ * @brief Vráti veľkosť dočasného súboru a presunie sa na jeho začiatok
+ * @return veľkosť v bajtoch, -1 pri chybe
+*/
+long writerFileSize(FILE *f);
+
+#endif // ifndef _WRITER_H_
+/* Koniec súboru writer.h */